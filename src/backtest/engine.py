@@ -1,6 +1,7 @@
 """Backtesting engine for strategy validation."""
 
 import logging
+import os
 import uuid
 from datetime import datetime, timedelta
 from typing import Dict, List, Optional, Tuple
@@ -19,19 +20,34 @@ from src.shared.models import (
     Event, EventType, RegimeType, TechnicalSignalType
 )
 
+try:
+    # Importing the indicator wrapper puts the compiled module on sys.path
+    import src.indicators.engine  # noqa: F401
+    from indicators_engine import (
+        Backtester as CppBacktester,
+        BarCache as CppBarCache,
+        StrategyParams as CppStrategyParams,
+    )
+    CPP_BACKTEST_AVAILABLE = True
+except ImportError:
+    CPP_BACKTEST_AVAILABLE = False
+
 logger = logging.getLogger(__name__)
 
 
 class BacktestingModule:
     """Backtesting module for historical strategy validation."""
     
-    def __init__(self, db_connection: DatabaseConnection):
+    def __init__(self, db_connection: DatabaseConnection, bar_cache_dir: Optional[str] = None):
         """Initialize backtesting module.
         
         Args:
             db_connection: Database connection instance
+            bar_cache_dir: Directory for memory-mapped per-symbol bar caches
+                used by load_price_columns (disabled when None)
         """
         self.db_connection = db_connection
+        self.bar_cache_dir = bar_cache_dir
         logger.info("Backtesting module initialized")
     
     def run_backtest(self, config: BacktestConfig) -> BacktestResult:
@@ -86,6 +102,142 @@ class BacktestingModule:
         
         return result
     
+    def run_parameter_sweep(
+        self,
+        config: BacktestConfig,
+        grid: List[Dict[str, float]],
+        num_threads: Optional[int] = None
+    ) -> List[Dict]:
+        """Backtest a grid of technical-strategy parameters in parallel.
+        
+        Runs on the C++ backtest core over the closes of config.symbol. Each
+        grid entry overrides fields of the C++ StrategyParams (rsi_period,
+        rsi_overbought, rsi_oversold, macd_fast, macd_slow, macd_signal,
+        bollinger_period, bollinger_std_dev, buy_threshold, sell_threshold);
+        capital, position size and thresholds default to the config. The
+        strategy trades on the technical score (RSI, MACD and Bollinger votes
+        scaled to [-100, 100]) rather than the sentiment CMS of run_backtest,
+        but metrics follow compute_metrics.
+        
+        Args:
+            config: Backtest configuration (symbol, date range, capital)
+            grid: Parameter overrides, one dict per configuration
+            num_threads: Worker threads for the sweep (default: all cores)
+            
+        Returns:
+            One dict per grid entry, in order, with the parameters and metrics
+        """
+        if not CPP_BACKTEST_AVAILABLE:
+            raise RuntimeError("Parameter sweeps need the C++ indicators_engine module")
+        
+        closes = self.load_price_columns(
+            config.symbol,
+            config.start_date,
+            config.end_date
+        )['close']
+        
+        params_list = []
+        for overrides in grid:
+            params = CppStrategyParams()
+            params.initial_capital = config.initial_capital
+            params.position_size = config.position_size
+            params.buy_threshold = config.cms_buy_threshold
+            params.sell_threshold = config.cms_sell_threshold
+            for name, value in overrides.items():
+                if not hasattr(params, name):
+                    raise ValueError(f"Unknown strategy parameter: {name}")
+                setattr(params, name, value)
+            params_list.append(params)
+        
+        if len(closes) == 0:
+            logger.warning("No historical data found for parameter sweep")
+            return [self._sweep_entry(overrides, None) for overrides in grid]
+        
+        backtester = CppBacktester(num_threads) if num_threads else CppBacktester()
+        logger.info(f"Sweeping {len(grid)} configurations over {len(closes)} bars")
+        metrics = backtester.sweep(closes, params_list)
+        
+        return [
+            self._sweep_entry(overrides, result)
+            for overrides, result in zip(grid, metrics)
+        ]
+    
+    @staticmethod
+    def _sweep_entry(overrides: Dict[str, float], metrics) -> Dict:
+        """Flatten one sweep result; metrics is None when there was no data."""
+        return {
+            'params': dict(overrides),
+            'pnl': metrics.pnl if metrics else 0.0,
+            'total_return': metrics.total_return if metrics else 0.0,
+            'sharpe_ratio': metrics.sharpe_ratio if metrics else 0.0,
+            'max_drawdown': metrics.max_drawdown if metrics else 0.0,
+            'win_rate': metrics.win_rate if metrics else 0.0,
+            'total_trades': metrics.total_trades if metrics else 0,
+        }
+    
+    def load_price_columns(
+        self,
+        symbol: str,
+        start_date: datetime,
+        end_date: datetime
+    ) -> Dict[str, np.ndarray]:
+        """Load price bars as contiguous columns, through the bar cache.
+        
+        With a bar_cache_dir, a per-symbol cache file that covers the range is
+        memory-mapped and sliced without touching PostgreSQL; otherwise the
+        prices are queried and the cache file is rewritten for this range.
+        
+        Args:
+            symbol: Stock symbol
+            start_date: Start of the range (inclusive)
+            end_date: End of the range (inclusive)
+            
+        Returns:
+            Dict of open/high/low/close (float64) and volume/timestamp (int64,
+            Unix seconds) arrays in chronological order
+        """
+        start = int(start_date.timestamp())
+        end = int(end_date.timestamp()) + 1
+        cache_path = None
+        if self.bar_cache_dir and CPP_BACKTEST_AVAILABLE:
+            cache_path = os.path.join(self.bar_cache_dir, f"{symbol}.bars")
+            if os.path.exists(cache_path):
+                try:
+                    cache = CppBarCache.open(cache_path)
+                    if cache.symbol == symbol and cache.covers(start, end):
+                        logger.info(f"Loaded {symbol} bars from cache {cache_path}")
+                        return cache.range(start, end)
+                except RuntimeError as e:
+                    logger.warning(f"Ignoring unreadable bar cache {cache_path}: {e}")
+        
+        with self.db_connection.get_session() as session:
+            prices = PriceRepository(session).get_by_symbol_and_timerange(
+                symbol, start_date, end_date
+            )
+            count = len(prices)
+            columns = {
+                'open': np.fromiter((float(p.open) for p in prices), dtype=np.float64, count=count),
+                'high': np.fromiter((float(p.high) for p in prices), dtype=np.float64, count=count),
+                'low': np.fromiter((float(p.low) for p in prices), dtype=np.float64, count=count),
+                'close': np.fromiter((float(p.close) for p in prices), dtype=np.float64, count=count),
+                'volume': np.fromiter((int(p.volume) for p in prices), dtype=np.int64, count=count),
+                'timestamp': np.fromiter(
+                    (int(p.timestamp.timestamp()) for p in prices), dtype=np.int64, count=count
+                ),
+            }
+        
+        if cache_path is not None:
+            os.makedirs(self.bar_cache_dir, exist_ok=True)
+            CppBarCache.write(
+                cache_path, symbol,
+                high=columns['high'], low=columns['low'], close=columns['close'],
+                timestamp=columns['timestamp'], open=columns['open'],
+                volume=columns['volume'], covered_start=start, covered_end=end
+            )
+            logger.info(f"Wrote {count} {symbol} bars to cache {cache_path}")
+        
+        return columns
+    
     def load_historical_data(
         self,
         symbol: str,
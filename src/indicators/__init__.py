@@ -1,5 +1,5 @@
 """Technical indicators module."""
 
-from src.indicators.engine import TechnicalIndicatorEngine
+from src.indicators.engine import TechnicalIndicatorEngine, IncrementalIndicatorState, MultiTimeframeIndicatorState, IndicatorSpec, IndicatorComputation, CompositeScorer
 
-__all__ = ['TechnicalIndicatorEngine']
+__all__ = ['TechnicalIndicatorEngine', 'IncrementalIndicatorState', 'MultiTimeframeIndicatorState', 'IndicatorSpec', 'IndicatorComputation', 'CompositeScorer']
@@ -0,0 +1,295 @@
+#include "backtest.h"
+#include "composite_scorer.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace indicators {
+
+namespace {
+
+// Full-series inputs of one configuration
+struct SignalInputs {
+    PriceView rsi;
+    PriceView histogram;
+    PriceView upper;
+    PriceView lower;
+};
+
+double strategy_score(const SignalInputs& inputs, PriceView close, size_t i,
+                      const StrategyParams& params) {
+    TechnicalSignals signals;
+    double rsi = inputs.rsi[i];
+    if (rsi > params.rsi_overbought) {
+        signals.rsi_signal = SignalType::OVERBOUGHT;
+    } else if (rsi < params.rsi_oversold) {
+        signals.rsi_signal = SignalType::OVERSOLD;
+    }
+    
+    double histogram = inputs.histogram[i];
+    if (histogram > 0.0) {
+        signals.macd_signal = SignalType::BULLISH_CROSS;
+    } else if (histogram < 0.0) {
+        signals.macd_signal = SignalType::BEARISH_CROSS;
+    }
+    
+    if (close[i] > inputs.upper[i]) {
+        signals.bb_signal = SignalType::UPPER_BREACH;
+    } else if (close[i] < inputs.lower[i]) {
+        signals.bb_signal = SignalType::LOWER_BREACH;
+    }
+    
+    return CompositeScorer::technical_score(signals) * 100.0;
+}
+
+BacktestMetrics simulate(PriceView close,
+                         const SignalInputs& inputs,
+                         const StrategyParams& params,
+                         std::vector<double>& equity) {
+    BacktestMetrics metrics;
+    metrics.final_equity = params.initial_capital;
+    equity.clear();
+    equity.reserve(close.size() + 1);
+    equity.push_back(params.initial_capital);
+    
+    double capital = params.initial_capital;
+    double quantity = 0.0;
+    double entry_price = 0.0;
+    bool in_position = false;
+    size_t wins = 0;
+    
+    auto close_position = [&](double price) {
+        double exit_value = quantity * price;
+        capital += exit_value;
+        double pnl = exit_value - quantity * entry_price;
+        metrics.pnl += pnl;
+        ++metrics.total_trades;
+        if (pnl > 0.0) {
+            ++wins;
+        }
+        in_position = false;
+    };
+    
+    for (size_t i = 0; i < close.size(); ++i) {
+        double price = close[i];
+        equity.push_back(in_position ? capital + quantity * price : capital);
+        
+        // No signal until every indicator has warmed up
+        if (std::isnan(inputs.rsi[i]) || std::isnan(inputs.histogram[i]) ||
+            std::isnan(inputs.upper[i])) {
+            continue;
+        }
+        
+        double score = strategy_score(inputs, close, i, params);
+        if (score > params.buy_threshold && !in_position) {
+            quantity = (capital * params.position_size) / price;
+            entry_price = price;
+            capital -= quantity * price;
+            in_position = true;
+        } else if (score < params.sell_threshold && in_position) {
+            close_position(price);
+        }
+    }
+    
+    if (in_position) {
+        close_position(close.back());
+    }
+    
+    if (metrics.total_trades == 0) {
+        return metrics;
+    }
+    
+    PriceView curve(equity);
+    metrics.final_equity = capital;
+    metrics.total_return = (curve.back() - params.initial_capital) / params.initial_capital;
+    metrics.sharpe_ratio = Backtester::sharpe_ratio(curve);
+    metrics.max_drawdown = Backtester::max_drawdown(curve);
+    metrics.win_rate = static_cast<double>(wins) / metrics.total_trades;
+    return metrics;
+}
+
+void check_close(PriceView close) {
+    if (close.empty()) {
+        throw std::invalid_argument("Backtest needs at least one bar");
+    }
+}
+
+} // namespace
+
+void StrategyParams::validate() const {
+    if (rsi_period <= 0 || macd_fast <= 0 || macd_slow <= 0 || macd_signal <= 0 ||
+        bollinger_period <= 0) {
+        throw std::invalid_argument("Indicator period must be positive");
+    }
+    if (bollinger_std_dev <= 0.0) {
+        throw std::invalid_argument("Bollinger std_dev must be positive");
+    }
+    if (rsi_oversold > rsi_overbought) {
+        throw std::invalid_argument("RSI oversold level must not exceed the overbought level");
+    }
+    if (sell_threshold > buy_threshold) {
+        throw std::invalid_argument("Sell threshold must not exceed the buy threshold");
+    }
+    if (!(initial_capital > 0.0)) {
+        throw std::invalid_argument("Initial capital must be positive");
+    }
+    if (!(position_size > 0.0 && position_size <= 1.0)) {
+        throw std::invalid_argument("Position size must be in (0, 1]");
+    }
+}
+
+Backtester::Backtester(size_t num_threads)
+    : pool_(std::make_shared<ThreadPool>(num_threads)) {}
+
+ThreadPool& Backtester::pool() {
+    return pool_ ? *pool_ : *ThreadPool::shared();
+}
+
+BacktestMetrics Backtester::run(PriceView close,
+                                const StrategyParams& params,
+                                std::vector<double>* equity_curve) {
+    check_close(close);
+    params.validate();
+    
+    const size_t n = close.size();
+    TechnicalIndicatorEngine engine;
+    std::vector<double> rsi(n), macd(n), signal(n), histogram(n), upper(n), middle(n), lower(n);
+    engine.compute_rsi_series(close, rsi, params.rsi_period);
+    engine.compute_macd_series(close, macd, signal, histogram,
+                               params.macd_fast, params.macd_slow, params.macd_signal);
+    engine.compute_bollinger_series(close, upper, middle, lower,
+                                    params.bollinger_period, params.bollinger_std_dev);
+    
+    std::vector<double> equity;
+    return simulate(close, SignalInputs{rsi, histogram, upper, lower}, params,
+                    equity_curve ? *equity_curve : equity);
+}
+
+std::vector<BacktestMetrics> Backtester::sweep(PriceView close,
+                                               const std::vector<StrategyParams>& grid) {
+    check_close(close);
+    for (size_t i = 0; i < grid.size(); ++i) {
+        try {
+            grid[i].validate();
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument("Invalid sweep configuration " + std::to_string(i) +
+                                        ": " + e.what());
+        }
+    }
+    
+    // Distinct indicator settings across the grid
+    std::map<int, size_t> rsi_index;
+    std::map<std::tuple<int, int, int>, size_t> macd_index;
+    std::map<std::pair<int, double>, size_t> bollinger_index;
+    for (const StrategyParams& params : grid) {
+        rsi_index.emplace(params.rsi_period, rsi_index.size());
+        macd_index.emplace(std::make_tuple(params.macd_fast, params.macd_slow, params.macd_signal),
+                           macd_index.size());
+        bollinger_index.emplace(std::make_pair(params.bollinger_period, params.bollinger_std_dev),
+                                bollinger_index.size());
+    }
+    
+    const size_t n = close.size();
+    std::vector<std::vector<double>> rsi(rsi_index.size(), std::vector<double>(n));
+    std::vector<std::vector<double>> histogram(macd_index.size(), std::vector<double>(n));
+    std::vector<std::vector<double>> upper(bollinger_index.size(), std::vector<double>(n));
+    std::vector<std::vector<double>> lower(bollinger_index.size(), std::vector<double>(n));
+    
+    // One task per distinct series; the kernels only read close and write
+    // their own buffers
+    std::vector<std::function<void(TechnicalIndicatorEngine&)>> tasks;
+    for (const auto& entry : rsi_index) {
+        tasks.push_back([&, entry](TechnicalIndicatorEngine& engine) {
+            engine.compute_rsi_series(close, rsi[entry.second], entry.first);
+        });
+    }
+    for (const auto& entry : macd_index) {
+        tasks.push_back([&, entry](TechnicalIndicatorEngine& engine) {
+            std::vector<double> macd(n), signal(n);
+            engine.compute_macd_series(close, macd, signal, histogram[entry.second],
+                                       std::get<0>(entry.first), std::get<1>(entry.first),
+                                       std::get<2>(entry.first));
+        });
+    }
+    for (const auto& entry : bollinger_index) {
+        tasks.push_back([&, entry](TechnicalIndicatorEngine& engine) {
+            std::vector<double> middle(n);
+            engine.compute_bollinger_series(close, upper[entry.second], middle,
+                                            lower[entry.second], entry.first.first,
+                                            entry.first.second);
+        });
+    }
+    
+    ThreadPool& workers = pool();
+    workers.parallel_for(tasks.size(), [&](size_t i) {
+        TechnicalIndicatorEngine engine;
+        tasks[i](engine);
+    });
+    
+    std::vector<BacktestMetrics> results(grid.size());
+    workers.parallel_for(grid.size(), [&](size_t i) {
+        const StrategyParams& params = grid[i];
+        size_t b = bollinger_index.at(std::make_pair(params.bollinger_period,
+                                                     params.bollinger_std_dev));
+        SignalInputs inputs{
+            rsi[rsi_index.at(params.rsi_period)],
+            histogram[macd_index.at(std::make_tuple(params.macd_fast, params.macd_slow,
+                                                    params.macd_signal))],
+            upper[b],
+            lower[b]
+        };
+        std::vector<double> equity;
+        results[i] = simulate(close, inputs, params, equity);
+    });
+    
+    return results;
+}
+
+double Backtester::sharpe_ratio(PriceView equity) {
+    if (equity.size() < 2) {
+        return 0.0;
+    }
+    
+    const size_t count = equity.size() - 1;
+    double mean = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        mean += (equity[i + 1] - equity[i]) / equity[i];
+    }
+    mean /= count;
+    
+    double sum_squares = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double deviation = (equity[i + 1] - equity[i]) / equity[i] - mean;
+        sum_squares += deviation * deviation;
+    }
+    double std_dev = std::sqrt(sum_squares / count);
+    if (std_dev == 0.0) {
+        return 0.0;
+    }
+    return mean / std_dev * std::sqrt(252.0);
+}
+
+double Backtester::max_drawdown(PriceView equity) {
+    if (equity.size() < 2) {
+        return 0.0;
+    }
+    
+    double peak = equity[0];
+    double max_dd = 0.0;
+    for (double value : equity) {
+        if (value > peak) {
+            peak = value;
+        }
+        double drawdown = peak > 0.0 ? (peak - value) / peak : 0.0;
+        max_dd = std::max(max_dd, drawdown);
+    }
+    return max_dd;
+}
+
+} // namespace indicators
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "indicators.h"
+
+namespace indicators {
+
+class ThreadPool;
+
+// One point of a technical-strategy parameter grid. On every bar the RSI,
+// MACD and Bollinger votes (CompositeScorer::technical_score, with the RSI
+// levels below) are averaged and scaled to [-100, 100]; a score above
+// buy_threshold opens a long position and one below sell_threshold closes it.
+struct StrategyParams {
+    int rsi_period = 14;
+    double rsi_overbought = 70.0;
+    double rsi_oversold = 30.0;
+    int macd_fast = 12;
+    int macd_slow = 26;
+    int macd_signal = 9;
+    int bollinger_period = 20;
+    double bollinger_std_dev = 2.0;
+    double buy_threshold = 60.0;
+    double sell_threshold = -60.0;
+    double initial_capital = 100000.0;
+    double position_size = 1.0;  // fraction of capital committed per entry
+    
+    // Throws std::invalid_argument for an unusable configuration
+    void validate() const;
+};
+
+// Same definitions as BacktestingModule.compute_metrics
+// (src/backtest/engine.py). All zero when no trade was made.
+struct BacktestMetrics {
+    double pnl = 0.0;            // sum of closed-trade PnL
+    double final_equity = 0.0;   // capital after closing any open position
+    double total_return = 0.0;
+    double sharpe_ratio = 0.0;
+    double max_drawdown = 0.0;
+    double win_rate = 0.0;
+    size_t total_trades = 0;
+};
+
+// Replays a close series the way BacktestingModule.simulate_trading does:
+// the equity curve starts at the initial capital, gets one mark-to-market
+// point per bar before that bar's signal is acted on, and a position still
+// open after the last bar is closed at the final close. Signals on bar i
+// only use indicator values up to bar i.
+class Backtester {
+public:
+    Backtester() = default;
+    // Use a dedicated pool of num_threads workers for sweeps instead of the
+    // process-wide shared pool
+    explicit Backtester(size_t num_threads);
+    
+    // Backtest one configuration. If equity_curve is given it receives the
+    // curve the metrics were computed from (close.size() + 1 points).
+    BacktestMetrics run(PriceView close,
+                        const StrategyParams& params,
+                        std::vector<double>* equity_curve = nullptr);
+    
+    // Backtest every configuration of grid on the same closes, results in
+    // grid order. Each distinct RSI, MACD and Bollinger setting is computed
+    // once and shared, then the configurations run in parallel.
+    std::vector<BacktestMetrics> sweep(PriceView close, const std::vector<StrategyParams>& grid);
+    
+    // Annualized (252 periods) Sharpe ratio of the per-step returns, risk-free
+    // rate 0, population standard deviation; 0 for a flat or short curve
+    static double sharpe_ratio(PriceView equity);
+    // Largest peak-to-trough decline as a fraction of the running peak
+    static double max_drawdown(PriceView equity);
+
+private:
+    ThreadPool& pool();
+    
+    std::shared_ptr<ThreadPool> pool_;
+};
+
+} // namespace indicators
@@ -0,0 +1,164 @@
+#include "bar_aggregator.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace indicators {
+
+namespace {
+
+OHLC start_bucket(const OHLC& bar, int64_t bucket_start) {
+    OHLC opened = bar;
+    opened.timestamp = bucket_start;
+    return opened;
+}
+
+// Bucket so far followed by one more base bar
+OHLC merge(const OHLC& bucket, const OHLC& bar) {
+    OHLC merged = bucket;
+    merged.high = std::max(bucket.high, bar.high);
+    merged.low = std::min(bucket.low, bar.low);
+    merged.close = bar.close;
+    merged.volume = bucket.volume + bar.volume;
+    return merged;
+}
+
+} // namespace
+
+BarAggregator::BarAggregator(std::vector<int64_t> timeframes, int64_t offset_seconds)
+    : offset_(offset_seconds), last_base_{}, base_bar_count_(0) {
+    if (timeframes.empty()) {
+        throw std::invalid_argument("BarAggregator needs at least one timeframe");
+    }
+    frames_.reserve(timeframes.size());
+    for (int64_t seconds : timeframes) {
+        if (seconds <= 0) {
+            throw std::invalid_argument("Timeframe length must be positive");
+        }
+        Frame frame{};
+        frame.seconds = seconds;
+        frames_.push_back(frame);
+    }
+    closed_.reserve(frames_.size());
+}
+
+int64_t BarAggregator::bucket_of(int64_t timestamp, int64_t seconds) const {
+    // Floor division, so pre-epoch timestamps bucket the same way
+    int64_t shifted = timestamp - offset_;
+    int64_t bucket = shifted / seconds;
+    if (shifted % seconds < 0) {
+        --bucket;
+    }
+    return bucket * seconds + offset_;
+}
+
+const std::vector<size_t>& BarAggregator::push_bar(const OHLC& bar) {
+    if (base_bar_count_ > 0 && bar.timestamp < last_base_.timestamp) {
+        throw std::invalid_argument("Base bars must arrive in timestamp order");
+    }
+    
+    closed_.clear();
+    for (size_t i = 0; i < frames_.size(); ++i) {
+        Frame& frame = frames_[i];
+        const int64_t start = bucket_of(bar.timestamp, frame.seconds);
+        if (base_bar_count_ > 0 && start == frame.bucket_start) {
+            frame.committed = frame.forming;
+            frame.has_committed = true;
+            frame.forming = merge(frame.committed, bar);
+            frame.state.update_last_bar(frame.forming);
+            continue;
+        }
+        
+        if (base_bar_count_ > 0) {
+            frame.closed = frame.forming;
+            frame.has_closed = true;
+            frame.closed_ready = frame.state.ready();
+            if (frame.closed_ready) {
+                frame.closed_results = frame.state.results();
+            }
+            closed_.push_back(i);
+        }
+        frame.bucket_start = start;
+        frame.has_committed = false;
+        frame.forming = start_bucket(bar, start);
+        frame.state.push_bar(frame.forming);
+    }
+    
+    last_base_ = bar;
+    ++base_bar_count_;
+    return closed_;
+}
+
+void BarAggregator::update_last_bar(const OHLC& bar) {
+    if (base_bar_count_ == 0) {
+        throw std::runtime_error("No bar to update");
+    }
+    if (bar.timestamp != last_base_.timestamp) {
+        throw std::invalid_argument("A revised base bar must keep its timestamp");
+    }
+    
+    for (Frame& frame : frames_) {
+        frame.forming = frame.has_committed ? merge(frame.committed, bar)
+                                            : start_bucket(bar, frame.bucket_start);
+        frame.state.update_last_bar(frame.forming);
+    }
+    last_base_ = bar;
+}
+
+const std::vector<size_t>& BarAggregator::push_tick(int64_t timestamp, double price, int64_t volume) {
+    return push_bar(OHLC{price, price, price, price, volume, timestamp});
+}
+
+const BarAggregator::Frame& BarAggregator::frame(size_t i) const {
+    if (i >= frames_.size()) {
+        throw std::out_of_range("Timeframe index out of range");
+    }
+    return frames_[i];
+}
+
+int64_t BarAggregator::timeframe(size_t i) const {
+    return frame(i).seconds;
+}
+
+size_t BarAggregator::index_of(int64_t timeframe) const {
+    for (size_t i = 0; i < frames_.size(); ++i) {
+        if (frames_[i].seconds == timeframe) {
+            return i;
+        }
+    }
+    throw std::out_of_range("No " + std::to_string(timeframe) + "s timeframe");
+}
+
+const IncrementalIndicatorState& BarAggregator::state(size_t i) const {
+    return frame(i).state;
+}
+
+const OHLC& BarAggregator::current_bar(size_t i) const {
+    const Frame& selected = frame(i);
+    if (base_bar_count_ == 0) {
+        throw std::runtime_error("No bars pushed");
+    }
+    return selected.forming;
+}
+
+bool BarAggregator::has_closed_bar(size_t i) const {
+    return frame(i).has_closed;
+}
+
+const OHLC& BarAggregator::last_closed_bar(size_t i) const {
+    const Frame& selected = frame(i);
+    if (!selected.has_closed) {
+        throw std::runtime_error("No closed bar yet");
+    }
+    return selected.closed;
+}
+
+const IndicatorResults& BarAggregator::closed_results(size_t i) const {
+    const Frame& selected = frame(i);
+    if (!selected.closed_ready) {
+        throw std::runtime_error("Insufficient data: need at least 50 closed bars");
+    }
+    return selected.closed_results;
+}
+
+} // namespace indicators
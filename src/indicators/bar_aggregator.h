@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "indicators.h"
+
+namespace indicators {
+
+// Rolls one feed of base bars or ticks into several timeframes at once and
+// keeps an IncrementalIndicatorState per timeframe, so every timeframe's
+// indicators advance from the same feed without rebuilding history.
+//
+// A timeframe of s seconds buckets bars by floor((timestamp - offset) / s);
+// aggregated bars carry their bucket start as timestamp. The forming bar of
+// each timeframe is always the last bar of its state (revised with
+// update_last_bar as base bars arrive), and it closes when the first base
+// bar of a later bucket arrives. Buckets without base bars produce no bar.
+class BarAggregator {
+public:
+    // timeframes are bucket lengths in seconds; offset_seconds shifts the
+    // bucket boundaries, e.g. to align daily bars to an exchange session
+    explicit BarAggregator(std::vector<int64_t> timeframes, int64_t offset_seconds = 0);
+    
+    // Feed the next base bar (timestamps must not decrease). Returns the
+    // indices of the timeframes whose bar this push closed.
+    const std::vector<size_t>& push_bar(const OHLC& bar);
+    // Revise the most recent base bar, which must keep its timestamp
+    void update_last_bar(const OHLC& bar);
+    // Feed one trade as a single-price base bar
+    const std::vector<size_t>& push_tick(int64_t timestamp, double price, int64_t volume);
+    
+    size_t timeframe_count() const { return frames_.size(); }
+    int64_t timeframe(size_t i) const;
+    // Index of a timeframe given in seconds; throws std::out_of_range
+    size_t index_of(int64_t timeframe) const;
+    size_t base_bar_count() const { return base_bar_count_; }
+    
+    // Indicator state of timeframe i, its last bar being the forming one
+    const IncrementalIndicatorState& state(size_t i) const;
+    const OHLC& current_bar(size_t i) const;
+    
+    // Most recently closed bar of timeframe i and the indicators as of its
+    // close; closed_results throws until the state was ready at a close
+    bool has_closed_bar(size_t i) const;
+    const OHLC& last_closed_bar(size_t i) const;
+    const IndicatorResults& closed_results(size_t i) const;
+
+private:
+    struct Frame {
+        int64_t seconds;
+        int64_t bucket_start;
+        OHLC committed;  // base bars of the bucket before the latest one
+        bool has_committed;
+        OHLC forming;
+        IncrementalIndicatorState state;
+        OHLC closed;
+        IndicatorResults closed_results;
+        bool has_closed;
+        bool closed_ready;
+    };
+    
+    const Frame& frame(size_t i) const;
+    int64_t bucket_of(int64_t timestamp, int64_t seconds) const;
+    
+    std::vector<Frame> frames_;
+    int64_t offset_;
+    OHLC last_base_;
+    size_t base_bar_count_;
+    std::vector<size_t> closed_;
+};
+
+} // namespace indicators
@@ -0,0 +1,292 @@
+#include "bar_cache.h"
+#include "bar_series.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace indicators {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x4843414352414245ULL;  // "EBARCACH" little-endian
+constexpr size_t kColumnAlignment = 64;
+constexpr uint32_t kHasOpen = 1;
+constexpr uint32_t kHasVolume = 2;
+const char* const kKind = "bar cache";
+
+std::runtime_error system_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + ": " + path);
+}
+
+size_t column_bytes(size_t count) {
+    size_t bytes = count * sizeof(double);
+    return (bytes + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+}
+
+} // namespace
+
+// Mapped layout: a 128-byte header, then the timestamp, open, high, low,
+// close and volume columns in that order, each padded to a cache line.
+// Absent optional columns take no space.
+struct BarCache::Header {
+    uint64_t magic;
+    uint32_t format_version;
+    uint32_t flags;
+    uint64_t bar_count;
+    int64_t covered_start;
+    int64_t covered_end;
+    char symbol[kMaxSymbolLength + 1];
+    unsigned char reserved[56];
+};
+
+static_assert(sizeof(BarCache::Header) == 128, "Bar cache header should span two cache lines");
+static_assert(sizeof(double) == sizeof(int64_t), "Columns are assumed to be 8 bytes wide");
+
+namespace {
+
+size_t mapping_size(size_t count, uint32_t flags) {
+    size_t columns = 4 + ((flags & kHasOpen) ? 1 : 0) + ((flags & kHasVolume) ? 1 : 0);
+    return sizeof(BarCache::Header) + columns * column_bytes(count);
+}
+
+template <typename T>
+void check_column(ArrayView<T> column, size_t count, bool optional, const char* name) {
+    if (column.size() == count || (optional && column.empty())) {
+        return;
+    }
+    throw std::invalid_argument(std::string("Bar cache column '") + name +
+                                "' does not match the close length");
+}
+
+template <typename T>
+unsigned char* copy_column(unsigned char* out, ArrayView<T> column) {
+    if (!column.empty()) {
+        std::memcpy(out, column.data(), column.size() * sizeof(T));
+    }
+    return out + column_bytes(column.size());
+}
+
+} // namespace
+
+void BarCache::write(const std::string& path, const std::string& symbol, const BarColumns& bars) {
+    int64_t start = bars.size() > 0 ? bars.timestamp[0] : 0;
+    int64_t end = bars.size() > 0 ? bars.timestamp.back() + 1 : 0;
+    write(path, symbol, bars, start, end);
+}
+
+void BarCache::write(const std::string& path, const std::string& symbol, const BarColumns& bars,
+                     int64_t covered_start, int64_t covered_end) {
+    if (symbol.size() > kMaxSymbolLength) {
+        throw std::invalid_argument("Bar cache symbol is longer than " +
+                                    std::to_string(kMaxSymbolLength) + " characters");
+    }
+    const size_t count = bars.size();
+    check_column(bars.timestamp, count, false, "timestamp");
+    check_column(bars.high, count, false, "high");
+    check_column(bars.low, count, false, "low");
+    check_column(bars.open, count, true, "open");
+    check_column(bars.volume, count, true, "volume");
+    for (size_t i = 1; i < count; ++i) {
+        if (bars.timestamp[i] <= bars.timestamp[i - 1]) {
+            throw std::invalid_argument("Bar cache timestamps must be strictly increasing");
+        }
+    }
+    if (covered_start > covered_end ||
+        (count > 0 && (bars.timestamp[0] < covered_start || bars.timestamp.back() >= covered_end))) {
+        throw std::invalid_argument("Bar cache covered range must contain every bar");
+    }
+    
+    uint32_t flags = 0;
+    if (count > 0 && !bars.open.empty()) {
+        flags |= kHasOpen;
+    }
+    if (count > 0 && !bars.volume.empty()) {
+        flags |= kHasVolume;
+    }
+    
+    const size_t size = mapping_size(count, flags);
+    // A temporary per writer, so concurrent writers of one symbol (e.g.
+    // parallel backtests filling the cache on a miss) each rename a whole file
+    const std::string temporary = temporary_path(path);
+    void* mapping;
+    try {
+        mapping = map_file(temporary, size, true, kKind);
+    } catch (...) {
+        // Created but not sized or mapped; the name is ours alone
+        std::remove(temporary.c_str());
+        throw;
+    }
+    
+    // ftruncate zero-fills, so padding and the reserved bytes start at zero
+    Header& header = *static_cast<Header*>(mapping);
+    header.format_version = kFormatVersion;
+    header.flags = flags;
+    header.bar_count = count;
+    header.covered_start = covered_start;
+    header.covered_end = covered_end;
+    std::memcpy(header.symbol, symbol.data(), symbol.size());
+    header.magic = kMagic;
+    
+    unsigned char* out = static_cast<unsigned char*>(mapping) + sizeof(Header);
+    out = copy_column(out, bars.timestamp);
+    if (flags & kHasOpen) {
+        out = copy_column(out, bars.open);
+    }
+    out = copy_column(out, bars.high);
+    out = copy_column(out, bars.low);
+    out = copy_column(out, bars.close);
+    if (flags & kHasVolume) {
+        copy_column(out, bars.volume);
+    }
+    
+    // The columns reach the disk before the rename, so a crash cannot leave
+    // a valid header in front of zeroed data
+    try {
+        flush_file(mapping, size, temporary, kKind);
+        unmap_file(mapping, size);
+        mapping = nullptr;
+        replace_file(temporary, path, kKind);
+    } catch (...) {
+        if (mapping) {
+            unmap_file(mapping, size);
+        }
+        std::remove(temporary.c_str());
+        throw;
+    }
+}
+
+void BarCache::write(const std::string& path, const std::string& symbol, const BarSeries& bars) {
+    write(path, symbol, bars.columns());
+}
+
+BarCache BarCache::open(const std::string& path) {
+    BarCache probe(map_file(path, sizeof(Header), false, kKind), sizeof(Header));
+    const Header& header = probe.header();
+    if (header.magic != kMagic) {
+        throw system_error("Not a bar cache", path);
+    }
+    if (header.format_version != kFormatVersion) {
+        throw system_error("Unsupported bar cache format version " +
+                           std::to_string(header.format_version), path);
+    }
+    if (header.bar_count > std::numeric_limits<size_t>::max() / (8 * kColumnAlignment)) {
+        throw system_error("Corrupt bar cache header", path);
+    }
+    const size_t size = mapping_size(static_cast<size_t>(header.bar_count), header.flags);
+    BarCache cache(map_file(path, size, false, kKind), size);
+    cache.bind_columns();
+    return cache;
+}
+
+BarCache::BarCache(void* mapping, size_t mapped_size)
+    : mapping_(mapping), mapped_size_(mapped_size), size_(0) {}
+
+void BarCache::bind_columns() {
+    size_ = static_cast<size_t>(header().bar_count);
+    const uint32_t flags = header().flags;
+    const unsigned char* in = static_cast<const unsigned char*>(mapping_) + sizeof(Header);
+    auto next = [&]() {
+        const unsigned char* column = in;
+        in += column_bytes(size_);
+        return column;
+    };
+    timestamp_ = ArrayView<int64_t>(reinterpret_cast<const int64_t*>(next()), size_);
+    if (flags & kHasOpen) {
+        open_ = PriceView(reinterpret_cast<const double*>(next()), size_);
+    }
+    high_ = PriceView(reinterpret_cast<const double*>(next()), size_);
+    low_ = PriceView(reinterpret_cast<const double*>(next()), size_);
+    close_ = PriceView(reinterpret_cast<const double*>(next()), size_);
+    if (flags & kHasVolume) {
+        volume_ = ArrayView<int64_t>(reinterpret_cast<const int64_t*>(next()), size_);
+    }
+}
+
+BarCache::BarCache(BarCache&& other) noexcept
+    : mapping_(other.mapping_), mapped_size_(other.mapped_size_), size_(other.size_),
+      open_(other.open_), high_(other.high_), low_(other.low_), close_(other.close_),
+      volume_(other.volume_), timestamp_(other.timestamp_) {
+    other.mapping_ = nullptr;
+}
+
+BarCache& BarCache::operator=(BarCache&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        mapping_ = other.mapping_;
+        mapped_size_ = other.mapped_size_;
+        size_ = other.size_;
+        open_ = other.open_;
+        high_ = other.high_;
+        low_ = other.low_;
+        close_ = other.close_;
+        volume_ = other.volume_;
+        timestamp_ = other.timestamp_;
+        other.mapping_ = nullptr;
+    }
+    return *this;
+}
+
+BarCache::~BarCache() {
+    unmap();
+}
+
+void BarCache::unmap() {
+    if (mapping_) {
+        unmap_file(mapping_, mapped_size_);
+        mapping_ = nullptr;
+    }
+}
+
+const BarCache::Header& BarCache::header() const {
+    return *static_cast<const Header*>(mapping_);
+}
+
+std::string BarCache::symbol() const {
+    return std::string(header().symbol);
+}
+
+bool BarCache::has_open() const {
+    return (header().flags & kHasOpen) != 0;
+}
+
+bool BarCache::has_volume() const {
+    return (header().flags & kHasVolume) != 0;
+}
+
+int64_t BarCache::covered_start() const {
+    return header().covered_start;
+}
+
+int64_t BarCache::covered_end() const {
+    return header().covered_end;
+}
+
+bool BarCache::covers(int64_t start, int64_t end) const {
+    return covered_start() <= start && end <= covered_end();
+}
+
+BarColumns BarCache::columns() const {
+    return BarColumns{open_, high_, low_, close_, volume_, timestamp_};
+}
+
+size_t BarCache::lower_bound(int64_t value) const {
+    return static_cast<size_t>(std::lower_bound(timestamp_.begin(), timestamp_.end(), value) -
+                               timestamp_.begin());
+}
+
+BarColumns BarCache::range(int64_t start, int64_t end) const {
+    size_t first = lower_bound(start);
+    size_t last = std::max(first, lower_bound(end));
+    size_t count = last - first;
+    auto slice = [&](auto column) {
+        using View = decltype(column);
+        return column.empty() ? View() : View(column.data() + first, count);
+    };
+    return BarColumns{slice(open_), slice(high_), slice(low_), slice(close_),
+                      slice(volume_), slice(timestamp_)};
+}
+
+} // namespace indicators
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "indicators.h"
+
+namespace indicators {
+
+class BarSeries;
+
+// Read-only, memory-mapped columnar file of one symbol's historical bars.
+// The file holds a header and contiguous, cache-line aligned timestamp,
+// open, high, low, close and volume arrays, so opening it costs one mmap
+// and the columns go to the series kernels without a copy. Timestamps are
+// strictly increasing Unix seconds and double as the time index.
+//
+// The header also records the time range the file is complete for (the
+// range the bars were queried over), so a cache for [start, end) can serve
+// any sub-range without going back to the database. The layout is host
+// native (little-endian on every supported platform).
+class BarCache {
+public:
+    static constexpr uint32_t kFormatVersion = 1;
+    static constexpr size_t kMaxSymbolLength = 31;
+    
+    // Write bars to path, replacing any existing file. Each call writes its
+    // own temporary file, flushes it to disk and renames it into place, so
+    // readers and concurrent writers never see a half-written cache.
+    // timestamp, high, low and close are required; open and volume may be
+    // empty and are then absent from the file. The covered range defaults
+    // to the first timestamp through one past the last.
+    static void write(const std::string& path, const std::string& symbol, const BarColumns& bars);
+    static void write(const std::string& path, const std::string& symbol, const BarColumns& bars,
+                      int64_t covered_start, int64_t covered_end);
+    static void write(const std::string& path, const std::string& symbol, const BarSeries& bars);
+    
+    static BarCache open(const std::string& path);
+    
+    BarCache(BarCache&& other) noexcept;
+    BarCache& operator=(BarCache&& other) noexcept;
+    BarCache(const BarCache&) = delete;
+    BarCache& operator=(const BarCache&) = delete;
+    ~BarCache();
+    
+    std::string symbol() const;
+    size_t size() const { return size_; }
+    // Whether the optional columns were written
+    bool has_open() const;
+    bool has_volume() const;
+    // Time range [covered_start, covered_end) the file holds every bar of
+    int64_t covered_start() const;
+    int64_t covered_end() const;
+    bool covers(int64_t start, int64_t end) const;
+    
+    PriceView open() const { return open_; }
+    PriceView high() const { return high_; }
+    PriceView low() const { return low_; }
+    PriceView close() const { return close_; }
+    ArrayView<int64_t> volume() const { return volume_; }
+    ArrayView<int64_t> timestamp() const { return timestamp_; }
+    
+    // Views over every bar, or over the bars with start <= timestamp < end
+    BarColumns columns() const;
+    BarColumns range(int64_t start, int64_t end) const;
+    // Index of the first bar with timestamp >= value
+    size_t lower_bound(int64_t value) const;
+    
+    // Mapped layout, defined in bar_cache.cpp
+    struct Header;
+
+private:
+    BarCache(void* mapping, size_t mapped_size);
+    
+    const Header& header() const;
+    void bind_columns();
+    void unmap();
+    
+    void* mapping_;
+    size_t mapped_size_;
+    size_t size_;
+    PriceView open_;
+    PriceView high_;
+    PriceView low_;
+    PriceView close_;
+    ArrayView<int64_t> volume_;
+    ArrayView<int64_t> timestamp_;
+};
+
+} // namespace indicators
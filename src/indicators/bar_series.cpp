@@ -0,0 +1,117 @@
+#include "bar_series.h"
+
+namespace indicators {
+
+BarSeries::BarSeries(size_t capacity)
+    : capacity_(capacity), begin_(0), end_(0) {
+    if (capacity_ > 0) {
+        reserve(2 * capacity_);
+    }
+}
+
+BarSeries BarSeries::from_bars(const std::vector<OHLC>& bars, size_t capacity) {
+    BarSeries series(capacity);
+    if (capacity == 0) {
+        series.reserve(bars.size());
+    }
+    for (const auto& bar : bars) {
+        series.append(bar);
+    }
+    return series;
+}
+
+void BarSeries::reserve(size_t bars) {
+    open_.reserve(bars);
+    high_.reserve(bars);
+    low_.reserve(bars);
+    close_.reserve(bars);
+    volume_.reserve(bars);
+    timestamp_.reserve(bars);
+}
+
+void BarSeries::append(const OHLC& bar) {
+    append(bar.open, bar.high, bar.low, bar.close, bar.volume, bar.timestamp);
+}
+
+void BarSeries::append(double open, double high, double low, double close,
+                       int64_t volume, int64_t timestamp) {
+    if (capacity_ > 0 && end_ == 2 * capacity_) {
+        compact();
+    }
+    
+    open_.push_back(open);
+    high_.push_back(high);
+    low_.push_back(low);
+    close_.push_back(close);
+    volume_.push_back(volume);
+    timestamp_.push_back(timestamp);
+    ++end_;
+    
+    // Drop the oldest bar once the ring is full
+    if (capacity_ > 0 && size() > capacity_) {
+        ++begin_;
+    }
+}
+
+void BarSeries::update_last(const OHLC& bar) {
+    if (empty()) {
+        throw std::runtime_error("No bar to update");
+    }
+    size_t last = end_ - 1;
+    open_[last] = bar.open;
+    high_[last] = bar.high;
+    low_[last] = bar.low;
+    close_[last] = bar.close;
+    volume_[last] = bar.volume;
+    timestamp_[last] = bar.timestamp;
+}
+
+void BarSeries::clear() {
+    open_.clear();
+    high_.clear();
+    low_.clear();
+    close_.clear();
+    volume_.clear();
+    timestamp_.clear();
+    begin_ = 0;
+    end_ = 0;
+}
+
+// Move the live window to the front of the arrays
+void BarSeries::compact() {
+    auto shift = [this](auto& column) {
+        column.erase(column.begin(), column.begin() + begin_);
+    };
+    shift(open_);
+    shift(high_);
+    shift(low_);
+    shift(close_);
+    shift(volume_);
+    shift(timestamp_);
+    end_ -= begin_;
+    begin_ = 0;
+}
+
+OHLC BarSeries::bar(size_t i) const {
+    if (i >= size()) {
+        throw std::out_of_range("Bar index out of range");
+    }
+    size_t index = begin_ + i;
+    return OHLC{open_[index], high_[index], low_[index], close_[index],
+                volume_[index], timestamp_[index]};
+}
+
+std::vector<OHLC> BarSeries::to_bars() const {
+    std::vector<OHLC> bars;
+    bars.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        bars.push_back(bar(i));
+    }
+    return bars;
+}
+
+BarColumns BarSeries::columns() const {
+    return BarColumns{open(), high(), low(), close(), volume(), timestamp()};
+}
+
+} // namespace indicators
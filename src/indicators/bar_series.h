@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "indicators.h"
+
+namespace indicators {
+
+// Allocator returning storage aligned to Alignment bytes (a cache line by
+// default) so column kernels start on an aligned boundary
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+    
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+    
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+    
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+    
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Columnar (struct-of-arrays) bar storage. Each field lives in its own
+// aligned contiguous array, so kernels read dense columns with no per-call
+// copy. With a non-zero capacity the series behaves as a ring buffer that
+// keeps the most recent capacity bars; old bars are dropped by compacting
+// the arrays once every capacity appends, so the columns stay contiguous
+// and appends are amortized O(1).
+class BarSeries {
+public:
+    // capacity == 0 keeps every bar
+    explicit BarSeries(size_t capacity = 0);
+    
+    static BarSeries from_bars(const std::vector<OHLC>& bars, size_t capacity = 0);
+    
+    void append(const OHLC& bar);
+    void append(double open, double high, double low, double close,
+                int64_t volume, int64_t timestamp);
+    // Replace the most recent bar, e.g. while it is still forming
+    void update_last(const OHLC& bar);
+    void clear();
+    void reserve(size_t bars);
+    
+    size_t size() const { return end_ - begin_; }
+    bool empty() const { return end_ == begin_; }
+    size_t capacity() const { return capacity_; }
+    
+    // Bar i, oldest first
+    OHLC bar(size_t i) const;
+    std::vector<OHLC> to_bars() const;
+    
+    PriceView open() const { return PriceView(open_.data() + begin_, size()); }
+    PriceView high() const { return PriceView(high_.data() + begin_, size()); }
+    PriceView low() const { return PriceView(low_.data() + begin_, size()); }
+    PriceView close() const { return PriceView(close_.data() + begin_, size()); }
+    ArrayView<int64_t> volume() const { return ArrayView<int64_t>(volume_.data() + begin_, size()); }
+    ArrayView<int64_t> timestamp() const { return ArrayView<int64_t>(timestamp_.data() + begin_, size()); }
+    
+    BarColumns columns() const;
+
+private:
+    void compact();
+    
+    size_t capacity_;
+    size_t begin_;
+    size_t end_;
+    AlignedVector<double> open_;
+    AlignedVector<double> high_;
+    AlignedVector<double> low_;
+    AlignedVector<double> close_;
+    AlignedVector<int64_t> volume_;
+    AlignedVector<int64_t> timestamp_;
+};
+
+} // namespace indicators
@@ -0,0 +1,252 @@
+// Google Benchmark suite for the indicator engine.
+//
+// Build with -DINDICATORS_BUILD_BENCHMARKS=ON and run
+//   ./indicators_bench --benchmark_filter=Indicator
+// Bar counts span 100 to 1M so that super-linear kernels stand out as a
+// growing time per bar (items_per_second falling with size).
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bar_series.h"
+#include "indicators.h"
+#include "state_registry.h"
+
+// Count heap allocations so benchmarks can report allocations per call
+namespace {
+std::atomic<size_t> g_allocations{0};
+} // namespace
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+using indicators::BarSeries;
+using indicators::OHLC;
+using indicators::PriceData;
+using indicators::TechnicalIndicatorEngine;
+
+// Geometric random walk with a plausible intrabar range
+std::vector<OHLC> make_bars(size_t count, uint32_t seed = 42) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> step(0.0, 0.01);
+    std::uniform_real_distribution<double> range(0.0, 0.005);
+    
+    std::vector<OHLC> bars;
+    bars.reserve(count);
+    double price = 100.0;
+    for (size_t i = 0; i < count; ++i) {
+        double open = price;
+        price *= std::exp(step(rng));
+        double high = std::max(open, price) * (1.0 + range(rng));
+        double low = std::min(open, price) * (1.0 - range(rng));
+        bars.push_back(OHLC{open, high, low, price, 1000 + static_cast<int64_t>(i % 500),
+                            1700000000 + static_cast<int64_t>(i) * 60});
+    }
+    return bars;
+}
+
+std::vector<double> closes_of(const std::vector<OHLC>& bars) {
+    std::vector<double> closes;
+    closes.reserve(bars.size());
+    for (const auto& bar : bars) {
+        closes.push_back(bar.close);
+    }
+    return closes;
+}
+
+void set_bars_processed(benchmark::State& state, size_t bars_per_iteration) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * bars_per_iteration));
+}
+
+// Heap allocations per iteration since allocations_before was sampled
+void set_allocations(benchmark::State& state, size_t allocations_before) {
+    size_t allocations = g_allocations.load(std::memory_order_relaxed) - allocations_before;
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations),
+                                                  benchmark::Counter::kAvgIterations);
+}
+
+// Full compute_indicators over columnar storage, the engine's fastest input
+void BM_ComputeIndicators(benchmark::State& state) {
+    const size_t bars = static_cast<size_t>(state.range(0));
+    BarSeries series = BarSeries::from_bars(make_bars(bars));
+    TechnicalIndicatorEngine engine;
+    size_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.compute_indicators(series));
+    }
+    set_allocations(state, allocations);
+    set_bars_processed(state, bars);
+}
+BENCHMARK(BM_ComputeIndicators)->ArgName("bars")->RangeMultiplier(10)->Range(100, 1000000);
+
+// Same computation from an OHLC vector, including gathering the columns
+void BM_ComputeIndicatorsPriceData(benchmark::State& state) {
+    const size_t bars = static_cast<size_t>(state.range(0));
+    PriceData prices;
+    prices.symbol = "BENCH";
+    prices.bars = make_bars(bars);
+    TechnicalIndicatorEngine engine;
+    // Grow this thread's scratch arena before counting
+    engine.compute_indicators(prices);
+    size_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.compute_indicators(prices));
+    }
+    set_allocations(state, allocations);
+    set_bars_processed(state, bars);
+}
+BENCHMARK(BM_ComputeIndicatorsPriceData)->ArgName("bars")->RangeMultiplier(10)->Range(100, 1000000);
+
+enum Indicator {
+    kRsi,
+    kMacd,
+    kBollinger,
+    kSma,
+    kEma,
+    kAtr,
+    kMacdSeries,
+    kIndicatorCount
+};
+
+const char* indicator_name(int indicator) {
+    static const char* const names[kIndicatorCount] = {
+        "rsi", "macd", "bollinger", "sma", "ema", "atr", "macd_series"};
+    return names[indicator];
+}
+
+// One scalar kernel at a time: range(0) selects the indicator, range(1)
+// the bar count. SMA, Bollinger and ATR only read their trailing window, so
+// their bars/s grows with the bar count by design.
+void BM_Indicator(benchmark::State& state) {
+    const int indicator = static_cast<int>(state.range(0));
+    const size_t bars = static_cast<size_t>(state.range(1));
+    const std::vector<OHLC> ohlc = make_bars(bars);
+    const std::vector<double> closes = closes_of(ohlc);
+    const BarSeries series = BarSeries::from_bars(ohlc);
+    TechnicalIndicatorEngine engine;
+    for (auto _ : state) {
+        switch (indicator) {
+            case kRsi:
+                benchmark::DoNotOptimize(engine.compute_rsi(closes, 14));
+                break;
+            case kMacd:
+                benchmark::DoNotOptimize(engine.compute_macd(closes, 12, 26, 9));
+                break;
+            case kBollinger:
+                benchmark::DoNotOptimize(engine.compute_bollinger_bands(closes, 20, 2.0));
+                break;
+            case kSma:
+                benchmark::DoNotOptimize(engine.compute_sma(closes, 50));
+                break;
+            case kEma:
+                benchmark::DoNotOptimize(engine.compute_ema(closes, 26));
+                break;
+            case kAtr:
+                benchmark::DoNotOptimize(engine.compute_atr(series.high(), series.low(), series.close(), 14));
+                break;
+            case kMacdSeries:
+                benchmark::DoNotOptimize(engine.compute_macd_series(closes, 12, 26, 9));
+                break;
+        }
+    }
+    state.SetLabel(indicator_name(indicator));
+    set_bars_processed(state, bars);
+}
+BENCHMARK(BM_Indicator)
+    ->ArgNames({"indicator", "bars"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, kIndicatorCount - 1, 1),
+                   benchmark::CreateRange(100, 1000000, 10)});
+
+// Many symbols through the work-stealing pool; range(0) symbols, range(1) bars
+void BM_ComputeIndicatorsBatch(benchmark::State& state) {
+    const size_t symbols = static_cast<size_t>(state.range(0));
+    const size_t bars = static_cast<size_t>(state.range(1));
+    std::vector<PriceData> batch(symbols);
+    for (size_t i = 0; i < symbols; ++i) {
+        batch[i].symbol = "SYM" + std::to_string(i);
+        batch[i].bars = make_bars(bars, static_cast<uint32_t>(i + 1));
+    }
+    TechnicalIndicatorEngine engine;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.compute_indicators_batch(batch));
+    }
+    set_bars_processed(state, symbols * bars);
+}
+BENCHMARK(BM_ComputeIndicatorsBatch)
+    ->ArgNames({"symbols", "bars"})
+    ->ArgsProduct({benchmark::CreateRange(1, 512, 8), {500, 10000}})
+    ->UseRealTime();
+
+// Streaming: cost of one push_bar against a warmed-up state
+void BM_IncrementalPushBar(benchmark::State& state) {
+    const std::vector<OHLC> bars = make_bars(100000);
+    indicators::IncrementalIndicatorState stream;
+    size_t next = 0;
+    while (!stream.ready()) {
+        stream.push_bar(bars[next++]);
+    }
+    for (auto _ : state) {
+        stream.push_bar(bars[next]);
+        benchmark::DoNotOptimize(stream.results());
+        next = (next + 1) % bars.size();
+    }
+    set_bars_processed(state, 1);
+}
+BENCHMARK(BM_IncrementalPushBar);
+
+// Registry writers, one symbol per thread: per-thread time stays flat as
+// threads are added while writers do not contend
+void BM_StateRegistryPushBar(benchmark::State& state) {
+    static indicators::StateRegistry registry;
+    const std::vector<OHLC> bars = make_bars(100000, 42 + static_cast<uint32_t>(state.thread_index()));
+    const std::string symbol = "SYM" + std::to_string(state.thread_index());
+    size_t next = 0;
+    for (auto _ : state) {
+        registry.push_bar(symbol, bars[next]);
+        next = (next + 1) % bars.size();
+    }
+    set_bars_processed(state, 1);
+}
+BENCHMARK(BM_StateRegistryPushBar)->ThreadRange(1, 16)->UseRealTime();
+
+// Registry readers of one warmed-up symbol
+void BM_StateRegistryRead(benchmark::State& state) {
+    static indicators::StateRegistry registry;
+    if (state.thread_index() == 0 && !registry.contains("AAPL")) {
+        for (const OHLC& bar : make_bars(100)) {
+            registry.push_bar("AAPL", bar);
+        }
+    }
+    indicators::PublishedState published;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.read("AAPL", published));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_StateRegistryRead)->ThreadRange(1, 16)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
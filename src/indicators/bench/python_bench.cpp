@@ -0,0 +1,133 @@
+// Round-trip benchmarks through the Python wrapper (engine.py) and the
+// pybind11 module, run in an embedded interpreter. They measure what a
+// Python caller pays on top of the C++ kernels: model conversion, argument
+// marshalling and result conversion.
+//
+// The indicators_engine module must be built (the bench target depends on
+// it); without it the benchmarks are skipped with an error message.
+
+#include <benchmark/benchmark.h>
+#include <pybind11/embed.h>
+
+#include <memory>
+#include <string>
+
+namespace py = pybind11;
+
+namespace {
+
+const char* const kSetup = R"(
+import sys
+sys.path.insert(0, repo_root)
+
+from datetime import datetime, timedelta
+import numpy as np
+from src.indicators import engine as engine_module
+from src.shared.models import OHLC, PriceData
+
+engine = engine_module.TechnicalIndicatorEngine()
+
+def make_price_data(count):
+    rng = np.random.default_rng(42)
+    closes = 100.0 * np.exp(np.cumsum(rng.normal(0.0, 0.01, count)))
+    start = datetime(2024, 1, 1)
+    bars = [
+        OHLC(open=float(c), high=float(c) * 1.002, low=float(c) * 0.998, close=float(c),
+             volume=1000, timestamp=start + timedelta(minutes=i))
+        for i, c in enumerate(closes)
+    ]
+    return PriceData(symbol="BENCH", bars=bars, timestamp=start)
+)";
+
+// Interpreter and setup namespace, created on first use. Holds the import
+// error instead if engine.py or the compiled module cannot be loaded.
+struct PythonBench {
+    std::unique_ptr<py::scoped_interpreter> interpreter;
+    py::dict scope;
+    std::string error;
+};
+
+PythonBench& python_bench() {
+    static PythonBench bench = [] {
+        PythonBench setup;
+        setup.interpreter = std::make_unique<py::scoped_interpreter>();
+        try {
+            setup.scope = py::dict(py::module_::import("__main__").attr("__dict__"));
+            setup.scope["repo_root"] = INDICATORS_REPO_ROOT;
+            py::exec(kSetup, setup.scope);
+            if (!setup.scope["engine_module"].attr("CPP_AVAILABLE").cast<bool>()) {
+                setup.error = "indicators_engine module not built";
+            }
+        } catch (const py::error_already_set& e) {
+            setup.error = e.what();
+        }
+        return setup;
+    }();
+    return bench;
+}
+
+// Returns false (and marks the benchmark skipped) if Python setup failed
+bool ready(benchmark::State& state) {
+    const PythonBench& bench = python_bench();
+    if (!bench.error.empty()) {
+        state.SkipWithError(bench.error.c_str());
+        return false;
+    }
+    return true;
+}
+
+// engine.compute_indicators(PriceData): models to columns, native call and
+// conversion back to the Python IndicatorResults dataclass
+void BM_PythonComputeIndicators(benchmark::State& state) {
+    if (!ready(state)) {
+        return;
+    }
+    py::dict& scope = python_bench().scope;
+    py::object engine = scope["engine"];
+    py::object price_data = scope["make_price_data"](state.range(0));
+    py::object compute = engine.attr("compute_indicators");
+    for (auto _ : state) {
+        py::object results = compute(price_data);
+        benchmark::DoNotOptimize(results.ptr());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PythonComputeIndicators)->ArgName("bars")->RangeMultiplier(10)->Range(100, 100000);
+
+// engine.compute_indicators_from_arrays with NumPy columns read in place
+void BM_PythonComputeFromArrays(benchmark::State& state) {
+    if (!ready(state)) {
+        return;
+    }
+    py::dict& scope = python_bench().scope;
+    py::object engine = scope["engine"];
+    py::object price_data = scope["make_price_data"](state.range(0));
+    py::dict columns = engine.attr("_convert_price_data_to_columns")(price_data).cast<py::dict>();
+    py::object compute = engine.attr("compute_indicators_from_arrays");
+    for (auto _ : state) {
+        py::object results = compute(**columns);
+        benchmark::DoNotOptimize(results.ptr());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PythonComputeFromArrays)->ArgName("bars")->RangeMultiplier(10)->Range(100, 100000);
+
+// Bare pybind11 call on the native engine, the floor for any Python caller
+void BM_PythonNativeCall(benchmark::State& state) {
+    if (!ready(state)) {
+        return;
+    }
+    py::dict& scope = python_bench().scope;
+    py::object engine = scope["engine"];
+    py::object price_data = scope["make_price_data"](state.range(0));
+    py::dict columns = engine.attr("_convert_price_data_to_columns")(price_data).cast<py::dict>();
+    py::object compute = engine.attr("_engine").attr("compute_indicators");
+    for (auto _ : state) {
+        py::object results = compute(**columns);
+        benchmark::DoNotOptimize(results.ptr());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PythonNativeCall)->ArgName("bars")->RangeMultiplier(10)->Range(100, 100000);
+
+} // namespace
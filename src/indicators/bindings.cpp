@@ -1,9 +1,240 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <thread>
 #include "indicators.h"
+#include "backtest.h"
+#include "bar_aggregator.h"
+#include "bar_cache.h"
+#include "bar_series.h"
+#include "compact_bar_series.h"
+#include "composite_scorer.h"
+#include "profiling.h"
+#include "result_cache.h"
+#include "result_codec.h"
+#include "shared_bar_ring.h"
+#include "simd_kernels.h"
+#include "state_codec.h"
+#include "state_registry.h"
 
 namespace py = pybind11;
 
+namespace pybind11 {
+namespace detail {
+
+// Loads ArrayView arguments. C-contiguous one-dimensional NumPy arrays of
+// the exact dtype are read in place; any other sequence is copied into
+// storage owned by the caster, which lives for the duration of the call.
+template <typename T>
+struct type_caster<indicators::ArrayView<T>> {
+    PYBIND11_TYPE_CASTER(indicators::ArrayView<T>,
+                         _("numpy.ndarray[") + npy_format_descriptor<T>::name + _("]"));
+    
+    bool load(handle src, bool convert) {
+        if (array_t<T, array::c_style>::check_(src)) {
+            array_ = reinterpret_borrow<array_t<T, array::c_style>>(src);
+            if (array_.ndim() != 1) {
+                return false;
+            }
+            value = indicators::ArrayView<T>(array_.data(), static_cast<size_t>(array_.size()));
+            return true;
+        }
+        
+        if (!convert) {
+            return false;
+        }
+        
+        list_caster<std::vector<T>, T> sequence;
+        if (!sequence.load(src, convert)) {
+            return false;
+        }
+        storage_ = cast_op<std::vector<T>&&>(std::move(sequence));
+        value = indicators::ArrayView<T>(storage_);
+        return true;
+    }
+    
+    static handle cast(const indicators::ArrayView<T>& src, return_value_policy, handle) {
+        return array_t<T>(static_cast<ssize_t>(src.size()), src.data()).release();
+    }
+    
+private:
+    array_t<T, array::c_style> array_;
+    std::vector<T> storage_;
+};
+
+} // namespace detail
+} // namespace pybind11
+
+namespace {
+
+// Allocate a NumPy array and a writable view over it for series output
+template <typename T>
+py::array_t<T> new_series(size_t size, indicators::MutableArrayView<T>& view) {
+    py::array_t<T> array(static_cast<py::ssize_t>(size));
+    view = indicators::MutableArrayView<T>(array.mutable_data(), size);
+    return array;
+}
+
+// Cross-sectional input: a (symbols, bars) array in Fortran order, so each
+// bar's closes are contiguous. forcecast copies anything else into that
+// layout.
+template <typename T>
+using PriceMatrixArray = py::array_t<T, py::array::f_style | py::array::forcecast>;
+
+template <typename T>
+indicators::BasicPriceMatrix<T> price_matrix(const PriceMatrixArray<T>& closes) {
+    if (closes.ndim() != 2) {
+        throw py::value_error("closes must be a two-dimensional (symbols, bars) array");
+    }
+    return indicators::BasicPriceMatrix<T>(closes.data(), static_cast<size_t>(closes.shape(0)),
+                                   static_cast<size_t>(closes.shape(1)));
+}
+
+// Allocate a (symbols, bars) Fortran-order array matching closes and a
+// writable view over it
+template <typename T>
+py::array new_matrix(const indicators::BasicPriceMatrix<T>& closes,
+                     indicators::MutableArrayView<T>& view) {
+    py::array_t<T, py::array::f_style> array(
+        {static_cast<py::ssize_t>(closes.symbols), static_cast<py::ssize_t>(closes.bars)});
+    view = indicators::MutableArrayView<T>(array.mutable_data(), closes.size());
+    return array;
+}
+
+// Run compute(matrix, last, series) over closes converted to a T matrix
+// with the GIL released, returning last or, with full_series, the history
+template <typename T, typename Compute>
+py::object cross_section(const py::object& closes, bool full_series, const Compute& compute) {
+    PriceMatrixArray<T> input = PriceMatrixArray<T>::ensure(closes);
+    if (!input) {
+        throw py::type_error("closes must be a numeric (symbols, bars) array");
+    }
+    indicators::BasicPriceMatrix<T> matrix = price_matrix(input);
+    indicators::MutableArrayView<T> last, series;
+    py::object result = new_series(matrix.symbols, last);
+    if (full_series) {
+        result = new_matrix(matrix, series);
+    }
+    {
+        py::gil_scoped_release release;
+        compute(matrix, last, series);
+    }
+    return result;
+}
+
+// float32 closes run the single-precision kernels; anything else is
+// computed in float64
+template <typename Compute>
+py::object dispatch_cross_section(const py::object& closes, bool full_series,
+                                  const Compute& compute) {
+    if (py::isinstance<py::array_t<float>>(closes)) {
+        return cross_section<float>(closes, full_series, compute);
+    }
+    return cross_section<double>(closes, full_series, compute);
+}
+
+std::string exception_message(std::exception_ptr error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+        return e.what();
+    } catch (...) {
+        return "Unknown error";
+    }
+}
+
+// Python objects a pending submit_* completion keeps alive
+struct CompletionReferences {
+    py::function callback;
+    py::object engine;
+};
+
+int release_completion_references(void* held) {
+    delete static_cast<CompletionReferences*>(held);
+    return 0;
+}
+
+// Drops the references off the pool. Released on the worker, the last
+// reference to an engine with a dedicated pool would run ~ThreadPool on
+// one of its own threads, which cannot join itself; instead the main
+// thread releases them the next time it runs Python code.
+void release_off_pool(CompletionReferences* held) {
+    py::gil_scoped_acquire gil;
+    if (Py_AddPendingCall(&release_completion_references, held) != 0) {
+        // Pending call queue is full: any thread outside the pool will do
+        std::thread([held]() {
+            py::gil_scoped_acquire gil;
+            delete held;
+        }).detach();
+    }
+}
+
+// Completion for the engine's submit_* methods: calls callback(result,
+// error) on the worker thread with the GIL held, where error is None or
+// the exception message. The callable and the engine stay referenced until
+// the task is done and are released under the GIL.
+template <typename T>
+indicators::CompletionCallback<T> python_completion(py::function callback, py::object engine) {
+    std::shared_ptr<CompletionReferences> refs(
+        new CompletionReferences{std::move(callback), std::move(engine)}, &release_off_pool);
+    return [refs](const T& result, std::exception_ptr error) {
+        py::gil_scoped_acquire gil;
+        try {
+            if (error) {
+                refs->callback(py::none(), exception_message(error));
+            } else {
+                refs->callback(result, py::none());
+            }
+        } catch (py::error_already_set& e) {
+            e.discard_as_unraisable("indicators_engine completion callback");
+        }
+    };
+}
+
+// Read-only NumPy view over memory owned by owner; the array keeps owner alive
+template <typename T>
+py::array_t<T> borrowed_array(indicators::ArrayView<T> values, py::handle owner) {
+    py::array_t<T> array(static_cast<py::ssize_t>(values.size()), values.data(), owner);
+    array.attr("flags").attr("writeable") = false;
+    return array;
+}
+
+// Column dict (the keys compute_indicators_from_arrays takes) over a cache
+py::dict cache_columns(const indicators::BarColumns& bars, py::handle owner) {
+    py::dict columns;
+    columns["open"] = bars.open.empty() ? py::object(py::none()) : borrowed_array(bars.open, owner);
+    columns["high"] = borrowed_array(bars.high, owner);
+    columns["low"] = borrowed_array(bars.low, owner);
+    columns["close"] = borrowed_array(bars.close, owner);
+    columns["volume"] = bars.volume.empty() ? py::object(py::none()) : borrowed_array(bars.volume, owner);
+    columns["timestamp"] = borrowed_array(bars.timestamp, owner);
+    return columns;
+}
+
+} // namespace
+
+// Decoder over an encoded result batch held by a Python buffer (bytes,
+// bytearray, memoryview). The buffer stays exported while the batch lives,
+// so records are read in place.
+struct PyResultBatch {
+    static py::buffer_info contiguous(const py::buffer& source) {
+        py::buffer_info info = source.request();
+        if (info.ndim != 1 || info.strides[0] != info.itemsize) {
+            throw std::invalid_argument("Encoded results must be a contiguous one-dimensional buffer");
+        }
+        return info;
+    }
+    
+    explicit PyResultBatch(const py::buffer& source)
+        : buffer(source),
+          info(contiguous(source)),
+          view(info.ptr, static_cast<size_t>(info.size * info.itemsize)) {}
+    
+    py::buffer buffer;
+    py::buffer_info info;
+    indicators::ResultBatchView view;
+};
+
 PYBIND11_MODULE(indicators_engine, m) {
     m.doc() = "C++ Technical Indicator Engine for high-performance computation";
     
@@ -24,6 +255,105 @@ PYBIND11_MODULE(indicators_engine, m) {
         .def_readwrite("bars", &indicators::PriceData::bars)
         .def_readwrite("timestamp", &indicators::PriceData::timestamp);
     
+    // BarSeries columnar storage
+    py::class_<indicators::BarSeries>(m, "BarSeries")
+        .def(py::init<size_t>(), py::arg("capacity") = 0,
+             "Create columnar bar storage; a non-zero capacity keeps only the most recent bars")
+        .def_static("from_bars", &indicators::BarSeries::from_bars,
+                    "Build a series from a list of OHLC bars",
+                    py::arg("bars"), py::arg("capacity") = 0)
+        .def("append", py::overload_cast<const indicators::OHLC&>(&indicators::BarSeries::append),
+             "Append a bar", py::arg("bar"))
+        .def("append",
+             py::overload_cast<double, double, double, double, int64_t, int64_t>(
+                 &indicators::BarSeries::append),
+             "Append a bar from its fields",
+             py::arg("open"), py::arg("high"), py::arg("low"), py::arg("close"),
+             py::arg("volume"), py::arg("timestamp"))
+        .def("update_last", &indicators::BarSeries::update_last,
+             "Replace the most recent bar", py::arg("bar"))
+        .def("clear", &indicators::BarSeries::clear)
+        .def("reserve", &indicators::BarSeries::reserve, py::arg("bars"))
+        .def("__len__", &indicators::BarSeries::size)
+        .def_property_readonly("capacity", &indicators::BarSeries::capacity)
+        .def("bar", &indicators::BarSeries::bar, "Bar i, oldest first", py::arg("index"))
+        .def("to_bars", &indicators::BarSeries::to_bars)
+        // Column accessors return copies: appends may reallocate the storage
+        .def_property_readonly("open", [](const indicators::BarSeries& series) {
+            return py::array_t<double>(static_cast<py::ssize_t>(series.size()), series.open().data());
+        })
+        .def_property_readonly("high", [](const indicators::BarSeries& series) {
+            return py::array_t<double>(static_cast<py::ssize_t>(series.size()), series.high().data());
+        })
+        .def_property_readonly("low", [](const indicators::BarSeries& series) {
+            return py::array_t<double>(static_cast<py::ssize_t>(series.size()), series.low().data());
+        })
+        .def_property_readonly("close", [](const indicators::BarSeries& series) {
+            return py::array_t<double>(static_cast<py::ssize_t>(series.size()), series.close().data());
+        })
+        .def_property_readonly("volume", [](const indicators::BarSeries& series) {
+            return py::array_t<int64_t>(static_cast<py::ssize_t>(series.size()), series.volume().data());
+        })
+        .def_property_readonly("timestamp", [](const indicators::BarSeries& series) {
+            return py::array_t<int64_t>(static_cast<py::ssize_t>(series.size()), series.timestamp().data());
+        });
+    
+    // CompactBarSeries reduced-precision storage
+    py::class_<indicators::CompactBarSeries>(m, "CompactBarSeries")
+        .def(py::init<>(),
+             "Create float32 bar storage with uint32 volumes and int32 timestamp offsets")
+        .def_static("from_bars", &indicators::CompactBarSeries::from_bars,
+                    "Build a compact series from a list of OHLC bars", py::arg("bars"))
+        .def_static("from_series",
+                    [](const indicators::BarSeries& series) {
+                        return indicators::CompactBarSeries::from_columns(series.columns());
+                    },
+                    "Build a compact copy of a BarSeries", py::arg("series"))
+        .def("append",
+             py::overload_cast<const indicators::OHLC&>(&indicators::CompactBarSeries::append),
+             "Append a bar; raises IndexError if its volume or timestamp does not fit",
+             py::arg("bar"))
+        .def("append",
+             py::overload_cast<double, double, double, double, int64_t, int64_t>(
+                 &indicators::CompactBarSeries::append),
+             "Append a bar from its fields",
+             py::arg("open"), py::arg("high"), py::arg("low"), py::arg("close"),
+             py::arg("volume"), py::arg("timestamp"))
+        .def("update_last", &indicators::CompactBarSeries::update_last,
+             "Replace the most recent bar", py::arg("bar"))
+        .def("clear", &indicators::CompactBarSeries::clear)
+        .def("reserve", &indicators::CompactBarSeries::reserve, py::arg("bars"))
+        .def("__len__", &indicators::CompactBarSeries::size)
+        .def_property_readonly("memory_bytes", &indicators::CompactBarSeries::memory_bytes)
+        .def_property_readonly("base_timestamp", &indicators::CompactBarSeries::base_timestamp)
+        .def("bar", &indicators::CompactBarSeries::bar,
+             "Bar i, oldest first, with prices widened to float64", py::arg("index"))
+        .def("to_bars", &indicators::CompactBarSeries::to_bars)
+        // Column accessors return copies in the stored dtypes
+        .def_property_readonly("open", [](const indicators::CompactBarSeries& series) {
+            return py::array_t<float>(static_cast<py::ssize_t>(series.size()), series.open().data());
+        })
+        .def_property_readonly("high", [](const indicators::CompactBarSeries& series) {
+            return py::array_t<float>(static_cast<py::ssize_t>(series.size()), series.high().data());
+        })
+        .def_property_readonly("low", [](const indicators::CompactBarSeries& series) {
+            return py::array_t<float>(static_cast<py::ssize_t>(series.size()), series.low().data());
+        })
+        .def_property_readonly("close", [](const indicators::CompactBarSeries& series) {
+            return py::array_t<float>(static_cast<py::ssize_t>(series.size()), series.close().data());
+        })
+        .def_property_readonly("volume", [](const indicators::CompactBarSeries& series) {
+            return py::array_t<uint32_t>(static_cast<py::ssize_t>(series.size()), series.volume().data());
+        })
+        .def_property_readonly("timestamp", [](const indicators::CompactBarSeries& series) {
+            py::array_t<int64_t> timestamps(static_cast<py::ssize_t>(series.size()));
+            int64_t* out = timestamps.mutable_data();
+            for (size_t i = 0; i < series.size(); ++i) {
+                out[i] = series.timestamp(i);
+            }
+            return timestamps;
+        });
+    
     // MACDResult structure
     py::class_<indicators::MACDResult>(m, "MACDResult")
         .def(py::init<>())
@@ -31,6 +361,13 @@ PYBIND11_MODULE(indicators_engine, m) {
         .def_readwrite("signal_line", &indicators::MACDResult::signal_line)
         .def_readwrite("histogram", &indicators::MACDResult::histogram);
     
+    // MACDSeries structure
+    py::class_<indicators::MACDSeries>(m, "MACDSeries")
+        .def(py::init<>())
+        .def_readwrite("macd_line", &indicators::MACDSeries::macd_line)
+        .def_readwrite("signal_line", &indicators::MACDSeries::signal_line)
+        .def_readwrite("histogram", &indicators::MACDSeries::histogram);
+    
     // BollingerBands structure
     py::class_<indicators::BollingerBands>(m, "BollingerBands")
         .def(py::init<>())
@@ -50,6 +387,296 @@ PYBIND11_MODULE(indicators_engine, m) {
         .def_readwrite("ema_26", &indicators::IndicatorResults::ema_26)
         .def_readwrite("atr", &indicators::IndicatorResults::atr);
     
+    // Indicator selection
+    py::enum_<indicators::MovingAverageType>(m, "MovingAverageType")
+        .value("SMA", indicators::MovingAverageType::SMA)
+        .value("EMA", indicators::MovingAverageType::EMA);
+    
+    py::class_<indicators::MovingAverageSpec>(m, "MovingAverageSpec")
+        .def(py::init([](indicators::MovingAverageType type, int period) {
+                 return indicators::MovingAverageSpec{type, period};
+             }),
+             py::arg("type"), py::arg("period"))
+        .def_readwrite("type", &indicators::MovingAverageSpec::type)
+        .def_readwrite("period", &indicators::MovingAverageSpec::period);
+    
+    // moving_averages is copied to and from a Python list, so assign a new
+    // list rather than appending to it
+    py::class_<indicators::IndicatorSpec>(m, "IndicatorSpec")
+        .def(py::init<>())
+        .def_readwrite("rsi", &indicators::IndicatorSpec::rsi)
+        .def_readwrite("rsi_period", &indicators::IndicatorSpec::rsi_period)
+        .def_readwrite("macd", &indicators::IndicatorSpec::macd)
+        .def_readwrite("macd_fast_period", &indicators::IndicatorSpec::macd_fast_period)
+        .def_readwrite("macd_slow_period", &indicators::IndicatorSpec::macd_slow_period)
+        .def_readwrite("macd_signal_period", &indicators::IndicatorSpec::macd_signal_period)
+        .def_readwrite("bollinger", &indicators::IndicatorSpec::bollinger)
+        .def_readwrite("bollinger_period", &indicators::IndicatorSpec::bollinger_period)
+        .def_readwrite("bollinger_std_dev", &indicators::IndicatorSpec::bollinger_std_dev)
+        .def_readwrite("atr", &indicators::IndicatorSpec::atr)
+        .def_readwrite("atr_period", &indicators::IndicatorSpec::atr_period)
+        .def_readwrite("obv", &indicators::IndicatorSpec::obv)
+        .def_readwrite("vwap", &indicators::IndicatorSpec::vwap)
+        .def_readwrite("vwap_session_seconds", &indicators::IndicatorSpec::vwap_session_seconds)
+        .def_readwrite("vwap_session_offset", &indicators::IndicatorSpec::vwap_session_offset)
+        .def_readwrite("mfi", &indicators::IndicatorSpec::mfi)
+        .def_readwrite("mfi_period", &indicators::IndicatorSpec::mfi_period)
+        .def_readwrite("volume_sma", &indicators::IndicatorSpec::volume_sma)
+        .def_readwrite("volume_sma_period", &indicators::IndicatorSpec::volume_sma_period)
+        .def_readwrite("moving_averages", &indicators::IndicatorSpec::moving_averages)
+        .def("validate", &indicators::IndicatorSpec::validate,
+             "Raise ValueError for invalid periods")
+        .def("required_bars", &indicators::IndicatorSpec::required_bars,
+             "Fewest bars for which every enabled indicator is defined");
+    
+    py::class_<indicators::MovingAverageValue>(m, "MovingAverageValue")
+        .def_readonly("type", &indicators::MovingAverageValue::type)
+        .def_readonly("period", &indicators::MovingAverageValue::period)
+        .def_readonly("value", &indicators::MovingAverageValue::value);
+    
+    py::class_<indicators::IndicatorValues>(m, "IndicatorValues")
+        .def_readonly("rsi", &indicators::IndicatorValues::rsi)
+        .def_readonly("macd", &indicators::IndicatorValues::macd)
+        .def_readonly("bollinger", &indicators::IndicatorValues::bollinger)
+        .def_readonly("atr", &indicators::IndicatorValues::atr)
+        .def_readonly("obv", &indicators::IndicatorValues::obv)
+        .def_readonly("vwap", &indicators::IndicatorValues::vwap)
+        .def_readonly("mfi", &indicators::IndicatorValues::mfi)
+        .def_readonly("volume_sma", &indicators::IndicatorValues::volume_sma)
+        .def_property_readonly("moving_averages",
+             [](const indicators::IndicatorValues& values) {
+                 return std::vector<indicators::MovingAverageValue>(
+                     values.moving_averages.begin(),
+                     values.moving_averages.begin() + values.moving_average_count);
+             })
+        .def("sma", &indicators::IndicatorValues::sma,
+             "Value of a requested SMA", py::arg("period"))
+        .def("ema", &indicators::IndicatorValues::ema,
+             "Value of a requested EMA", py::arg("period"));
+    
+    // Non-throwing computation outcomes
+    py::enum_<indicators::ComputeStatus>(m, "ComputeStatus")
+        .value("OK", indicators::ComputeStatus::OK)
+        .value("PARTIAL", indicators::ComputeStatus::PARTIAL)
+        .value("INSUFFICIENT_DATA", indicators::ComputeStatus::INSUFFICIENT_DATA)
+        .value("INVALID_INPUT", indicators::ComputeStatus::INVALID_INPUT);
+    
+    py::class_<indicators::IndicatorValidity>(m, "IndicatorValidity")
+        .def_readonly("rsi", &indicators::IndicatorValidity::rsi)
+        .def_readonly("macd", &indicators::IndicatorValidity::macd)
+        .def_readonly("bollinger", &indicators::IndicatorValidity::bollinger)
+        .def_readonly("atr", &indicators::IndicatorValidity::atr)
+        .def_readonly("obv", &indicators::IndicatorValidity::obv)
+        .def_readonly("vwap", &indicators::IndicatorValidity::vwap)
+        .def_readonly("mfi", &indicators::IndicatorValidity::mfi)
+        .def_readonly("volume_sma", &indicators::IndicatorValidity::volume_sma)
+        .def_readonly("moving_averages", &indicators::IndicatorValidity::moving_averages);
+    
+    py::class_<indicators::ComputedValues>(m, "ComputedValues")
+        .def_readonly("status", &indicators::ComputedValues::status)
+        .def_readonly("values", &indicators::ComputedValues::values)
+        .def_readonly("valid", &indicators::ComputedValues::valid)
+        .def_readonly("required_bars", &indicators::ComputedValues::required_bars)
+        .def("ok", &indicators::ComputedValues::ok);
+    
+    py::class_<indicators::ResultValidity>(m, "ResultValidity")
+        .def_readonly("rsi", &indicators::ResultValidity::rsi)
+        .def_readonly("macd", &indicators::ResultValidity::macd)
+        .def_readonly("bollinger", &indicators::ResultValidity::bollinger)
+        .def_readonly("sma_20", &indicators::ResultValidity::sma_20)
+        .def_readonly("sma_50", &indicators::ResultValidity::sma_50)
+        .def_readonly("ema_12", &indicators::ResultValidity::ema_12)
+        .def_readonly("ema_26", &indicators::ResultValidity::ema_26)
+        .def_readonly("atr", &indicators::ResultValidity::atr);
+    
+    py::class_<indicators::ComputedResults>(m, "ComputedResults")
+        .def_readonly("status", &indicators::ComputedResults::status)
+        .def_readonly("results", &indicators::ComputedResults::results)
+        .def_readonly("valid", &indicators::ComputedResults::valid)
+        .def_readonly("required_bars", &indicators::ComputedResults::required_bars)
+        .def("ok", &indicators::ComputedResults::ok);
+    
+    // Shared-memory bar ring
+    py::class_<indicators::SharedBarRing>(m, "SharedBarRing")
+        .def_static("create", &indicators::SharedBarRing::create,
+                    "Create or truncate a ring file and open it as the producer",
+                    py::arg("path"), py::arg("symbol"), py::arg("capacity"))
+        .def_static("open", &indicators::SharedBarRing::open,
+                    "Open an existing ring file read-only as a consumer",
+                    py::arg("path"))
+        .def("push", &indicators::SharedBarRing::push, "Append a bar", py::arg("bar"))
+        .def("update_last", &indicators::SharedBarRing::update_last,
+             "Replace the most recent bar", py::arg("bar"))
+        .def_property_readonly("writable", &indicators::SharedBarRing::writable)
+        .def_property_readonly("capacity", &indicators::SharedBarRing::capacity)
+        .def_property_readonly("symbol", &indicators::SharedBarRing::symbol)
+        .def_property_readonly("write_count", &indicators::SharedBarRing::write_count)
+        .def("read",
+             [](const indicators::SharedBarRing& ring, uint64_t index) {
+                 indicators::OHLC bar;
+                 switch (ring.read(index, bar)) {
+                     case indicators::SharedBarRing::ReadStatus::OK:
+                         break;
+                     case indicators::SharedBarRing::ReadStatus::NOT_WRITTEN:
+                         throw py::index_error("Bar " + std::to_string(index) + " has not been written");
+                     case indicators::SharedBarRing::ReadStatus::OVERWRITTEN:
+                         throw py::index_error("Bar " + std::to_string(index) + " has been overwritten");
+                     case indicators::SharedBarRing::ReadStatus::BUSY:
+                         throw std::runtime_error("Bar " + std::to_string(index) +
+                                                  " is still being written; the producer may have stopped");
+                 }
+                 return bar;
+             },
+             "Bar by its push index", py::arg("index"))
+        .def("read_recent",
+             [](const indicators::SharedBarRing& ring, size_t count) {
+                 indicators::BarSeries series;
+                 {
+                     py::gil_scoped_release release;
+                     ring.read_recent(count, series);
+                 }
+                 return series;
+             },
+             "Copy the most recent bars into a new BarSeries, oldest first",
+             py::arg("count"));
+    
+    // Memory-mapped historical bar cache
+    py::class_<indicators::BarCache>(m, "BarCache")
+        .def_static("write",
+                    [](const std::string& path, const std::string& symbol,
+                       indicators::PriceView high, indicators::PriceView low,
+                       indicators::PriceView close, indicators::ArrayView<int64_t> timestamp,
+                       indicators::PriceView open, indicators::ArrayView<int64_t> volume,
+                       std::optional<int64_t> covered_start, std::optional<int64_t> covered_end) {
+                        indicators::BarColumns bars{open, high, low, close, volume, timestamp};
+                        if (!covered_start && !covered_end) {
+                            indicators::BarCache::write(path, symbol, bars);
+                            return;
+                        }
+                        if (!covered_start || !covered_end) {
+                            throw py::value_error("covered_start and covered_end go together");
+                        }
+                        indicators::BarCache::write(path, symbol, bars, *covered_start, *covered_end);
+                    },
+                    "Write bar columns to a cache file; open and volume may be empty",
+                    py::arg("path"), py::arg("symbol"), py::arg("high"), py::arg("low"),
+                    py::arg("close"), py::arg("timestamp"),
+                    py::arg("open") = std::vector<double>(),
+                    py::arg("volume") = std::vector<int64_t>(),
+                    py::arg("covered_start") = py::none(), py::arg("covered_end") = py::none(),
+                    py::call_guard<py::gil_scoped_release>())
+        .def_static("write",
+                    py::overload_cast<const std::string&, const std::string&,
+                                      const indicators::BarSeries&>(&indicators::BarCache::write),
+                    "Write a BarSeries to a cache file",
+                    py::arg("path"), py::arg("symbol"), py::arg("bars"),
+                    py::call_guard<py::gil_scoped_release>())
+        .def_static("open", &indicators::BarCache::open,
+                    "Map an existing cache file read-only", py::arg("path"))
+        .def("__len__", &indicators::BarCache::size)
+        .def_property_readonly("symbol", &indicators::BarCache::symbol)
+        .def_property_readonly("covered_start", &indicators::BarCache::covered_start)
+        .def_property_readonly("covered_end", &indicators::BarCache::covered_end)
+        .def("covers", &indicators::BarCache::covers,
+             "Whether the file holds every bar of [start, end)",
+             py::arg("start"), py::arg("end"))
+        .def("lower_bound", &indicators::BarCache::lower_bound,
+             "Index of the first bar at or after a timestamp", py::arg("timestamp"))
+        .def("columns",
+             [](py::object self) {
+                 return cache_columns(self.cast<const indicators::BarCache&>().columns(), self);
+             },
+             "Read-only NumPy views over every column, without copying")
+        .def("range",
+             [](py::object self, int64_t start, int64_t end) {
+                 return cache_columns(self.cast<const indicators::BarCache&>().range(start, end), self);
+             },
+             "Read-only NumPy views over the bars with start <= timestamp < end",
+             py::arg("start"), py::arg("end"));
+    
+    // Binary result encoding
+    py::class_<indicators::ResultRecord>(m, "ResultRecord")
+        .def(py::init<>())
+        .def(py::init([](const std::string& symbol, int64_t timestamp,
+                         const indicators::IndicatorResults& results,
+                         const indicators::TechnicalSignals* signals) {
+                 indicators::ResultRecord record;
+                 record.symbol = symbol;
+                 record.timestamp = timestamp;
+                 record.indicators = results;
+                 record.has_signals = signals != nullptr;
+                 if (signals) {
+                     record.signals = *signals;
+                 }
+                 return record;
+             }),
+             py::arg("symbol"), py::arg("timestamp"), py::arg("indicators"),
+             py::arg("signals") = nullptr)
+        .def_readwrite("symbol", &indicators::ResultRecord::symbol)
+        .def_readwrite("timestamp", &indicators::ResultRecord::timestamp)
+        .def_readwrite("indicators", &indicators::ResultRecord::indicators)
+        .def_readwrite("signals", &indicators::ResultRecord::signals)
+        .def_readwrite("has_signals", &indicators::ResultRecord::has_signals);
+    
+    m.def("encode_results",
+          [](const std::vector<indicators::ResultRecord>& records) {
+              std::vector<unsigned char> encoded = indicators::encode_results(records);
+              return py::bytes(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+          },
+          "Encode records as one versioned little-endian binary batch",
+          py::arg("records"));
+    
+    py::class_<PyResultBatch>(m, "ResultBatch")
+        .def(py::init<const py::buffer&>(), py::arg("data"),
+             "Validate an encoded batch and read its records in place")
+        .def("__len__", [](const PyResultBatch& batch) { return batch.view.size(); })
+        .def("__getitem__",
+             [](const PyResultBatch& batch, size_t i) { return batch.view.at(i).to_record(); },
+             py::arg("index"))
+        .def("symbol",
+             [](const PyResultBatch& batch, size_t i) { return batch.view.at(i).symbol(); },
+             py::arg("index"))
+        .def("as_array",
+             [](py::object self) {
+                 // Read-only structured NumPy view over the encoded records. The
+                 // array keeps the batch, and with it the buffer export, alive.
+                 const PyResultBatch& batch = self.cast<const PyResultBatch&>();
+                 namespace codec = indicators::result_codec;
+                 py::list names, formats, offsets;
+                 auto field = [&](const char* name, const char* format, size_t offset) {
+                     names.append(name);
+                     formats.append(format);
+                     offsets.append(offset);
+                 };
+                 static const char* const values[codec::kValueCount] = {
+                     "rsi", "macd_line", "signal_line", "histogram", "bb_upper", "bb_middle",
+                     "bb_lower", "sma_20", "sma_50", "ema_12", "ema_26", "atr"};
+                 field("symbol", "S16", 0);
+                 field("timestamp", "<i8", 16);
+                 for (size_t i = 0; i < codec::kValueCount; ++i) {
+                     field(values[i], "<f8", codec::kValuesOffset + 8 * i);
+                 }
+                 field("rsi_signal", "u1", codec::kSignalsOffset);
+                 field("macd_signal", "u1", codec::kSignalsOffset + 1);
+                 field("bb_signal", "u1", codec::kSignalsOffset + 2);
+                 field("flags", "u1", codec::kFlagsOffset);
+                 py::dict spec;
+                 spec["names"] = names;
+                 spec["formats"] = formats;
+                 spec["offsets"] = offsets;
+                 spec["itemsize"] = batch.view.record_size();
+                 py::dtype dtype = py::dtype::from_args(spec);
+                 
+                 py::array array(dtype,
+                                 {static_cast<py::ssize_t>(batch.view.size())},
+                                 {static_cast<py::ssize_t>(batch.view.record_size())},
+                                 batch.view.records(),
+                                 self);
+                 array.attr("flags").attr("writeable") = false;
+                 return array;
+             },
+             "Structured NumPy array over the records, without copying");
+    
     // SignalType enum
     py::enum_<indicators::SignalType>(m, "SignalType")
         .value("OVERBOUGHT", indicators::SignalType::OVERBOUGHT)
@@ -61,6 +688,42 @@ PYBIND11_MODULE(indicators_engine, m) {
         .value("NEUTRAL", indicators::SignalType::NEUTRAL)
         .export_values();
     
+    // SIMD kernel selection
+    py::enum_<indicators::simd::InstructionSet>(m, "InstructionSet")
+        .value("SCALAR", indicators::simd::InstructionSet::SCALAR)
+        .value("AVX2", indicators::simd::InstructionSet::AVX2)
+        .value("AVX512", indicators::simd::InstructionSet::AVX512)
+        .value("NEON", indicators::simd::InstructionSet::NEON);
+    
+    m.def("active_instruction_set", &indicators::simd::active_instruction_set,
+          "Instruction set used by the vectorized kernels");
+    m.def("set_instruction_set", &indicators::simd::set_instruction_set,
+          "Select the instruction set used by the vectorized kernels",
+          py::arg("isa"));
+    m.def("is_instruction_set_supported", &indicators::simd::is_supported,
+          "Whether the CPU supports an instruction set",
+          py::arg("isa"));
+    
+    // Hot-path instrumentation
+    py::class_<indicators::profiling::ProbeStats>(m, "ProbeStats")
+        .def_readonly("name", &indicators::profiling::ProbeStats::name)
+        .def_readonly("calls", &indicators::profiling::ProbeStats::calls)
+        .def_readonly("bars", &indicators::profiling::ProbeStats::bars)
+        .def_readonly("allocations", &indicators::profiling::ProbeStats::allocations)
+        .def_readonly("heap_allocations", &indicators::profiling::ProbeStats::heap_allocations)
+        .def_readonly("total_ns", &indicators::profiling::ProbeStats::total_ns)
+        .def_readonly("mean_ns", &indicators::profiling::ProbeStats::mean_ns)
+        .def_readonly("p50_ns", &indicators::profiling::ProbeStats::p50_ns)
+        .def_readonly("p99_ns", &indicators::profiling::ProbeStats::p99_ns)
+        .def_readonly("max_ns", &indicators::profiling::ProbeStats::max_ns);
+    
+    m.def("profiling_enabled", &indicators::profiling::enabled,
+          "Whether the module was built with INDICATORS_ENABLE_PROFILING");
+    m.def("profiling_snapshot", &indicators::profiling::snapshot,
+          "Per-probe timers and counters since the last reset (empty when compiled out)");
+    m.def("reset_profiling", &indicators::profiling::reset,
+          "Restart the profiling counters from zero");
+    
     // TechnicalSignals structure
     py::class_<indicators::TechnicalSignals>(m, "TechnicalSignals")
         .def(py::init<>())
@@ -68,13 +731,455 @@ PYBIND11_MODULE(indicators_engine, m) {
         .def_readwrite("macd_signal", &indicators::TechnicalSignals::macd_signal)
         .def_readwrite("bb_signal", &indicators::TechnicalSignals::bb_signal);
     
+    py::class_<indicators::IndicatorAnalysis>(m, "IndicatorAnalysis")
+        .def_readonly("indicators", &indicators::IndicatorAnalysis::indicators)
+        .def_readonly("signals", &indicators::IndicatorAnalysis::signals);
+    
+    // Per-symbol cache of the latest analysis
+    py::class_<indicators::ResultCache>(m, "ResultCache")
+        .def(py::init<size_t>(), py::arg("shards") = 16)
+        .def("lookup",
+             [](const indicators::ResultCache& cache, const std::string& symbol, size_t bar_count,
+                const indicators::OHLC& last_bar) -> std::optional<indicators::IndicatorAnalysis> {
+                 indicators::IndicatorAnalysis analysis;
+                 if (!cache.lookup(symbol, indicators::ResultKey{bar_count, last_bar}, analysis)) {
+                     return std::nullopt;
+                 }
+                 return analysis;
+             },
+             "Cached analysis for these bars, or None",
+             py::arg("symbol"), py::arg("bar_count"), py::arg("last_bar"))
+        .def("invalidate", &indicators::ResultCache::invalidate, py::arg("symbol"))
+        .def("clear", &indicators::ResultCache::clear)
+        .def("__len__", &indicators::ResultCache::size)
+        .def_property_readonly("hits", &indicators::ResultCache::hits)
+        .def_property_readonly("misses", &indicators::ResultCache::misses);
+    
+    py::class_<indicators::VolumeIndicators>(m, "VolumeIndicators")
+        .def_readonly("obv", &indicators::VolumeIndicators::obv)
+        .def_readonly("vwap", &indicators::VolumeIndicators::vwap)
+        .def_readonly("mfi", &indicators::VolumeIndicators::mfi)
+        .def_readonly("volume_sma", &indicators::VolumeIndicators::volume_sma);
+    
+    // IncrementalIndicatorState class
+    py::class_<indicators::IncrementalIndicatorState>(m, "IncrementalIndicatorState")
+        .def(py::init<int64_t, int64_t>(),
+             py::arg("vwap_session_seconds") = 86400, py::arg("vwap_session_offset") = 0)
+        .def("push_bar", &indicators::IncrementalIndicatorState::push_bar,
+             "Append a new bar and advance all indicators",
+             py::arg("bar"))
+        .def("update_last_bar", &indicators::IncrementalIndicatorState::update_last_bar,
+             "Revise the most recent bar in place",
+             py::arg("bar"))
+        .def("apply_tick", &indicators::IncrementalIndicatorState::apply_tick,
+             "Fold one trade into the forming bar and revise it",
+             py::arg("price"), py::arg("volume") = 0)
+        .def("ready", &indicators::IncrementalIndicatorState::ready,
+             "Whether enough bars have been pushed to produce results")
+        .def("bar_count", &indicators::IncrementalIndicatorState::bar_count,
+             "Number of bars pushed so far")
+        .def("last_bar", &indicators::IncrementalIndicatorState::last_bar,
+             "Most recent bar")
+        .def("results", &indicators::IncrementalIndicatorState::results,
+             "Current indicator values")
+        .def("volume_indicators", &indicators::IncrementalIndicatorState::volume_indicators,
+             "Current OBV, session VWAP, MFI(14) and volume SMA(20)")
+        .def("snapshot",
+             [](const indicators::IncrementalIndicatorState& state) {
+                 std::vector<unsigned char> encoded = indicators::encode_state(state);
+                 return py::bytes(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+             },
+             "Encode the whole state as a versioned little-endian binary snapshot")
+        .def_static("restore",
+             [](const py::buffer& data) {
+                 py::buffer_info info = data.request();
+                 if (info.ndim != 1 || info.strides[0] != info.itemsize) {
+                     throw std::invalid_argument("State snapshot must be a contiguous one-dimensional buffer");
+                 }
+                 return indicators::decode_state(info.ptr, static_cast<size_t>(info.size * info.itemsize));
+             },
+             "Rebuild a state from snapshot(); raises ValueError for a snapshot of another "
+             "version or layout, or a truncated or corrupted one",
+             py::arg("data"));
+    
+    py::class_<indicators::PublishedState>(m, "PublishedState")
+        .def_readonly("version", &indicators::PublishedState::version)
+        .def_readonly("bar_count", &indicators::PublishedState::bar_count)
+        .def_readonly("ready", &indicators::PublishedState::ready)
+        .def_readonly("last_bar", &indicators::PublishedState::last_bar)
+        .def_readonly("results", &indicators::PublishedState::results)
+        .def_readonly("volume", &indicators::PublishedState::volume);
+    
+    // Per-symbol streaming states shared across threads
+    py::class_<indicators::StateRegistry>(m, "StateRegistry")
+        .def(py::init<size_t, int64_t, int64_t>(),
+             py::arg("capacity") = 4096, py::arg("vwap_session_seconds") = 86400,
+             py::arg("vwap_session_offset") = 0)
+        .def("push_bar", &indicators::StateRegistry::push_bar,
+             "Append a bar to the symbol's state, creating it on first use",
+             py::arg("symbol"), py::arg("bar"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("update_last_bar", &indicators::StateRegistry::update_last_bar,
+             "Revise the symbol's most recent bar in place",
+             py::arg("symbol"), py::arg("bar"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("apply_tick", &indicators::StateRegistry::apply_tick,
+             "Fold one trade into the symbol's forming bar",
+             py::arg("symbol"), py::arg("price"), py::arg("volume") = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("read",
+             [](const indicators::StateRegistry& registry,
+                const std::string& symbol) -> std::optional<indicators::PublishedState> {
+                 indicators::PublishedState state;
+                 bool found;
+                 {
+                     py::gil_scoped_release release;
+                     found = registry.read(symbol, state);
+                 }
+                 if (!found) {
+                     return std::nullopt;
+                 }
+                 return state;
+             },
+             "Latest published state of the symbol, or None",
+             py::arg("symbol"))
+        .def("snapshot",
+             [](const indicators::StateRegistry& registry, const std::string& symbol) {
+                 std::vector<unsigned char> encoded;
+                 {
+                     py::gil_scoped_release release;
+                     encoded = registry.snapshot(symbol);
+                 }
+                 return py::bytes(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+             },
+             "Binary snapshot of the symbol's state, as IncrementalIndicatorState.snapshot()",
+             py::arg("symbol"))
+        .def("restore",
+             [](indicators::StateRegistry& registry, const std::string& symbol, const py::buffer& data) {
+                 py::buffer_info info = data.request();
+                 if (info.ndim != 1 || info.strides[0] != info.itemsize) {
+                     throw std::invalid_argument("State snapshot must be a contiguous one-dimensional buffer");
+                 }
+                 indicators::IncrementalIndicatorState state =
+                     indicators::decode_state(info.ptr, static_cast<size_t>(info.size * info.itemsize));
+                 py::gil_scoped_release release;
+                 registry.restore(symbol, state);
+             },
+             "Replace the symbol's state with a decoded snapshot",
+             py::arg("symbol"), py::arg("data"))
+        .def("__contains__", &indicators::StateRegistry::contains)
+        .def("__len__", &indicators::StateRegistry::size)
+        .def_property_readonly("capacity", &indicators::StateRegistry::capacity)
+        .def("symbols", &indicators::StateRegistry::symbols,
+             "Registered symbols, in no particular order");
+    
+    // Multi-timeframe aggregation
+    py::class_<indicators::BarAggregator>(m, "BarAggregator")
+        .def(py::init<std::vector<int64_t>, int64_t>(),
+             "Aggregate one bar feed into the given timeframes (seconds)",
+             py::arg("timeframes"), py::arg("offset_seconds") = 0)
+        .def("push_bar", &indicators::BarAggregator::push_bar,
+             "Feed the next base bar; returns the indices of the timeframes it closed",
+             py::arg("bar"))
+        .def("update_last_bar", &indicators::BarAggregator::update_last_bar,
+             "Revise the most recent base bar", py::arg("bar"))
+        .def("push_tick", &indicators::BarAggregator::push_tick,
+             "Feed one trade as a base bar; returns the indices of the timeframes it closed",
+             py::arg("timestamp"), py::arg("price"), py::arg("volume"))
+        .def_property_readonly("timeframe_count", &indicators::BarAggregator::timeframe_count)
+        .def_property_readonly("base_bar_count", &indicators::BarAggregator::base_bar_count)
+        .def("timeframe", &indicators::BarAggregator::timeframe, py::arg("index"))
+        .def("index_of", &indicators::BarAggregator::index_of, py::arg("timeframe"))
+        .def("state", &indicators::BarAggregator::state,
+             py::return_value_policy::reference_internal,
+             "Indicator state of a timeframe", py::arg("index"))
+        .def("current_bar", &indicators::BarAggregator::current_bar,
+             "Forming bar of a timeframe", py::arg("index"))
+        .def("has_closed_bar", &indicators::BarAggregator::has_closed_bar, py::arg("index"))
+        .def("last_closed_bar", &indicators::BarAggregator::last_closed_bar,
+             "Most recently closed bar of a timeframe", py::arg("index"))
+        .def("closed_results", &indicators::BarAggregator::closed_results,
+             "Indicator values as of the last close of a timeframe", py::arg("index"));
+    
+    // Composite Market Score
+    py::enum_<indicators::RegimeType>(m, "RegimeType")
+        .value("TRENDING_UP", indicators::RegimeType::TRENDING_UP)
+        .value("TRENDING_DOWN", indicators::RegimeType::TRENDING_DOWN)
+        .value("RANGING", indicators::RegimeType::RANGING)
+        .value("VOLATILE", indicators::RegimeType::VOLATILE)
+        .value("CALM", indicators::RegimeType::CALM);
+    
+    py::class_<indicators::MarketContext>(m, "MarketContext")
+        .def(py::init<>())
+        .def(py::init([](double sentiment_score, indicators::RegimeType regime,
+                         double regime_confidence) {
+                 return indicators::MarketContext{sentiment_score, regime, regime_confidence};
+             }),
+             py::arg("sentiment_score"), py::arg("regime"), py::arg("regime_confidence"))
+        .def_readwrite("sentiment_score", &indicators::MarketContext::sentiment_score)
+        .def_readwrite("regime", &indicators::MarketContext::regime)
+        .def_readwrite("regime_confidence", &indicators::MarketContext::regime_confidence);
+    
+    py::class_<indicators::CompositeScore>(m, "CompositeScore")
+        .def_readonly("signals", &indicators::CompositeScore::signals)
+        .def_readonly("technical_score", &indicators::CompositeScore::technical_score)
+        .def_readonly("sentiment_component", &indicators::CompositeScore::sentiment_component)
+        .def_readonly("technical_component", &indicators::CompositeScore::technical_component)
+        .def_readonly("regime_component", &indicators::CompositeScore::regime_component)
+        .def_readonly("score", &indicators::CompositeScore::score);
+    
+    py::class_<indicators::CompositeScorer>(m, "CompositeScorer")
+        .def(py::init<double, double, double>(),
+             py::arg("weight_sentiment") = 0.3, py::arg("weight_technical") = 0.5,
+             py::arg("weight_regime") = 0.2)
+        .def_property_readonly("weight_sentiment", &indicators::CompositeScorer::weight_sentiment)
+        .def_property_readonly("weight_technical", &indicators::CompositeScorer::weight_technical)
+        .def_property_readonly("weight_regime", &indicators::CompositeScorer::weight_regime)
+        .def_static("technical_score", &indicators::CompositeScorer::technical_score,
+                    "Normalized technical score in [-1, 1]", py::arg("signals"))
+        .def_static("regime_score", &indicators::CompositeScorer::regime_score,
+                    "Normalized regime score in [-1, 1]",
+                    py::arg("regime"), py::arg("confidence"))
+        .def("score", &indicators::CompositeScorer::score,
+             "Signals, technical score and weighted CMS for one symbol",
+             py::arg("indicators"), py::arg("current_price"), py::arg("context"))
+        .def("score_batch", &indicators::CompositeScorer::score_batch,
+             "Score many symbols in one call (releases the GIL)",
+             py::arg("indicators"), py::arg("current_prices"), py::arg("contexts"),
+             py::call_guard<py::gil_scoped_release>());
+    
+    // Parameter-sweep backtesting
+    py::class_<indicators::StrategyParams>(m, "StrategyParams")
+        .def(py::init<>())
+        .def_readwrite("rsi_period", &indicators::StrategyParams::rsi_period)
+        .def_readwrite("rsi_overbought", &indicators::StrategyParams::rsi_overbought)
+        .def_readwrite("rsi_oversold", &indicators::StrategyParams::rsi_oversold)
+        .def_readwrite("macd_fast", &indicators::StrategyParams::macd_fast)
+        .def_readwrite("macd_slow", &indicators::StrategyParams::macd_slow)
+        .def_readwrite("macd_signal", &indicators::StrategyParams::macd_signal)
+        .def_readwrite("bollinger_period", &indicators::StrategyParams::bollinger_period)
+        .def_readwrite("bollinger_std_dev", &indicators::StrategyParams::bollinger_std_dev)
+        .def_readwrite("buy_threshold", &indicators::StrategyParams::buy_threshold)
+        .def_readwrite("sell_threshold", &indicators::StrategyParams::sell_threshold)
+        .def_readwrite("initial_capital", &indicators::StrategyParams::initial_capital)
+        .def_readwrite("position_size", &indicators::StrategyParams::position_size)
+        .def("validate", &indicators::StrategyParams::validate,
+             "Raise ValueError for an unusable configuration");
+    
+    py::class_<indicators::BacktestMetrics>(m, "BacktestMetrics")
+        .def_readonly("pnl", &indicators::BacktestMetrics::pnl)
+        .def_readonly("final_equity", &indicators::BacktestMetrics::final_equity)
+        .def_readonly("total_return", &indicators::BacktestMetrics::total_return)
+        .def_readonly("sharpe_ratio", &indicators::BacktestMetrics::sharpe_ratio)
+        .def_readonly("max_drawdown", &indicators::BacktestMetrics::max_drawdown)
+        .def_readonly("win_rate", &indicators::BacktestMetrics::win_rate)
+        .def_readonly("total_trades", &indicators::BacktestMetrics::total_trades);
+    
+    py::class_<indicators::Backtester>(m, "Backtester")
+        .def(py::init<>())
+        .def(py::init<size_t>(), py::arg("num_threads"),
+             "Create a backtester with a dedicated sweep thread pool")
+        .def("run",
+             [](indicators::Backtester& backtester, indicators::PriceView close,
+                const indicators::StrategyParams& params) {
+                 return backtester.run(close, params);
+             },
+             "Backtest one configuration on a close series",
+             py::arg("close"), py::arg("params"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("run_with_equity_curve",
+             [](indicators::Backtester& backtester, indicators::PriceView close,
+                const indicators::StrategyParams& params) {
+                 std::vector<double> equity;
+                 indicators::BacktestMetrics metrics;
+                 {
+                     py::gil_scoped_release release;
+                     metrics = backtester.run(close, params, &equity);
+                 }
+                 py::array_t<double> curve(static_cast<py::ssize_t>(equity.size()), equity.data());
+                 return py::make_tuple(metrics, curve);
+             },
+             "Backtest one configuration and also return its equity curve",
+             py::arg("close"), py::arg("params"))
+        .def("sweep", &indicators::Backtester::sweep,
+             "Backtest every configuration of a grid in parallel (releases the GIL)",
+             py::arg("close"), py::arg("grid"),
+             py::call_guard<py::gil_scoped_release>())
+        .def_static("sharpe_ratio", &indicators::Backtester::sharpe_ratio,
+                    "Annualized Sharpe ratio of an equity curve", py::arg("equity"))
+        .def_static("max_drawdown", &indicators::Backtester::max_drawdown,
+                    "Maximum drawdown of an equity curve as a fraction", py::arg("equity"));
+    
     // TechnicalIndicatorEngine class
     py::class_<indicators::TechnicalIndicatorEngine>(m, "TechnicalIndicatorEngine")
         .def(py::init<>())
-        .def("compute_indicators", &indicators::TechnicalIndicatorEngine::compute_indicators,
+        .def(py::init<size_t>(), py::arg("num_threads"),
+             "Create an engine with a dedicated batch thread pool")
+        .def("compute_indicators",
+             py::overload_cast<const indicators::PriceData&>(
+                 &indicators::TechnicalIndicatorEngine::compute_indicators),
              "Compute all technical indicators for given price data")
+        .def("compute_indicators",
+             py::overload_cast<const indicators::BarSeries&>(
+                 &indicators::TechnicalIndicatorEngine::compute_indicators),
+             "Compute all technical indicators directly from columnar bar storage",
+             py::arg("bars"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("compute_indicators",
+             py::overload_cast<const indicators::CompactBarSeries&>(
+                 &indicators::TechnicalIndicatorEngine::compute_indicators),
+             "Compute all technical indicators from float32 compact bar storage",
+             py::arg("bars"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("compute_indicators",
+             [](indicators::TechnicalIndicatorEngine& engine,
+                indicators::PriceView open,
+                indicators::PriceView high,
+                indicators::PriceView low,
+                indicators::PriceView close,
+                indicators::ArrayView<int64_t> volume,
+                indicators::ArrayView<int64_t> timestamp) {
+                 indicators::BarColumns bars{open, high, low, close, volume, timestamp};
+                 return engine.compute_indicators(bars);
+             },
+             "Compute all technical indicators from bar columns (NumPy arrays are read in place)",
+             py::arg("open"), py::arg("high"), py::arg("low"), py::arg("close"),
+             py::arg("volume"), py::arg("timestamp"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("compute_indicators",
+             [](indicators::TechnicalIndicatorEngine& engine, const indicators::BarCache& cache) {
+                 return engine.compute_indicators(cache.columns());
+             },
+             "Compute all technical indicators directly from a mapped bar cache",
+             py::arg("cache"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("compute_indicators",
+             py::overload_cast<const indicators::PriceData&, const indicators::IndicatorSpec&>(
+                 &indicators::TechnicalIndicatorEngine::compute_indicators),
+             "Compute the indicators selected by spec",
+             py::arg("prices"), py::arg("spec"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("compute_indicators",
+             py::overload_cast<const indicators::BarSeries&, const indicators::IndicatorSpec&>(
+                 &indicators::TechnicalIndicatorEngine::compute_indicators),
+             "Compute the indicators selected by spec from columnar bar storage",
+             py::arg("bars"), py::arg("spec"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("compute_indicators",
+             py::overload_cast<const indicators::CompactBarSeries&, const indicators::IndicatorSpec&>(
+                 &indicators::TechnicalIndicatorEngine::compute_indicators),
+             "Compute the indicators selected by spec from compact bar storage",
+             py::arg("bars"), py::arg("spec"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("compute_indicators",
+             [](indicators::TechnicalIndicatorEngine& engine,
+                indicators::PriceView open,
+                indicators::PriceView high,
+                indicators::PriceView low,
+                indicators::PriceView close,
+                indicators::ArrayView<int64_t> volume,
+                indicators::ArrayView<int64_t> timestamp,
+                const indicators::IndicatorSpec& spec) {
+                 indicators::BarColumns bars{open, high, low, close, volume, timestamp};
+                 return engine.compute_indicators(bars, spec);
+             },
+             "Compute the indicators selected by spec from bar columns",
+             py::arg("open"), py::arg("high"), py::arg("low"), py::arg("close"),
+             py::arg("volume"), py::arg("timestamp"), py::arg("spec"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("compute_indicators_batch", &indicators::TechnicalIndicatorEngine::compute_indicators_batch,
+             "Compute indicators for many symbols in parallel (releases the GIL)",
+             py::arg("batch"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("submit_indicators",
+             [](py::object self, indicators::PriceData prices, py::function callback) {
+                 self.cast<indicators::TechnicalIndicatorEngine&>().submit_indicators(
+                     std::move(prices), python_completion<indicators::IndicatorResults>(callback, self));
+             },
+             "Compute indicators on the engine's pool and return at once; "
+             "callback(results, error) runs on the worker thread when done",
+             py::arg("prices"), py::arg("callback"))
+        .def("submit_indicators_batch",
+             [](py::object self, std::vector<indicators::PriceData> batch, py::function callback) {
+                 self.cast<indicators::TechnicalIndicatorEngine&>().submit_indicators_batch(
+                     std::move(batch),
+                     python_completion<std::vector<indicators::IndicatorResults>>(callback, self));
+             },
+             "Compute a batch on the engine's pool and return at once; "
+             "callback(results, error) runs on a worker thread when done",
+             py::arg("batch"), py::arg("callback"))
+        .def("submit_analysis",
+             [](py::object self, indicators::PriceData prices, py::function callback) {
+                 self.cast<indicators::TechnicalIndicatorEngine&>().submit_analysis(
+                     std::move(prices), python_completion<indicators::IndicatorAnalysis>(callback, self));
+             },
+             "analyze() on the engine's pool; callback(analysis, error) runs on the "
+             "worker thread when done",
+             py::arg("prices"), py::arg("callback"))
+        .def("try_compute_indicators",
+             py::overload_cast<const indicators::PriceData&>(
+                 &indicators::TechnicalIndicatorEngine::try_compute_indicators),
+             "Compute what the bars allow without raising; see ComputedResults",
+             py::arg("prices"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("try_compute_indicators",
+             py::overload_cast<const indicators::BarSeries&>(
+                 &indicators::TechnicalIndicatorEngine::try_compute_indicators),
+             "Compute what the bars allow from columnar bar storage without raising",
+             py::arg("bars"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("try_compute_indicators",
+             [](indicators::TechnicalIndicatorEngine& engine,
+                indicators::PriceView open,
+                indicators::PriceView high,
+                indicators::PriceView low,
+                indicators::PriceView close,
+                indicators::ArrayView<int64_t> volume,
+                indicators::ArrayView<int64_t> timestamp) {
+                 indicators::BarColumns bars{open, high, low, close, volume, timestamp};
+                 return engine.try_compute_indicators(bars);
+             },
+             "Compute what the bar columns allow without raising",
+             py::arg("open"), py::arg("high"), py::arg("low"), py::arg("close"),
+             py::arg("volume"), py::arg("timestamp"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("try_compute_indicators",
+             py::overload_cast<const indicators::PriceData&, const indicators::IndicatorSpec&>(
+                 &indicators::TechnicalIndicatorEngine::try_compute_indicators),
+             "Compute what the bars allow of spec without raising; see ComputedValues",
+             py::arg("prices"), py::arg("spec"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("try_compute_indicators_batch",
+             &indicators::TechnicalIndicatorEngine::try_compute_indicators_batch,
+             "Non-throwing batch computation, one ComputedResults per symbol (releases the GIL)",
+             py::arg("batch"),
+             py::call_guard<py::gil_scoped_release>())
         .def("generate_signals", &indicators::TechnicalIndicatorEngine::generate_signals,
              "Generate trading signals based on indicator values")
+        .def("analyze",
+             py::overload_cast<const indicators::PriceData&>(
+                 &indicators::TechnicalIndicatorEngine::analyze),
+             "Indicators and signals, served from the result cache while the bars are unchanged",
+             py::arg("prices"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("analyze",
+             [](indicators::TechnicalIndicatorEngine& engine,
+                const std::string& symbol,
+                indicators::PriceView open,
+                indicators::PriceView high,
+                indicators::PriceView low,
+                indicators::PriceView close,
+                indicators::ArrayView<int64_t> volume,
+                indicators::ArrayView<int64_t> timestamp) {
+                 indicators::BarColumns bars{open, high, low, close, volume, timestamp};
+                 return engine.analyze(symbol, bars);
+             },
+             "Indicators and signals from bar columns, served from the result cache",
+             py::arg("symbol"), py::arg("open"), py::arg("high"), py::arg("low"),
+             py::arg("close"), py::arg("volume"), py::arg("timestamp"),
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("result_cache", &indicators::TechnicalIndicatorEngine::result_cache,
+                               py::return_value_policy::reference_internal)
         .def("compute_rsi", &indicators::TechnicalIndicatorEngine::compute_rsi,
              "Compute Relative Strength Index",
              py::arg("prices"), py::arg("period") = 14)
@@ -82,6 +1187,12 @@ PYBIND11_MODULE(indicators_engine, m) {
              "Compute MACD indicator",
              py::arg("prices"), py::arg("fast_period") = 12, 
              py::arg("slow_period") = 26, py::arg("signal_period") = 9)
+        .def("compute_macd_series",
+             py::overload_cast<indicators::PriceView, int, int, int>(
+                 &indicators::TechnicalIndicatorEngine::compute_macd_series),
+             "Compute full MACD line, signal line and histogram series",
+             py::arg("prices"), py::arg("fast_period") = 12,
+             py::arg("slow_period") = 26, py::arg("signal_period") = 9)
         .def("compute_bollinger_bands", &indicators::TechnicalIndicatorEngine::compute_bollinger_bands,
              "Compute Bollinger Bands",
              py::arg("prices"), py::arg("period") = 20, py::arg("std_dev") = 2.0)
@@ -91,7 +1202,178 @@ PYBIND11_MODULE(indicators_engine, m) {
         .def("compute_ema", &indicators::TechnicalIndicatorEngine::compute_ema,
              "Compute Exponential Moving Average",
              py::arg("prices"), py::arg("period"))
-        .def("compute_atr", &indicators::TechnicalIndicatorEngine::compute_atr,
+        .def("compute_atr",
+             py::overload_cast<const std::vector<indicators::OHLC>&, int>(
+                 &indicators::TechnicalIndicatorEngine::compute_atr),
              "Compute Average True Range",
-             py::arg("bars"), py::arg("period") = 14);
+             py::arg("bars"), py::arg("period") = 14)
+        .def("compute_atr",
+             py::overload_cast<indicators::PriceView, indicators::PriceView, indicators::PriceView, int>(
+                 &indicators::TechnicalIndicatorEngine::compute_atr),
+             "Compute Average True Range from high, low and close columns",
+             py::arg("high"), py::arg("low"), py::arg("close"), py::arg("period") = 14)
+        .def("compute_obv", &indicators::TechnicalIndicatorEngine::compute_obv,
+             "Compute On-Balance Volume",
+             py::arg("close"), py::arg("volume"))
+        .def("compute_vwap", &indicators::TechnicalIndicatorEngine::compute_vwap,
+             "Compute the VWAP of the last bar's session; timestamp may be empty",
+             py::arg("high"), py::arg("low"), py::arg("close"), py::arg("volume"),
+             py::arg("timestamp") = std::vector<int64_t>(),
+             py::arg("session_seconds") = 86400, py::arg("session_offset") = 0)
+        .def("compute_mfi", &indicators::TechnicalIndicatorEngine::compute_mfi,
+             "Compute the Money Flow Index",
+             py::arg("high"), py::arg("low"), py::arg("close"), py::arg("volume"),
+             py::arg("period") = 14)
+        .def("compute_volume_sma", &indicators::TechnicalIndicatorEngine::compute_volume_sma,
+             "Compute the Simple Moving Average of volume",
+             py::arg("volume"), py::arg("period") = 20)
+        .def("compute_sma_series",
+             [](indicators::TechnicalIndicatorEngine& engine, indicators::PriceView prices, int period) {
+                 indicators::SeriesBuffer out;
+                 py::array_t<double> result = new_series(prices.size(), out);
+                 {
+                     py::gil_scoped_release release;
+                     engine.compute_sma_series(prices, out, period);
+                 }
+                 return result;
+             },
+             "Compute the Simple Moving Average for every bar",
+             py::arg("prices"), py::arg("period"))
+        .def("compute_ema_series",
+             [](indicators::TechnicalIndicatorEngine& engine, indicators::PriceView prices, int period) {
+                 indicators::SeriesBuffer out;
+                 py::array_t<double> result = new_series(prices.size(), out);
+                 {
+                     py::gil_scoped_release release;
+                     engine.compute_ema_series(prices, out, period);
+                 }
+                 return result;
+             },
+             "Compute the Exponential Moving Average for every bar",
+             py::arg("prices"), py::arg("period"))
+        .def("compute_rsi_series",
+             [](indicators::TechnicalIndicatorEngine& engine, indicators::PriceView prices, int period) {
+                 indicators::SeriesBuffer out;
+                 py::array_t<double> result = new_series(prices.size(), out);
+                 {
+                     py::gil_scoped_release release;
+                     engine.compute_rsi_series(prices, out, period);
+                 }
+                 return result;
+             },
+             "Compute the Relative Strength Index for every bar",
+             py::arg("prices"), py::arg("period") = 14)
+        .def("compute_bollinger_series",
+             [](indicators::TechnicalIndicatorEngine& engine, indicators::PriceView prices,
+                int period, double std_dev) {
+                 indicators::SeriesBuffer upper, middle, lower;
+                 py::array_t<double> upper_array = new_series(prices.size(), upper);
+                 py::array_t<double> middle_array = new_series(prices.size(), middle);
+                 py::array_t<double> lower_array = new_series(prices.size(), lower);
+                 {
+                     py::gil_scoped_release release;
+                     engine.compute_bollinger_series(prices, upper, middle, lower, period, std_dev);
+                 }
+                 return py::make_tuple(upper_array, middle_array, lower_array);
+             },
+             "Compute Bollinger Bands for every bar as (upper, middle, lower) arrays",
+             py::arg("prices"), py::arg("period") = 20, py::arg("std_dev") = 2.0)
+        .def("compute_atr_series",
+             [](indicators::TechnicalIndicatorEngine& engine, indicators::PriceView high,
+                indicators::PriceView low, indicators::PriceView close, int period) {
+                 indicators::SeriesBuffer out;
+                 py::array_t<double> result = new_series(close.size(), out);
+                 {
+                     py::gil_scoped_release release;
+                     engine.compute_atr_series(high, low, close, out, period);
+                 }
+                 return result;
+             },
+             "Compute the Average True Range for every bar",
+             py::arg("high"), py::arg("low"), py::arg("close"), py::arg("period") = 14)
+        .def("compute_obv_series",
+             [](indicators::TechnicalIndicatorEngine& engine, indicators::PriceView close,
+                indicators::ArrayView<int64_t> volume) {
+                 indicators::SeriesBuffer out;
+                 py::array_t<double> result = new_series(close.size(), out);
+                 {
+                     py::gil_scoped_release release;
+                     engine.compute_obv_series(close, volume, out);
+                 }
+                 return result;
+             },
+             "Compute On-Balance Volume for every bar",
+             py::arg("close"), py::arg("volume"))
+        .def("compute_vwap_series",
+             [](indicators::TechnicalIndicatorEngine& engine, indicators::PriceView high,
+                indicators::PriceView low, indicators::PriceView close,
+                indicators::ArrayView<int64_t> volume, indicators::ArrayView<int64_t> timestamp,
+                int64_t session_seconds, int64_t session_offset) {
+                 indicators::SeriesBuffer out;
+                 py::array_t<double> result = new_series(close.size(), out);
+                 {
+                     py::gil_scoped_release release;
+                     engine.compute_vwap_series(high, low, close, volume, timestamp, out,
+                                                session_seconds, session_offset);
+                 }
+                 return result;
+             },
+             "Compute the session-anchored VWAP for every bar; timestamp may be empty",
+             py::arg("high"), py::arg("low"), py::arg("close"), py::arg("volume"),
+             py::arg("timestamp") = std::vector<int64_t>(),
+             py::arg("session_seconds") = 86400, py::arg("session_offset") = 0)
+        .def("compute_mfi_series",
+             [](indicators::TechnicalIndicatorEngine& engine, indicators::PriceView high,
+                indicators::PriceView low, indicators::PriceView close,
+                indicators::ArrayView<int64_t> volume, int period) {
+                 indicators::SeriesBuffer out;
+                 py::array_t<double> result = new_series(close.size(), out);
+                 {
+                     py::gil_scoped_release release;
+                     engine.compute_mfi_series(high, low, close, volume, out, period);
+                 }
+                 return result;
+             },
+             "Compute the Money Flow Index for every bar",
+             py::arg("high"), py::arg("low"), py::arg("close"), py::arg("volume"),
+             py::arg("period") = 14)
+        .def("compute_volume_sma_series",
+             [](indicators::TechnicalIndicatorEngine& engine,
+                indicators::ArrayView<int64_t> volume, int period) {
+                 indicators::SeriesBuffer out;
+                 py::array_t<double> result = new_series(volume.size(), out);
+                 {
+                     py::gil_scoped_release release;
+                     engine.compute_volume_sma_series(volume, out, period);
+                 }
+                 return result;
+             },
+             "Compute the Simple Moving Average of volume for every bar",
+             py::arg("volume"), py::arg("period") = 20)
+        .def("compute_ema_cross_section",
+             [](indicators::TechnicalIndicatorEngine& engine, const py::object& closes,
+                int period, bool full_series) {
+                 return dispatch_cross_section(closes, full_series,
+                                               [&](const auto& matrix, auto last, auto series) {
+                     engine.compute_ema_cross_section(matrix, last, period, series);
+                 });
+             },
+             "EMA of every symbol in a (symbols, bars) matrix of closes, vectorized "
+             "across symbols: the last value per symbol, or the whole (symbols, bars) "
+             "history with full_series (releases the GIL). float32 closes are computed "
+             "and returned in float32.",
+             py::arg("closes"), py::arg("period"), py::arg("full_series") = false)
+        .def("compute_rsi_cross_section",
+             [](indicators::TechnicalIndicatorEngine& engine, const py::object& closes,
+                int period, bool full_series) {
+                 return dispatch_cross_section(closes, full_series,
+                                               [&](const auto& matrix, auto last, auto series) {
+                     engine.compute_rsi_cross_section(matrix, last, period, series);
+                 });
+             },
+             "RSI of every symbol in a (symbols, bars) matrix of closes, vectorized "
+             "across symbols: the last value per symbol, or the whole (symbols, bars) "
+             "history with full_series (releases the GIL). float32 closes are computed "
+             "and returned in float32.",
+             py::arg("closes"), py::arg("period") = 14, py::arg("full_series") = false);
 }
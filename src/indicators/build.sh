@@ -9,8 +9,9 @@ echo "Building C++ Technical Indicator Engine..."
 mkdir -p build
 cd build
 
-# Configure with CMake
-cmake ..
+# Configure with CMake; extra arguments are passed on, e.g.
+# ./build.sh -DINDICATORS_ENABLE_LTO=ON
+cmake .. "$@"
 
 # Build
 cmake --build . --config Release
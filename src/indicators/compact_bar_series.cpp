@@ -0,0 +1,176 @@
+#include "compact_bar_series.h"
+#include "scratch_arena.h"
+#include <limits>
+
+namespace indicators {
+
+namespace {
+
+uint32_t encode_volume(int64_t volume) {
+    if (volume < 0 || volume > std::numeric_limits<uint32_t>::max()) {
+        throw std::out_of_range("Volume out of range for compact storage");
+    }
+    return static_cast<uint32_t>(volume);
+}
+
+} // namespace
+
+CompactBarSeries CompactBarSeries::from_bars(const std::vector<OHLC>& bars) {
+    CompactBarSeries series;
+    series.reserve(bars.size());
+    for (const auto& bar : bars) {
+        series.append(bar);
+    }
+    return series;
+}
+
+// open, volume and timestamp may be empty, as in any BarColumns
+CompactBarSeries CompactBarSeries::from_columns(const BarColumns& bars) {
+    const size_t n = bars.size();
+    if (bars.high.size() != n || bars.low.size() != n ||
+        (bars.open.size() != 0 && bars.open.size() != n) ||
+        (bars.volume.size() != 0 && bars.volume.size() != n) ||
+        (bars.timestamp.size() != 0 && bars.timestamp.size() != n)) {
+        throw std::invalid_argument("Bar column lengths do not match");
+    }
+    
+    CompactBarSeries series;
+    series.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        series.append(bars.open.size() != 0 ? bars.open[i] : bars.close[i],
+                      bars.high[i], bars.low[i], bars.close[i],
+                      bars.volume.size() != 0 ? bars.volume[i] : 0,
+                      bars.timestamp.size() != 0 ? bars.timestamp[i] : 0);
+    }
+    return series;
+}
+
+void CompactBarSeries::reserve(size_t bars) {
+    open_.reserve(bars);
+    high_.reserve(bars);
+    low_.reserve(bars);
+    close_.reserve(bars);
+    volume_.reserve(bars);
+    time_offset_.reserve(bars);
+}
+
+int32_t CompactBarSeries::encode_timestamp(int64_t timestamp) const {
+    const int64_t offset = timestamp - base_timestamp_;
+    if (offset < std::numeric_limits<int32_t>::min() ||
+        offset > std::numeric_limits<int32_t>::max()) {
+        throw std::out_of_range("Timestamp too far from the first bar for compact storage");
+    }
+    return static_cast<int32_t>(offset);
+}
+
+void CompactBarSeries::append(const OHLC& bar) {
+    append(bar.open, bar.high, bar.low, bar.close, bar.volume, bar.timestamp);
+}
+
+void CompactBarSeries::append(double open, double high, double low, double close,
+                              int64_t volume, int64_t timestamp) {
+    // Encode first so a rejected bar leaves the series unchanged
+    const uint32_t packed_volume = encode_volume(volume);
+    if (empty()) {
+        base_timestamp_ = timestamp;
+    }
+    const int32_t offset = encode_timestamp(timestamp);
+    
+    open_.push_back(static_cast<float>(open));
+    high_.push_back(static_cast<float>(high));
+    low_.push_back(static_cast<float>(low));
+    close_.push_back(static_cast<float>(close));
+    volume_.push_back(packed_volume);
+    time_offset_.push_back(offset);
+}
+
+void CompactBarSeries::update_last(const OHLC& bar) {
+    if (empty()) {
+        throw std::runtime_error("No bar to update");
+    }
+    const uint32_t packed_volume = encode_volume(bar.volume);
+    // A lone bar is its own base, so it may move to any timestamp
+    const bool rebase = size() == 1;
+    const int32_t offset = rebase ? 0 : encode_timestamp(bar.timestamp);
+    if (rebase) {
+        base_timestamp_ = bar.timestamp;
+    }
+    
+    size_t last = size() - 1;
+    open_[last] = static_cast<float>(bar.open);
+    high_[last] = static_cast<float>(bar.high);
+    low_[last] = static_cast<float>(bar.low);
+    close_[last] = static_cast<float>(bar.close);
+    volume_[last] = packed_volume;
+    time_offset_[last] = offset;
+}
+
+void CompactBarSeries::clear() {
+    open_.clear();
+    high_.clear();
+    low_.clear();
+    close_.clear();
+    volume_.clear();
+    time_offset_.clear();
+    base_timestamp_ = 0;
+}
+
+size_t CompactBarSeries::memory_bytes() const {
+    const size_t prices = open_.capacity() + high_.capacity() + low_.capacity() + close_.capacity();
+    return prices * sizeof(float) + volume_.capacity() * sizeof(uint32_t) +
+           time_offset_.capacity() * sizeof(int32_t);
+}
+
+int64_t CompactBarSeries::timestamp(size_t i) const {
+    if (i >= size()) {
+        throw std::out_of_range("Bar index out of range");
+    }
+    return base_timestamp_ + time_offset_[i];
+}
+
+OHLC CompactBarSeries::bar(size_t i) const {
+    if (i >= size()) {
+        throw std::out_of_range("Bar index out of range");
+    }
+    return OHLC{open_[i], high_[i], low_[i], close_[i],
+                static_cast<int64_t>(volume_[i]), base_timestamp_ + time_offset_[i]};
+}
+
+std::vector<OHLC> CompactBarSeries::to_bars() const {
+    std::vector<OHLC> bars;
+    bars.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        bars.push_back(bar(i));
+    }
+    return bars;
+}
+
+BarColumns CompactBarSeries::price_columns(ScratchArena& arena, bool with_volume) const {
+    const size_t n = size();
+    double* high = arena.allocate<double>(n);
+    double* low = arena.allocate<double>(n);
+    double* close = arena.allocate<double>(n);
+    for (size_t i = 0; i < n; ++i) {
+        high[i] = high_[i];
+        low[i] = low_[i];
+        close[i] = close_[i];
+    }
+    
+    BarColumns columns;
+    columns.high = PriceView(high, n);
+    columns.low = PriceView(low, n);
+    columns.close = PriceView(close, n);
+    if (with_volume) {
+        int64_t* volume = arena.allocate<int64_t>(n);
+        int64_t* timestamp = arena.allocate<int64_t>(n);
+        for (size_t i = 0; i < n; ++i) {
+            volume[i] = volume_[i];
+            timestamp[i] = base_timestamp_ + time_offset_[i];
+        }
+        columns.volume = ArrayView<int64_t>(volume, n);
+        columns.timestamp = ArrayView<int64_t>(timestamp, n);
+    }
+    return columns;
+}
+
+} // namespace indicators
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bar_series.h"
+#include "indicators.h"
+
+namespace indicators {
+
+class ScratchArena;
+
+// Reduced-precision columnar bar storage for long histories and many
+// symbols: prices are float32, volume is uint32 and each timestamp is an
+// int32 offset from the first bar's, 24 bytes per bar against BarSeries'
+// 48. The engine widens the columns to double before computing, so every
+// indicator runs the double kernels on the rounded inputs:
+//
+//   - each stored price is within 2^-24 of the original, relative
+//     (round-to-nearest float32; integers up to 2^24 are exact)
+//   - SMA, EMA and the Bollinger middle band move by at most
+//     2^-24 * max|close| over the bars they read, since they are weighted
+//     averages with non-negative weights summing to one
+//   - the Bollinger bands add at most k * 2^-24 * max|close| on top
+//   - ATR and the MACD line and signal, built from differences of two
+//     rounded values, move by at most 2 * 2^-24 * max|price|
+//   - the MACD histogram, line minus signal, moves by at most
+//     4 * 2^-24 * max|close|
+//   - RSI moves by at most 100 * 2 * 2^-24 * max|close| / (avg_gain +
+//     avg_loss) points, so it is only as good as the bar-to-bar moves are
+//     large compared with the price level
+//
+// Volume and timestamps are stored exactly; append rejects bars whose
+// volume or timestamp offset does not fit.
+class CompactBarSeries {
+public:
+    CompactBarSeries() = default;
+    
+    static CompactBarSeries from_bars(const std::vector<OHLC>& bars);
+    static CompactBarSeries from_columns(const BarColumns& bars);
+    
+    void append(const OHLC& bar);
+    void append(double open, double high, double low, double close,
+                int64_t volume, int64_t timestamp);
+    // Replace the most recent bar, e.g. while it is still forming
+    void update_last(const OHLC& bar);
+    void clear();
+    void reserve(size_t bars);
+    
+    size_t size() const { return close_.size(); }
+    bool empty() const { return close_.empty(); }
+    // Storage held by the columns' capacity
+    size_t memory_bytes() const;
+    
+    // Bar i, oldest first, with prices widened back to double
+    OHLC bar(size_t i) const;
+    std::vector<OHLC> to_bars() const;
+    int64_t timestamp(size_t i) const;
+    int64_t base_timestamp() const { return base_timestamp_; }
+    
+    ArrayView<float> open() const { return ArrayView<float>(open_.data(), size()); }
+    ArrayView<float> high() const { return ArrayView<float>(high_.data(), size()); }
+    ArrayView<float> low() const { return ArrayView<float>(low_.data(), size()); }
+    ArrayView<float> close() const { return ArrayView<float>(close_.data(), size()); }
+    ArrayView<uint32_t> volume() const { return ArrayView<uint32_t>(volume_.data(), size()); }
+    ArrayView<int32_t> timestamp_offsets() const {
+        return ArrayView<int32_t>(time_offset_.data(), size());
+    }
+    
+    // High, low and close widened to double in arena, for the engine's
+    // BarColumns kernels, plus volume and absolute timestamps when
+    // with_volume. The views live until the arena scope ends.
+    BarColumns price_columns(ScratchArena& arena, bool with_volume = false) const;
+    
+private:
+    int32_t encode_timestamp(int64_t timestamp) const;
+    
+    int64_t base_timestamp_ = 0;
+    AlignedVector<float> open_;
+    AlignedVector<float> high_;
+    AlignedVector<float> low_;
+    AlignedVector<float> close_;
+    AlignedVector<uint32_t> volume_;
+    AlignedVector<int32_t> time_offset_;
+};
+
+} // namespace indicators
@@ -0,0 +1,112 @@
+#include "composite_scorer.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace indicators {
+
+namespace {
+
+double signal_vote(SignalType signal) {
+    switch (signal) {
+        case SignalType::OVERSOLD:
+        case SignalType::BULLISH_CROSS:
+        case SignalType::LOWER_BREACH:
+            return 1.0;
+        case SignalType::OVERBOUGHT:
+        case SignalType::BEARISH_CROSS:
+        case SignalType::UPPER_BREACH:
+            return -1.0;
+        case SignalType::NEUTRAL:
+            break;
+    }
+    return 0.0;
+}
+
+} // namespace
+
+CompositeScorer::CompositeScorer(double weight_sentiment,
+                                 double weight_technical,
+                                 double weight_regime)
+    : weight_sentiment_(weight_sentiment),
+      weight_technical_(weight_technical),
+      weight_regime_(weight_regime) {
+    if (weight_sentiment < 0.0 || weight_technical < 0.0 || weight_regime < 0.0) {
+        throw std::invalid_argument("CMS weights must be non-negative");
+    }
+    double total = weight_sentiment + weight_technical + weight_regime;
+    if (total <= 0.0) {
+        throw std::invalid_argument("CMS weights must not all be zero");
+    }
+    if (std::abs(total - 1.0) > 0.001) {
+        weight_sentiment_ /= total;
+        weight_technical_ /= total;
+        weight_regime_ /= total;
+    }
+}
+
+double CompositeScorer::technical_score(const TechnicalSignals& signals) {
+    // Every signal always casts a vote (neutral counts as 0)
+    return (signal_vote(signals.rsi_signal) + signal_vote(signals.macd_signal) +
+            signal_vote(signals.bb_signal)) / 3.0;
+}
+
+double CompositeScorer::regime_score(RegimeType regime, double confidence) {
+    double base = 0.0;
+    switch (regime) {
+        case RegimeType::TRENDING_UP:
+            base = 1.0;
+            break;
+        case RegimeType::TRENDING_DOWN:
+            base = -1.0;
+            break;
+        case RegimeType::RANGING:
+            base = 0.0;
+            break;
+        case RegimeType::VOLATILE:
+            base = -0.3;
+            break;
+        case RegimeType::CALM:
+            base = 0.2;
+            break;
+    }
+    return base * confidence;
+}
+
+CompositeScore CompositeScorer::score(const IndicatorResults& indicators,
+                                      double current_price,
+                                      const MarketContext& context) const {
+    CompositeScore result;
+    result.signals = classify_signals(indicators, current_price);
+    result.technical_score = technical_score(result.signals);
+    
+    double sentiment = context.sentiment_score;
+    double regime = regime_score(context.regime, context.regime_confidence);
+    double cms = (weight_sentiment_ * sentiment +
+                  weight_technical_ * result.technical_score +
+                  weight_regime_ * regime) * 100.0;
+    
+    result.sentiment_component = sentiment * 100.0;
+    result.technical_component = result.technical_score * 100.0;
+    result.regime_component = regime * 100.0;
+    result.score = std::max(-100.0, std::min(100.0, cms));
+    return result;
+}
+
+std::vector<CompositeScore> CompositeScorer::score_batch(
+    const std::vector<IndicatorResults>& indicators,
+    PriceView current_prices,
+    const std::vector<MarketContext>& contexts) const {
+    if (current_prices.size() != indicators.size() || contexts.size() != indicators.size()) {
+        throw std::invalid_argument("Batch inputs must have the same length");
+    }
+    
+    std::vector<CompositeScore> results;
+    results.reserve(indicators.size());
+    for (size_t i = 0; i < indicators.size(); ++i) {
+        results.push_back(score(indicators[i], current_prices[i], contexts[i]));
+    }
+    return results;
+}
+
+} // namespace indicators
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+
+#include "indicators.h"
+
+namespace indicators {
+
+// Market regime classes (RegimeType in src/shared/models.py)
+enum class RegimeType {
+    TRENDING_UP,
+    TRENDING_DOWN,
+    RANGING,
+    VOLATILE,
+    CALM
+};
+
+// Non-technical inputs of one CMS evaluation
+struct MarketContext {
+    double sentiment_score = 0.0;    // [-1, 1]
+    RegimeType regime = RegimeType::RANGING;
+    double regime_confidence = 0.0;  // [0, 1]
+};
+
+// Signals and Composite Market Score for one symbol. Components are
+// scaled to [-100, 100] like CompositeMarketScore in Python.
+struct CompositeScore {
+    TechnicalSignals signals;
+    double technical_score;  // normalized technical signal score in [-1, 1]
+    double sentiment_component;
+    double technical_component;
+    double regime_component;
+    double score;  // weighted CMS, clamped to [-100, 100]
+};
+
+// Indicator results to threshold signals to technical score to weighted
+// CMS in one call. Produces the same numbers as generate_signals followed
+// by SignalAggregator.compute_cms (src/signal/aggregator.py).
+class CompositeScorer {
+public:
+    // Weights are normalized to sum to 1 if they are off by more than 0.001,
+    // as SignalAggregator does
+    CompositeScorer(double weight_sentiment = 0.3,
+                    double weight_technical = 0.5,
+                    double weight_regime = 0.2);
+    
+    double weight_sentiment() const { return weight_sentiment_; }
+    double weight_technical() const { return weight_technical_; }
+    double weight_regime() const { return weight_regime_; }
+    
+    // Mean of the RSI, MACD and Bollinger votes: +1 bullish, -1 bearish
+    static double technical_score(const TechnicalSignals& signals);
+    // Regime base score weighted by the classifier confidence
+    static double regime_score(RegimeType regime, double confidence);
+    
+    CompositeScore score(const IndicatorResults& indicators,
+                         double current_price,
+                         const MarketContext& context) const;
+    
+    // One score per symbol; all three inputs must have the same length
+    std::vector<CompositeScore> score_batch(const std::vector<IndicatorResults>& indicators,
+                                            PriceView current_prices,
+                                            const std::vector<MarketContext>& contexts) const;
+
+private:
+    double weight_sentiment_;
+    double weight_technical_;
+    double weight_regime_;
+};
+
+} // namespace indicators
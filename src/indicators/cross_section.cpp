@@ -0,0 +1,171 @@
+#include "indicators.h"
+#include "profiling.h"
+#include "scratch_arena.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace indicators {
+
+namespace {
+
+// Symbols per pool task: a multiple of every vector width, and small enough
+// that a block's state arrays and current row stay in L1
+constexpr size_t kSymbolBlock = 256;
+
+template <typename T>
+void check_cross_section(const BasicPriceMatrix<T>& closes, MutableArrayView<T> last,
+                         MutableArrayView<T> series, int period) {
+    if (period <= 0) {
+        throw std::invalid_argument("Indicator period must be positive");
+    }
+    if (closes.data == nullptr && closes.size() != 0) {
+        throw std::invalid_argument("Price matrix has no data");
+    }
+    if (last.size() != closes.symbols) {
+        throw std::invalid_argument("Output buffer length does not match symbol count");
+    }
+    if (series.size() != 0 && series.size() != closes.size()) {
+        throw std::invalid_argument("Output buffer length does not match input length");
+    }
+}
+
+// Call body(first, count) for consecutive blocks of symbols, on the pool
+// when there is more than one
+template <typename Body>
+void for_each_symbol_block(ThreadPool& pool, size_t symbols, const Body& body) {
+    const size_t blocks = (symbols + kSymbolBlock - 1) / kSymbolBlock;
+    auto run = [&](size_t block) {
+        size_t first = block * kSymbolBlock;
+        body(first, std::min(kSymbolBlock, symbols - first));
+    };
+    if (blocks == 1) {
+        run(0);
+    } else if (blocks > 1) {
+        pool.parallel_for(blocks, run);
+    }
+}
+
+// EMA of every symbol, stepping EmaState's recurrence one bar at a time
+template <typename T>
+void ema_cross_section(ThreadPool& pool, const BasicPriceMatrix<T>& closes,
+                       MutableArrayView<T> last, int period, MutableArrayView<T> series) {
+    check_cross_section(closes, last, series, period);
+    if (closes.bars < static_cast<size_t>(period)) {
+        throw std::invalid_argument("Insufficient data for EMA calculation");
+    }
+    
+    const size_t window = static_cast<size_t>(period);
+    const T multiplier = static_cast<T>(2.0 / (period + 1.0));
+    const size_t symbols = closes.symbols;
+    if (series.size() != 0) {
+        std::fill(series.data(), series.data() + window * symbols - symbols,
+                  std::numeric_limits<T>::quiet_NaN());
+    }
+    
+    for_each_symbol_block(pool, symbols, [&](size_t first, size_t count) {
+        T* ema = last.data() + first;
+        std::fill(ema, ema + count, T(0));
+        for (size_t t = 0; t < closes.bars; ++t) {
+            const T* row = closes.row(t) + first;
+            if (t < window) {
+                simd::accumulate(ema, row, count);
+                if (t + 1 < window) {
+                    continue;
+                }
+                for (size_t s = 0; s < count; ++s) {
+                    ema[s] /= period;
+                }
+            } else {
+                simd::ema_update(ema, row, count, multiplier);
+            }
+            if (series.size() != 0) {
+                std::memcpy(series.data() + t * symbols + first, ema, count * sizeof(T));
+            }
+        }
+    });
+}
+
+// RSI of every symbol with RsiState's Wilder smoothing
+template <typename T>
+void rsi_cross_section(ThreadPool& pool, const BasicPriceMatrix<T>& closes,
+                       MutableArrayView<T> last, int period, MutableArrayView<T> series) {
+    check_cross_section(closes, last, series, period);
+    if (closes.bars < static_cast<size_t>(period + 1)) {
+        throw std::invalid_argument("Insufficient data for RSI calculation");
+    }
+    
+    const size_t window = static_cast<size_t>(period);
+    const size_t symbols = closes.symbols;
+    if (series.size() != 0) {
+        std::fill(series.data(), series.data() + window * symbols,
+                  std::numeric_limits<T>::quiet_NaN());
+    }
+    
+    for_each_symbol_block(pool, symbols, [&](size_t first, size_t count) {
+        ScratchArena& arena = ScratchArena::local();
+        ScratchArena::Scope scope(arena);
+        T* avg_gain = arena.allocate<T>(count);
+        T* avg_loss = arena.allocate<T>(count);
+        std::fill(avg_gain, avg_gain + count, T(0));
+        std::fill(avg_loss, avg_loss + count, T(0));
+        
+        for (size_t t = 1; t < closes.bars; ++t) {
+            const T* prev = closes.row(t - 1) + first;
+            const T* cur = closes.row(t) + first;
+            if (t <= window) {
+                simd::rsi_accumulate(avg_gain, avg_loss, prev, cur, count);
+                if (t < window) {
+                    continue;
+                }
+                for (size_t s = 0; s < count; ++s) {
+                    avg_gain[s] /= period;
+                    avg_loss[s] /= period;
+                }
+            } else {
+                simd::rsi_smooth(avg_gain, avg_loss, prev, cur, count, period);
+            }
+            if (series.size() != 0) {
+                simd::rsi_value(series.data() + t * symbols + first, avg_gain, avg_loss, count);
+            }
+        }
+        simd::rsi_value(last.data() + first, avg_gain, avg_loss, count);
+    });
+}
+
+} // namespace
+
+void TechnicalIndicatorEngine::compute_ema_cross_section(const PriceMatrix& closes,
+                                                         SeriesBuffer last,
+                                                         int period,
+                                                         SeriesBuffer series) {
+    INDICATORS_PROFILE(EMA_CROSS_SECTION, closes.size());
+    ema_cross_section(pool(), closes, last, period, series);
+}
+
+void TechnicalIndicatorEngine::compute_ema_cross_section(const PriceMatrixF& closes,
+                                                         MutableArrayView<float> last,
+                                                         int period,
+                                                         MutableArrayView<float> series) {
+    INDICATORS_PROFILE(EMA_CROSS_SECTION, closes.size());
+    ema_cross_section(pool(), closes, last, period, series);
+}
+
+void TechnicalIndicatorEngine::compute_rsi_cross_section(const PriceMatrix& closes,
+                                                         SeriesBuffer last,
+                                                         int period,
+                                                         SeriesBuffer series) {
+    INDICATORS_PROFILE(RSI_CROSS_SECTION, closes.size());
+    rsi_cross_section(pool(), closes, last, period, series);
+}
+
+void TechnicalIndicatorEngine::compute_rsi_cross_section(const PriceMatrixF& closes,
+                                                         MutableArrayView<float> last,
+                                                         int period,
+                                                         MutableArrayView<float> series) {
+    INDICATORS_PROFILE(RSI_CROSS_SECTION, closes.size());
+    rsi_cross_section(pool(), closes, last, period, series);
+}
+
+} // namespace indicators
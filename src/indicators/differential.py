@@ -0,0 +1,689 @@
+"""
+Differential golden-output test and speedup report for the C++ engine.
+
+Generates randomized and adversarial bar series, computes every indicator
+with python_indicators.py as the reference and with each native variant,
+checks that they agree within tolerance and reports the native speedup
+over the reference per indicator.
+
+Native variants:
+    kernel          scalar-result methods (compute_rsi, compute_vwap, ...)
+    series          last entry of the full-series kernels
+    fused           compute_indicators with an IndicatorSpec enabling all
+    compact         fused, from float32 CompactBarSeries storage
+    streaming       IncrementalIndicatorState fed bar by bar
+    streaming_ticks the same, each bar built from its open by apply_tick
+    restored        streaming, snapshotted and restored halfway
+    cross_section   compute_ema/rsi_cross_section on a one-row matrix
+    cross_section_f32  the same in float32
+Every variant that touches the vectorized kernels runs once per supported
+instruction set.
+
+Tolerances are relative to the scale of the inputs rather than of the
+value: price-like indicators (moving averages, Bollinger bands, MACD, ATR,
+VWAP) may differ by RTOL * the largest price of the series, oscillators
+(RSI, MFI) by RTOL * 100 and volume indicators by RTOL * the total volume.
+The native kernels sum in another order than the reference (SIMD lanes,
+rolling sums), so results are not bitwise equal, but they stay within a
+few ulps of that scale. Compact storage is compared with the reference on
+the float32-rounded bars, which the engine widens exactly, so it gets the
+same tolerance; the float32 cross-section EMA gets its documented bound
+1.5 * (period + 1) * 2**-24 * max|close|, and its RSI is not checked since
+float32 RSI has no bound independent of the bar-to-bar moves. Where the
+reference rejects a series as too short, a native variant must raise too
+or, for the series kernels, report NaN.
+
+Usage:
+    python -m src.indicators.differential [--seed 7] [--cases 20] [--bars 300]
+
+Exits with status 1 if any variant disagrees with the reference and 2 if
+the C++ module is not built.
+"""
+
+import argparse
+import math
+import random
+import struct
+import sys
+import timeit
+from dataclasses import dataclass, field, replace
+from datetime import datetime, timedelta, timezone
+from typing import Callable, Dict, List, Optional, Sequence, Tuple
+
+from src.shared.models import OHLC
+from src.indicators.python_indicators import PythonIndicatorEngine as Reference
+
+
+RTOL = 1e-12
+
+# Indicator names, as keyed by compute_indicator_series
+PRICE_INDICATORS = (
+    'macd_line', 'signal_line', 'histogram', 'bb_upper', 'bb_middle', 'bb_lower',
+    'sma_20', 'sma_50', 'ema_12', 'ema_26', 'atr', 'vwap',
+)
+OSCILLATORS = ('rsi', 'mfi')
+VOLUME_INDICATORS = ('obv', 'volume_sma')
+
+SESSION_SECONDS = 86400
+BAR_SECONDS = 900
+
+# Value of an indicator, or None where the series is too short for it
+Values = Dict[str, Optional[float]]
+
+
+@dataclass
+class Case:
+    """A named bar series to compare on."""
+    name: str
+    bars: List[OHLC]
+    
+    def scale(self, indicator: str) -> float:
+        """Magnitude the tolerance of an indicator is relative to."""
+        if indicator in OSCILLATORS:
+            return 100.0
+        if indicator in VOLUME_INDICATORS:
+            return max(1.0, float(sum(bar.volume for bar in self.bars)))
+        return max(max(bar.high, abs(bar.low), abs(bar.close)) for bar in self.bars)
+    
+    def rounded(self) -> "Case":
+        """The case with prices rounded to float32, as CompactBarSeries stores them."""
+        def to_float32(value: float) -> float:
+            return struct.unpack('f', struct.pack('f', value))[0]
+        bars = [
+            replace(bar, open=to_float32(bar.open), high=to_float32(bar.high),
+                    low=to_float32(bar.low), close=to_float32(bar.close))
+            for bar in self.bars
+        ]
+        return Case(self.name, bars)
+
+
+@dataclass
+class Mismatch:
+    """A native value outside the tolerance of the reference."""
+    case: str
+    variant: str
+    indicator: str
+    expected: Optional[float]
+    actual: Optional[float]
+    tolerance: float
+
+
+@dataclass
+class DifferentialReport:
+    """Outcome of a differential run."""
+    checks: Dict[str, int] = field(default_factory=dict)
+    mismatches: List[Mismatch] = field(default_factory=list)
+    
+    @property
+    def ok(self) -> bool:
+        return not self.mismatches
+
+
+@dataclass
+class Speedup:
+    """Per-call time of the reference and the native kernel for one indicator."""
+    indicator: str
+    python_seconds: float
+    native_seconds: float
+    
+    @property
+    def ratio(self) -> float:
+        return self.python_seconds / self.native_seconds
+
+
+def _bars_from_closes(
+    rng: random.Random,
+    closes: Sequence[float],
+    volumes: Sequence[int],
+    start: datetime,
+    spread: float = 0.002,
+    gaps: Optional[Dict[int, timedelta]] = None,
+) -> List[OHLC]:
+    """Bars opening at the previous close, with high and low around the body."""
+    bars = []
+    timestamp = start
+    previous = closes[0]
+    for i, (close, volume) in enumerate(zip(closes, volumes)):
+        if gaps and i in gaps:
+            timestamp += gaps[i]
+        body_high = max(previous, close)
+        body_low = min(previous, close)
+        bars.append(OHLC(
+            open=previous,
+            high=body_high * (1.0 + spread * rng.random()),
+            low=body_low * (1.0 - spread * rng.random()),
+            close=close,
+            volume=volume,
+            timestamp=timestamp,
+        ))
+        previous = close
+        timestamp += timedelta(seconds=BAR_SECONDS)
+    return bars
+
+
+def _random_walk(rng: random.Random, count: int, start: float, volatility: float) -> List[float]:
+    closes = []
+    price = start
+    for _ in range(count):
+        price *= math.exp(rng.gauss(0.0, volatility))
+        closes.append(price)
+    return closes
+
+
+def _flat_bars(closes: Sequence[float], volumes: Sequence[int], start: datetime) -> List[OHLC]:
+    """Bars with open, high, low and close all equal to the close."""
+    return [
+        OHLC(open=close, high=close, low=close, close=close, volume=volume,
+             timestamp=start + timedelta(seconds=BAR_SECONDS * i))
+        for i, (close, volume) in enumerate(zip(closes, volumes))
+    ]
+
+
+def generate_cases(seed: int = 7, cases: int = 20, bars: int = 300) -> List[Case]:
+    """
+    Randomized walks plus a fixed set of adversarial series.
+    
+    Args:
+        seed: Seed of the random generator, so a failing run can be replayed
+        cases: Number of random walks
+        bars: Bars per series, at least 60
+    
+    Returns:
+        Cases, random walks first
+    """
+    if bars < 60:
+        raise ValueError("Differential cases need at least 60 bars")
+    rng = random.Random(seed)
+    start = datetime(2024, 1, 2, 9, 30, tzinfo=timezone.utc)
+    
+    def volumes(low: int = 0, high: int = 1_000_000, count: int = bars) -> List[int]:
+        return [rng.randint(low, high) for _ in range(count)]
+    
+    result = []
+    for i in range(cases):
+        volatility = rng.choice((0.0005, 0.005, 0.02, 0.08))
+        level = 10.0 ** rng.uniform(-1.0, 4.0)
+        closes = _random_walk(rng, bars, level, volatility)
+        offset = timedelta(seconds=BAR_SECONDS * rng.randrange(96))
+        result.append(Case(f"random_walk_{i}", _bars_from_closes(rng, closes, volumes(), start + offset)))
+    
+    walk = _random_walk(rng, bars, 100.0, 0.01)
+    spikes = [100.0] * bars
+    spikes[bars // 2] = 10_000.0
+    spikes[-1] = 10_000.0
+    # Prices far from zero moving by tiny ticks, to catch cancellation
+    large_level = [1e7 + 1e-3 * x for x in _random_walk(rng, bars, 1.0, 0.5)]
+    quiet_session = _bars_from_closes(rng, walk, volumes(), start)
+    last_day = quiet_session[-1].timestamp.date()
+    quiet_session = [replace(bar, volume=0) if bar.timestamp.date() == last_day else bar
+                     for bar in quiet_session]
+    gaps = {i: timedelta(days=rng.randint(1, 4)) for i in range(7, bars, 41)}
+    open_gaps = list(walk)
+    for i in range(11, bars, 23):
+        jump = rng.choice((0.8, 1.25))
+        open_gaps[i:] = [price * jump for price in open_gaps[i:]]
+    
+    result.extend([
+        # RSI and MFI at 100 with no losses, Bollinger width and ATR at 0
+        Case("constant", _flat_bars([100.0] * bars, [1000] * bars, start)),
+        Case("rising", _bars_from_closes(rng, [100.0 + 0.5 * i for i in range(bars)], volumes(), start)),
+        Case("falling", _bars_from_closes(rng, [1000.0 * 0.995 ** i for i in range(bars)], volumes(), start)),
+        Case("alternating", _flat_bars([100.0 + (1.0 if i % 2 else -1.0) for i in range(bars)],
+                                       volumes(), start)),
+        Case("spikes", _bars_from_closes(rng, spikes, volumes(), start)),
+        Case("large_level", _bars_from_closes(rng, large_level, volumes(), start, spread=1e-11)),
+        Case("tiny_level", _bars_from_closes(rng, [1e-4 * p for p in walk], volumes(), start)),
+        # VWAP is NaN without volume; MFI sees no money flow at all
+        Case("zero_volume", _bars_from_closes(rng, walk, [0] * bars, start)),
+        Case("quiet_last_session", quiet_session),
+        # Largest volume CompactBarSeries stores, and volumes it cannot
+        Case("volume_uint32_max", _bars_from_closes(rng, walk, volumes(2**32 - 1000, 2**32 - 1), start)),
+        Case("volume_huge", _bars_from_closes(rng, walk, volumes(10**11, 10**12), start)),
+        # Sessions straddling the Unix epoch, then multi-day gaps
+        Case("session_gaps", _bars_from_closes(
+            rng, walk, volumes(), datetime(1969, 12, 31, 13, 0, tzinfo=timezone.utc), gaps=gaps)),
+        Case("open_gaps", _bars_from_closes(rng, open_gaps, volumes(), start)),
+        # Shortest series every indicator is defined on, and shorter ones
+        Case("minimum_50", _bars_from_closes(rng, walk[:50], volumes(count=50), start)),
+        Case("short_36", _bars_from_closes(rng, walk[:36], volumes(count=36), start)),
+        Case("short_15", _bars_from_closes(rng, walk[:15], volumes(count=15), start)),
+        Case("single_bar", _bars_from_closes(rng, walk[:1], volumes(count=1), start)),
+    ])
+    return result
+
+
+def _collect(values: Values, names: Sequence[str], compute: Callable[[], Sequence[float]]) -> None:
+    """Store compute()'s results under names, or None for each if it rejects the input."""
+    try:
+        results = compute()
+    except (ValueError, RuntimeError):
+        results = [None] * len(names)
+    for name, result in zip(names, results):
+        values[name] = None if result is None else float(result)
+
+
+def reference_values(case: Case) -> Values:
+    """Every indicator from python_indicators.py."""
+    bars = case.bars
+    closes = [bar.close for bar in bars]
+    values: Values = {}
+    
+    def macd():
+        result = Reference.compute_macd(closes, 12, 26, 9)
+        return result.macd_line, result.signal_line, result.histogram
+    
+    def bollinger():
+        result = Reference.compute_bollinger_bands(closes, 20, 2.0)
+        return result.upper, result.middle, result.lower
+    
+    _collect(values, ('rsi',), lambda: (Reference.compute_rsi(closes, 14),))
+    _collect(values, ('macd_line', 'signal_line', 'histogram'), macd)
+    _collect(values, ('bb_upper', 'bb_middle', 'bb_lower'), bollinger)
+    _collect(values, ('sma_20',), lambda: (Reference.compute_sma(closes, 20),))
+    _collect(values, ('sma_50',), lambda: (Reference.compute_sma(closes, 50),))
+    _collect(values, ('ema_12',), lambda: (Reference.compute_ema(closes, 12),))
+    _collect(values, ('ema_26',), lambda: (Reference.compute_ema(closes, 26),))
+    _collect(values, ('atr',), lambda: (Reference.compute_atr(bars, 14),))
+    _collect(values, ('obv',), lambda: (Reference.compute_obv(bars),))
+    _collect(values, ('vwap',), lambda: (Reference.compute_vwap(bars, SESSION_SECONDS, 0),))
+    _collect(values, ('mfi',), lambda: (Reference.compute_mfi(bars, 14),))
+    _collect(values, ('volume_sma',), lambda: (Reference.compute_volume_sma(bars, 20),))
+    return values
+
+
+class NativeVariants:
+    """Runs the native variants through the compiled indicators_engine module."""
+    
+    # Variants whose results depend on the vectorized kernels
+    SIMD_VARIANTS = ('kernel', 'series', 'fused', 'compact', 'cross_section', 'cross_section_f32')
+    VARIANTS = SIMD_VARIANTS + ('streaming', 'streaming_ticks', 'restored')
+    
+    def __init__(self):
+        from src.indicators import engine as engine_module
+        if not engine_module.CPP_AVAILABLE:
+            raise ImportError("indicators_engine module not built")
+        import numpy as np
+        import indicators_engine as native
+        self.np = np
+        self.native = native
+        self.engine = native.TechnicalIndicatorEngine()
+        self.spec = native.IndicatorSpec()
+        for flag in ('rsi', 'macd', 'bollinger', 'atr', 'obv', 'vwap', 'mfi', 'volume_sma'):
+            setattr(self.spec, flag, True)
+        self.spec.moving_averages = [
+            native.MovingAverageSpec(native.MovingAverageType.SMA, 20),
+            native.MovingAverageSpec(native.MovingAverageType.SMA, 50),
+            native.MovingAverageSpec(native.MovingAverageType.EMA, 12),
+            native.MovingAverageSpec(native.MovingAverageType.EMA, 26),
+        ]
+    
+    def instruction_sets(self) -> List[object]:
+        """Instruction sets the CPU supports, scalar first."""
+        return [isa for isa in self.native.InstructionSet.__members__.values()
+                if self.native.is_instruction_set_supported(isa)]
+    
+    def columns(self, case: Case) -> Dict[str, object]:
+        np = self.np
+        bars = case.bars
+        return {
+            'open': np.array([bar.open for bar in bars], dtype=np.float64),
+            'high': np.array([bar.high for bar in bars], dtype=np.float64),
+            'low': np.array([bar.low for bar in bars], dtype=np.float64),
+            'close': np.array([bar.close for bar in bars], dtype=np.float64),
+            'volume': np.array([bar.volume for bar in bars], dtype=np.int64),
+            'timestamp': np.array([int(bar.timestamp.timestamp()) for bar in bars], dtype=np.int64),
+        }
+    
+    def native_bars(self, case: Case) -> List[object]:
+        bars = []
+        for bar in case.bars:
+            native_bar = self.native.OHLC()
+            native_bar.open = bar.open
+            native_bar.high = bar.high
+            native_bar.low = bar.low
+            native_bar.close = bar.close
+            native_bar.volume = bar.volume
+            native_bar.timestamp = int(bar.timestamp.timestamp())
+            bars.append(native_bar)
+        return bars
+    
+    def run(self, variant: str, case: Case) -> Values:
+        """Values of one variant, empty where it does not apply to the case."""
+        return getattr(self, variant)(case)
+    
+    def kernel(self, case: Case) -> Values:
+        engine = self.engine
+        c = self.columns(case)
+        close, high, low, volume = c['close'], c['high'], c['low'], c['volume']
+        values: Values = {}
+        
+        def macd():
+            result = engine.compute_macd(close, 12, 26, 9)
+            return result.macd_line, result.signal_line, result.histogram
+        
+        def bollinger():
+            result = engine.compute_bollinger_bands(close, 20, 2.0)
+            return result.upper, result.middle, result.lower
+        
+        _collect(values, ('rsi',), lambda: (engine.compute_rsi(close, 14),))
+        _collect(values, ('macd_line', 'signal_line', 'histogram'), macd)
+        _collect(values, ('bb_upper', 'bb_middle', 'bb_lower'), bollinger)
+        _collect(values, ('sma_20',), lambda: (engine.compute_sma(close, 20),))
+        _collect(values, ('sma_50',), lambda: (engine.compute_sma(close, 50),))
+        _collect(values, ('ema_12',), lambda: (engine.compute_ema(close, 12),))
+        _collect(values, ('ema_26',), lambda: (engine.compute_ema(close, 26),))
+        _collect(values, ('atr',), lambda: (engine.compute_atr(high, low, close, 14),))
+        _collect(values, ('obv',), lambda: (engine.compute_obv(close, volume),))
+        _collect(values, ('vwap',), lambda: (engine.compute_vwap(
+            high, low, close, volume, c['timestamp'], SESSION_SECONDS, 0),))
+        _collect(values, ('mfi',), lambda: (engine.compute_mfi(high, low, close, volume, 14),))
+        _collect(values, ('volume_sma',), lambda: (engine.compute_volume_sma(volume, 20),))
+        return values
+    
+    def series(self, case: Case) -> Values:
+        engine = self.engine
+        c = self.columns(case)
+        close, high, low, volume = c['close'], c['high'], c['low'], c['volume']
+        macd = engine.compute_macd_series(close, 12, 26, 9)
+        upper, middle, lower = engine.compute_bollinger_series(close, 20, 2.0)
+        series = {
+            'rsi': engine.compute_rsi_series(close, 14),
+            'macd_line': macd.macd_line,
+            'signal_line': macd.signal_line,
+            'histogram': macd.histogram,
+            'bb_upper': upper,
+            'bb_middle': middle,
+            'bb_lower': lower,
+            'sma_20': engine.compute_sma_series(close, 20),
+            'sma_50': engine.compute_sma_series(close, 50),
+            'ema_12': engine.compute_ema_series(close, 12),
+            'ema_26': engine.compute_ema_series(close, 26),
+            'atr': engine.compute_atr_series(high, low, close, 14),
+            'obv': engine.compute_obv_series(close, volume),
+            'vwap': engine.compute_vwap_series(high, low, close, volume, c['timestamp'],
+                                               SESSION_SECONDS, 0),
+            'mfi': engine.compute_mfi_series(high, low, close, volume, 14),
+            'volume_sma': engine.compute_volume_sma_series(volume, 20),
+        }
+        return {name: float(values[-1]) for name, values in series.items()}
+    
+    def _from_indicator_values(self, values) -> Values:
+        return {
+            'rsi': values.rsi,
+            'macd_line': values.macd.macd_line,
+            'signal_line': values.macd.signal_line,
+            'histogram': values.macd.histogram,
+            'bb_upper': values.bollinger.upper,
+            'bb_middle': values.bollinger.middle,
+            'bb_lower': values.bollinger.lower,
+            'sma_20': values.sma(20),
+            'sma_50': values.sma(50),
+            'ema_12': values.ema(12),
+            'ema_26': values.ema(26),
+            'atr': values.atr,
+            'obv': values.obv,
+            'vwap': values.vwap,
+            'mfi': values.mfi,
+            'volume_sma': values.volume_sma,
+        }
+    
+    def fused(self, case: Case) -> Values:
+        if len(case.bars) < self.spec.required_bars():
+            return {}
+        c = self.columns(case)
+        return self._from_indicator_values(self.engine.compute_indicators(
+            c['open'], c['high'], c['low'], c['close'], c['volume'], c['timestamp'], self.spec))
+    
+    def compact(self, case: Case) -> Values:
+        if len(case.bars) < self.spec.required_bars():
+            return {}
+        try:
+            bars = self.native.CompactBarSeries.from_bars(self.native_bars(case))
+        except IndexError:
+            # Volume or timestamps out of compact range
+            return {}
+        return self._from_indicator_values(self.engine.compute_indicators(bars, self.spec))
+    
+    def _from_state(self, state) -> Values:
+        if not state.ready():
+            return {}
+        results = state.results()
+        volume = state.volume_indicators()
+        return {
+            'rsi': results.rsi,
+            'macd_line': results.macd.macd_line,
+            'signal_line': results.macd.signal_line,
+            'histogram': results.macd.histogram,
+            'bb_upper': results.bollinger.upper,
+            'bb_middle': results.bollinger.middle,
+            'bb_lower': results.bollinger.lower,
+            'sma_20': results.sma_20,
+            'sma_50': results.sma_50,
+            'ema_12': results.ema_12,
+            'ema_26': results.ema_26,
+            'atr': results.atr,
+            'obv': volume.obv,
+            'vwap': volume.vwap,
+            'mfi': volume.mfi,
+            'volume_sma': volume.volume_sma,
+        }
+    
+    def streaming(self, case: Case) -> Values:
+        state = self.native.IncrementalIndicatorState(SESSION_SECONDS, 0)
+        for bar in self.native_bars(case):
+            state.push_bar(bar)
+        return self._from_state(state)
+    
+    def streaming_ticks(self, case: Case) -> Values:
+        # Each bar opens flat with no volume; ticks to its high, low and
+        # close then revise it into exactly the full bar
+        state = self.native.IncrementalIndicatorState(SESSION_SECONDS, 0)
+        for bar in self.native_bars(case):
+            opening = self.native.OHLC()
+            opening.open = opening.high = opening.low = opening.close = bar.open
+            opening.volume = 0
+            opening.timestamp = bar.timestamp
+            state.push_bar(opening)
+            state.apply_tick(bar.high, 0)
+            state.apply_tick(bar.low, 0)
+            state.apply_tick(bar.close, bar.volume)
+        return self._from_state(state)
+    
+    def restored(self, case: Case) -> Values:
+        bars = self.native_bars(case)
+        half = len(bars) // 2
+        state = self.native.IncrementalIndicatorState(SESSION_SECONDS, 0)
+        for bar in bars[:half]:
+            state.push_bar(bar)
+        state = self.native.IncrementalIndicatorState.restore(state.snapshot())
+        for bar in bars[half:]:
+            state.push_bar(bar)
+        return self._from_state(state)
+    
+    def _cross_section(self, case: Case, dtype, indicators: Sequence[str]) -> Values:
+        np = self.np
+        closes = np.asfortranarray(
+            np.array([[bar.close for bar in case.bars]], dtype=np.float64).astype(dtype))
+        engine = self.engine
+        compute = {
+            'ema_12': lambda: engine.compute_ema_cross_section(closes, 12),
+            'ema_26': lambda: engine.compute_ema_cross_section(closes, 26),
+            'rsi': lambda: engine.compute_rsi_cross_section(closes, 14),
+        }
+        values: Values = {}
+        for name in indicators:
+            _collect(values, (name,), lambda: (compute[name]()[0],))
+        return values
+    
+    def cross_section(self, case: Case) -> Values:
+        return self._cross_section(case, self.np.float64, ('ema_12', 'ema_26', 'rsi'))
+    
+    def cross_section_f32(self, case: Case) -> Values:
+        return self._cross_section(case, self.np.float32, ('ema_12', 'ema_26'))
+
+
+def _tolerance(variant: str, indicator: str, case: Case) -> float:
+    if variant.startswith('cross_section_f32'):
+        period = int(indicator.split('_')[1])
+        return 1.5 * (period + 1) * 2.0 ** -24 * case.scale(indicator)
+    return RTOL * case.scale(indicator)
+
+
+def _agrees(expected: Optional[float], actual: Optional[float], tolerance: float) -> bool:
+    if expected is None:
+        return actual is None or math.isnan(actual)
+    if actual is None:
+        return False
+    if math.isnan(expected) or math.isnan(actual):
+        return math.isnan(expected) and math.isnan(actual)
+    return abs(actual - expected) <= tolerance
+
+
+def run(seed: int = 7, cases: int = 20, bars: int = 300) -> DifferentialReport:
+    """
+    Compare every native variant with the reference on generated cases.
+    
+    Args:
+        seed: Seed of the case generator
+        cases: Number of random walks, on top of the adversarial cases
+        bars: Bars per series
+    
+    Returns:
+        Number of checks per variant and every mismatch
+    
+    Raises:
+        ImportError: If the C++ module is not built
+    """
+    variants = NativeVariants()
+    report = DifferentialReport()
+    native = variants.native
+    default = native.active_instruction_set()
+    
+    generated = generate_cases(seed, cases, bars)
+    references = {case.name: reference_values(case) for case in generated}
+    rounded = {case.name: reference_values(case.rounded()) for case in generated}
+    
+    def check(label: str, variant: str, case: Case) -> None:
+        expected_values = rounded[case.name] if variant in ('compact', 'cross_section_f32') \
+            else references[case.name]
+        for indicator, actual in variants.run(variant, case).items():
+            expected = expected_values[indicator]
+            tolerance = _tolerance(variant, indicator, case)
+            report.checks[label] = report.checks.get(label, 0) + 1
+            if not _agrees(expected, actual, tolerance):
+                report.mismatches.append(Mismatch(case.name, label, indicator, expected, actual, tolerance))
+    
+    try:
+        for isa in variants.instruction_sets():
+            native.set_instruction_set(isa)
+            suffix = isa.name.lower()
+            for case in generated:
+                for variant in NativeVariants.SIMD_VARIANTS:
+                    check(f"{variant}[{suffix}]", variant, case)
+    finally:
+        native.set_instruction_set(default)
+    
+    for case in generated:
+        for variant in NativeVariants.VARIANTS[len(NativeVariants.SIMD_VARIANTS):]:
+            check(variant, variant, case)
+    return report
+
+
+def _per_call(function: Callable[[], object], repeat: int = 3) -> float:
+    timer = timeit.Timer(function)
+    number, _ = timer.autorange()
+    return min(timer.repeat(repeat=repeat, number=number)) / number
+
+
+def measure_speedups(seed: int = 7, bars: int = 1000) -> List[Speedup]:
+    """
+    Time the reference against the native scalar-result kernels.
+    
+    The native time is what a Python caller pays: the kernel plus argument
+    marshalling of NumPy columns read in place.
+    
+    Args:
+        seed: Seed of the random walk timed on
+        bars: Bars in the series
+    
+    Returns:
+        One entry per indicator, then the fused compute_indicators call
+        against every reference indicator in turn
+    """
+    variants = NativeVariants()
+    engine = variants.engine
+    case = generate_cases(seed, 1, bars)[0]
+    c = variants.columns(case)
+    close, high, low, volume, timestamp = c['close'], c['high'], c['low'], c['volume'], c['timestamp']
+    bar_list = case.bars
+    closes = [bar.close for bar in bar_list]
+    
+    pairs: List[Tuple[str, Callable[[], object], Callable[[], object]]] = [
+        ('rsi', lambda: Reference.compute_rsi(closes, 14), lambda: engine.compute_rsi(close, 14)),
+        ('macd', lambda: Reference.compute_macd(closes), lambda: engine.compute_macd(close)),
+        ('bollinger', lambda: Reference.compute_bollinger_bands(closes),
+         lambda: engine.compute_bollinger_bands(close)),
+        ('sma_50', lambda: Reference.compute_sma(closes, 50), lambda: engine.compute_sma(close, 50)),
+        ('ema_26', lambda: Reference.compute_ema(closes, 26), lambda: engine.compute_ema(close, 26)),
+        ('atr', lambda: Reference.compute_atr(bar_list), lambda: engine.compute_atr(high, low, close)),
+        ('obv', lambda: Reference.compute_obv(bar_list), lambda: engine.compute_obv(close, volume)),
+        ('vwap', lambda: Reference.compute_vwap(bar_list),
+         lambda: engine.compute_vwap(high, low, close, volume, timestamp)),
+        ('mfi', lambda: Reference.compute_mfi(bar_list), lambda: engine.compute_mfi(high, low, close, volume)),
+        ('volume_sma', lambda: Reference.compute_volume_sma(bar_list),
+         lambda: engine.compute_volume_sma(volume)),
+    ]
+    speedups = [Speedup(name, _per_call(python), _per_call(cpp)) for name, python, cpp in pairs]
+    
+    speedups.append(Speedup(
+        'all (fused)',
+        sum(entry.python_seconds for entry in speedups) + _per_call(lambda: Reference.compute_sma(closes, 20))
+        + _per_call(lambda: Reference.compute_ema(closes, 12)),
+        _per_call(lambda: engine.compute_indicators(
+            c['open'], high, low, close, volume, timestamp, variants.spec)),
+    ))
+    return speedups
+
+
+def _format_value(value: Optional[float]) -> str:
+    return "rejected" if value is None else repr(value)
+
+
+def main(argv: Optional[Sequence[str]] = None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0].strip())
+    parser.add_argument("--seed", type=int, default=7, help="case generator seed")
+    parser.add_argument("--cases", type=int, default=20, help="random walks on top of the adversarial cases")
+    parser.add_argument("--bars", type=int, default=300, help="bars per series")
+    parser.add_argument("--timing-bars", type=int, default=1000, help="bars of the timed series")
+    parser.add_argument("--no-timing", action="store_true", help="skip the speedup report")
+    args = parser.parse_args(argv)
+    
+    try:
+        report = run(args.seed, args.cases, args.bars)
+    except ImportError as e:
+        print(f"C++ indicators engine not available: {e}")
+        return 2
+    
+    print(f"{'variant':<26}{'checks':>8}{'mismatches':>12}")
+    for label, checks in report.checks.items():
+        failed = sum(1 for mismatch in report.mismatches if mismatch.variant == label)
+        print(f"{label:<26}{checks:>8}{failed:>12}")
+    for mismatch in report.mismatches[:20]:
+        print(f"MISMATCH {mismatch.case} {mismatch.variant} {mismatch.indicator}: "
+              f"expected {_format_value(mismatch.expected)}, got {_format_value(mismatch.actual)} "
+              f"(tolerance {mismatch.tolerance:.3g})")
+    if len(report.mismatches) > 20:
+        print(f"... {len(report.mismatches) - 20} more mismatches")
+    
+    if not args.no_timing:
+        print()
+        print(f"{'indicator':<14}{'python us':>12}{'native us':>12}{'speedup':>10}")
+        for entry in measure_speedups(args.seed, args.timing_bars):
+            print(f"{entry.indicator:<14}{entry.python_seconds * 1e6:>12.1f}"
+                  f"{entry.native_seconds * 1e6:>12.2f}{entry.ratio:>9.0f}x")
+    
+    return 0 if report.ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
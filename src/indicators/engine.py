@@ -1,14 +1,18 @@
 """Python wrapper for C++ Technical Indicator Engine."""
 
-from typing import List, Any, TYPE_CHECKING
-from datetime import datetime
+from typing import List, Any, Dict, Optional, Sequence, Tuple, Union, TYPE_CHECKING
+from dataclasses import dataclass, replace
+from datetime import datetime, timedelta, timezone
+import asyncio
 import sys
 import os
+import threading
 
 # Add the indicators directory to the path to find the compiled module
 sys.path.insert(0, os.path.dirname(__file__))
 
 try:
+    import numpy as np
     from indicators_engine import (
         TechnicalIndicatorEngine as CppEngine,
         OHLC as CppOHLC,
@@ -16,6 +20,17 @@ try:
         IndicatorResults as CppIndicatorResults,
         TechnicalSignals as CppTechnicalSignals,
         SignalType as CppSignalType,
+        IncrementalIndicatorState as CppIncrementalIndicatorState,
+        BarAggregator as CppBarAggregator,
+        IndicatorSpec as CppIndicatorSpec,
+        MovingAverageSpec as CppMovingAverageSpec,
+        MovingAverageType as CppMovingAverageType,
+        CompositeScorer as CppCompositeScorer,
+        MarketContext as CppMarketContext,
+        RegimeType as CppRegimeType,
+        profiling_enabled as cpp_profiling_enabled,
+        profiling_snapshot as cpp_profiling_snapshot,
+        reset_profiling as cpp_reset_profiling,
     )
     CPP_AVAILABLE = True
 except ImportError:
@@ -27,6 +42,14 @@ except ImportError:
     CppIndicatorResults = Any
     CppTechnicalSignals = Any
     CppSignalType = Any
+    CppIncrementalIndicatorState = Any
+    CppBarAggregator = Any
+    CppIndicatorSpec = Any
+    CppMovingAverageSpec = Any
+    CppMovingAverageType = Any
+    CppCompositeScorer = Any
+    CppMarketContext = Any
+    CppRegimeType = Any
     print("Warning: C++ indicators engine not available, using Python fallback")
 
 from src.shared.models import (
@@ -37,9 +60,79 @@ from src.shared.models import (
     TechnicalSignalType,
     MACDResult,
     BollingerBands,
+    CompositeMarketScore,
+    MarketRegime,
+    RegimeType,
 )
 
 
+@dataclass
+class IndicatorSpec:
+    """
+    Indicators to compute and their parameters.
+    
+    Disabled indicators are skipped entirely, so a strategy that needs only
+    RSI and ATR does not pay for MACD or Bollinger Bands. The defaults match
+    the fixed set computed by compute_indicators; the volume indicators
+    are off by default. VWAP restarts at every session boundary, sessions
+    being floor((timestamp - vwap_session_offset) / vwap_session_seconds).
+    """
+    rsi: bool = True
+    rsi_period: int = 14
+    macd: bool = True
+    macd_fast_period: int = 12
+    macd_slow_period: int = 26
+    macd_signal_period: int = 9
+    bollinger: bool = True
+    bollinger_period: int = 20
+    bollinger_std_dev: float = 2.0
+    atr: bool = True
+    atr_period: int = 14
+    obv: bool = False
+    vwap: bool = False
+    vwap_session_seconds: int = 86400
+    vwap_session_offset: int = 0
+    mfi: bool = False
+    mfi_period: int = 14
+    volume_sma: bool = False
+    volume_sma_period: int = 20
+    sma_periods: Tuple[int, ...] = (20, 50)
+    ema_periods: Tuple[int, ...] = (12, 26)
+
+
+# Fewest bars for each IndicatorResults field, as in IndicatorSpec.required_bars
+_RESULT_FIELD_BARS = {
+    'rsi': 15,
+    'macd': 35,
+    'bollinger': 20,
+    'sma_20': 20,
+    'sma_50': 50,
+    'ema_12': 12,
+    'ema_26': 26,
+    'atr': 15,
+}
+
+
+@dataclass
+class IndicatorComputation:
+    """
+    Outcome of TechnicalIndicatorEngine.try_compute_indicators.
+    
+    status is 'ok' when every indicator was computed, 'partial' when some
+    lack enough bars, 'insufficient_data' when none could be computed and
+    'invalid_input' for mismatched columns. Fields of results whose flag in
+    valid is False are NaN.
+    """
+    status: str
+    results: IndicatorResults
+    valid: Dict[str, bool]
+    required_bars: int = 50
+    
+    @property
+    def ok(self) -> bool:
+        return self.status == 'ok'
+
+
 class TechnicalIndicatorEngine:
     """
     Python wrapper for the C++ Technical Indicator Engine.
@@ -55,6 +148,11 @@ class TechnicalIndicatorEngine:
             self._use_cpp = True
         else:
             self._use_cpp = False
+            # symbol -> (key, results, signals), see analyze()
+            self._results: Dict[str, Tuple[Tuple, IndicatorResults, TechnicalSignals]] = {}
+            self._results_lock = threading.Lock()
+            self._cache_hits = 0
+            self._cache_misses = 0
     
     def _convert_ohlc_to_cpp(self, ohlc: OHLC) -> CppOHLC:
         """Convert Python OHLC to C++ OHLC."""
@@ -75,6 +173,21 @@ class TechnicalIndicatorEngine:
         cpp_data.timestamp = int(price_data.timestamp.timestamp())
         return cpp_data
     
+    def _convert_price_data_to_columns(self, price_data: PriceData) -> Dict[str, Any]:
+        """Convert Python PriceData to contiguous NumPy columns for the C++ engine."""
+        bars = price_data.bars
+        count = len(bars)
+        return {
+            'open': np.fromiter((bar.open for bar in bars), dtype=np.float64, count=count),
+            'high': np.fromiter((bar.high for bar in bars), dtype=np.float64, count=count),
+            'low': np.fromiter((bar.low for bar in bars), dtype=np.float64, count=count),
+            'close': np.fromiter((bar.close for bar in bars), dtype=np.float64, count=count),
+            'volume': np.fromiter((bar.volume for bar in bars), dtype=np.int64, count=count),
+            'timestamp': np.fromiter(
+                (int(bar.timestamp.timestamp()) for bar in bars), dtype=np.int64, count=count
+            ),
+        }
+    
     def _convert_cpp_results_to_python(self, cpp_results: CppIndicatorResults) -> IndicatorResults:
         """Convert C++ IndicatorResults to Python IndicatorResults."""
         macd = MACDResult(
@@ -138,12 +251,392 @@ class TechnicalIndicatorEngine:
             return self._compute_indicators_python(price_data)
         
         try:
-            cpp_data = self._convert_price_data_to_cpp(price_data)
-            cpp_results = self._engine.compute_indicators(cpp_data)
+            columns = self._convert_price_data_to_columns(price_data)
+            cpp_results = self._engine.compute_indicators(**columns)
             return self._convert_cpp_results_to_python(cpp_results)
         except Exception as e:
             raise ValueError(f"Failed to compute indicators: {str(e)}")
     
+    def compute_indicators_from_arrays(
+        self,
+        open: Sequence[float],
+        high: Sequence[float],
+        low: Sequence[float],
+        close: Sequence[float],
+        volume: Sequence[int],
+        timestamp: Sequence[int],
+        symbol: str = "",
+    ) -> IndicatorResults:
+        """
+        Compute all technical indicators from per-field bar columns.
+        
+        Contiguous float64 (prices) and int64 (volume, Unix timestamps)
+        NumPy arrays are read in place by the C++ engine without copying.
+        
+        Args:
+            open: Open prices
+            high: High prices
+            low: Low prices
+            close: Close prices
+            volume: Volumes
+            timestamp: Bar timestamps as Unix seconds
+            symbol: Stock symbol (used by the Python fallback only)
+            
+        Returns:
+            IndicatorResults with all computed indicators
+            
+        Raises:
+            ValueError: If insufficient data or invalid input
+        """
+        if not self._use_cpp:
+            bars = [
+                OHLC(
+                    open=float(o), high=float(h), low=float(l), close=float(c),
+                    volume=int(v), timestamp=datetime.fromtimestamp(int(t)),
+                )
+                for o, h, l, c, v, t in zip(open, high, low, close, volume, timestamp)
+            ]
+            price_data = PriceData(
+                symbol=symbol,
+                bars=bars,
+                timestamp=bars[-1].timestamp if bars else datetime.now(),
+            )
+            return self._compute_indicators_python(price_data)
+        
+        try:
+            cpp_results = self._engine.compute_indicators(
+                open=open, high=high, low=low, close=close,
+                volume=volume, timestamp=timestamp,
+            )
+            return self._convert_cpp_results_to_python(cpp_results)
+        except Exception as e:
+            raise ValueError(f"Failed to compute indicators: {str(e)}")
+    
+    def compute_indicator_series(self, price_data: PriceData) -> Dict[str, Any]:
+        """
+        Compute every indicator for every bar in one pass per indicator.
+        
+        Intended for backtests: entry i of each series equals the value
+        compute_indicators would return for the first i + 1 bars, and
+        entries before an indicator's warm-up period are NaN.
+        
+        Args:
+            price_data: Price data with OHLC bars
+            
+        Returns:
+            Dictionary of NumPy arrays keyed by indicator name (rsi,
+            macd_line, signal_line, histogram, bb_upper, bb_middle,
+            bb_lower, sma_20, sma_50, ema_12, ema_26, atr, obv, vwap, mfi,
+            volume_sma); vwap restarts each UTC day
+            
+        Raises:
+            NotImplementedError: If the C++ module is not available
+            ValueError: If the input is invalid
+        """
+        if not self._use_cpp:
+            raise NotImplementedError("Indicator series require the C++ indicators engine")
+        
+        try:
+            columns = self._convert_price_data_to_columns(price_data)
+            close = columns['close']
+            high = columns['high']
+            low = columns['low']
+            volume = columns['volume']
+            macd = self._engine.compute_macd_series(close, 12, 26, 9)
+            bb_upper, bb_middle, bb_lower = self._engine.compute_bollinger_series(close, 20, 2.0)
+            return {
+                'rsi': self._engine.compute_rsi_series(close, 14),
+                'macd_line': np.asarray(macd.macd_line),
+                'signal_line': np.asarray(macd.signal_line),
+                'histogram': np.asarray(macd.histogram),
+                'bb_upper': bb_upper,
+                'bb_middle': bb_middle,
+                'bb_lower': bb_lower,
+                'sma_20': self._engine.compute_sma_series(close, 20),
+                'sma_50': self._engine.compute_sma_series(close, 50),
+                'ema_12': self._engine.compute_ema_series(close, 12),
+                'ema_26': self._engine.compute_ema_series(close, 26),
+                'atr': self._engine.compute_atr_series(high, low, close, 14),
+                'obv': self._engine.compute_obv_series(close, volume),
+                'vwap': self._engine.compute_vwap_series(
+                    high, low, close, volume, columns['timestamp'], 86400, 0
+                ),
+                'mfi': self._engine.compute_mfi_series(high, low, close, volume, 14),
+                'volume_sma': self._engine.compute_volume_sma_series(volume, 20),
+            }
+        except Exception as e:
+            raise ValueError(f"Failed to compute indicator series: {str(e)}")
+    
+    def compute_ema_cross_section(self, closes: Any, period: int, full_series: bool = False) -> Any:
+        """
+        Compute the EMA of many symbols at once from a dense matrix of closes.
+        
+        The recursion runs along time with one symbol per SIMD lane, so
+        screening a universe costs one call instead of one per symbol. Row s
+        of the result equals compute_ema on row s of closes.
+        
+        Args:
+            closes: (symbols, bars) NumPy array; a Fortran-ordered float64
+                or float32 array is read in place, anything else is copied
+                to float64 first. float32 closes are computed and returned
+                in float32, within about 1.5 * (period + 1) * 2**-24 *
+                max|close| of the float64 result.
+            period: EMA period
+            full_series: Return the whole (symbols, bars) history, NaN
+                before the warm-up period, instead of the last value
+        
+        Returns:
+            NumPy array of shape (symbols,), or (symbols, bars) with full_series
+        
+        Raises:
+            NotImplementedError: If the C++ module is not available
+            ValueError: If the input is invalid or too short
+        """
+        if not self._use_cpp:
+            raise NotImplementedError("Cross-sectional indicators require the C++ indicators engine")
+        
+        try:
+            return self._engine.compute_ema_cross_section(closes, period, full_series)
+        except Exception as e:
+            raise ValueError(f"Failed to compute cross-sectional EMA: {str(e)}")
+    
+    def compute_rsi_cross_section(self, closes: Any, period: int = 14, full_series: bool = False) -> Any:
+        """
+        Compute the RSI of many symbols at once from a dense matrix of closes.
+        
+        Same layout and results contract as compute_ema_cross_section; row s
+        of the result equals compute_rsi on row s of closes.
+        
+        Args:
+            closes: (symbols, bars) NumPy array of closes, float64 or float32
+            period: RSI period
+            full_series: Return the whole (symbols, bars) history instead of
+                the last value
+        
+        Returns:
+            NumPy array of shape (symbols,), or (symbols, bars) with full_series
+        
+        Raises:
+            NotImplementedError: If the C++ module is not available
+            ValueError: If the input is invalid or too short
+        """
+        if not self._use_cpp:
+            raise NotImplementedError("Cross-sectional indicators require the C++ indicators engine")
+        
+        try:
+            return self._engine.compute_rsi_cross_section(closes, period, full_series)
+        except Exception as e:
+            raise ValueError(f"Failed to compute cross-sectional RSI: {str(e)}")
+    
+    def compute_selected_indicators(self, price_data: PriceData, spec: IndicatorSpec) -> Dict[str, float]:
+        """
+        Compute only the indicators enabled in spec.
+        
+        Args:
+            price_data: Price data with OHLC bars
+            spec: Indicators and periods to compute
+            
+        Returns:
+            Dictionary keyed by indicator name: rsi, macd_line, signal_line,
+            histogram, bb_upper, bb_middle, bb_lower, atr, obv, vwap, mfi
+            and volume_sma when enabled, plus sma_<period> and ema_<period>
+            for each moving average
+            
+        Raises:
+            ValueError: If insufficient data or invalid input
+        """
+        if not self._use_cpp:
+            return self._compute_selected_indicators_python(price_data, spec)
+        
+        try:
+            columns = self._convert_price_data_to_columns(price_data)
+            values = self._engine.compute_indicators(**columns, spec=self._convert_spec_to_cpp(spec))
+        except Exception as e:
+            raise ValueError(f"Failed to compute indicators: {str(e)}")
+        
+        result: Dict[str, float] = {}
+        if spec.rsi:
+            result['rsi'] = values.rsi
+        if spec.macd:
+            result['macd_line'] = values.macd.macd_line
+            result['signal_line'] = values.macd.signal_line
+            result['histogram'] = values.macd.histogram
+        if spec.bollinger:
+            result['bb_upper'] = values.bollinger.upper
+            result['bb_middle'] = values.bollinger.middle
+            result['bb_lower'] = values.bollinger.lower
+        if spec.atr:
+            result['atr'] = values.atr
+        if spec.obv:
+            result['obv'] = values.obv
+        if spec.vwap:
+            result['vwap'] = values.vwap
+        if spec.mfi:
+            result['mfi'] = values.mfi
+        if spec.volume_sma:
+            result['volume_sma'] = values.volume_sma
+        for period in spec.sma_periods:
+            result[f'sma_{period}'] = values.sma(period)
+        for period in spec.ema_periods:
+            result[f'ema_{period}'] = values.ema(period)
+        return result
+    
+    def compute_indicators_batch(self, batch: List[PriceData]) -> List[IndicatorResults]:
+        """
+        Compute indicators for many symbols at once.
+        
+        The C++ engine spreads the symbols over a thread pool with the GIL
+        released; the Python fallback computes them one after another.
+        
+        Args:
+            batch: Price data for each symbol
+            
+        Returns:
+            IndicatorResults in the same order as the input
+            
+        Raises:
+            ValueError: If any symbol has insufficient or invalid data
+        """
+        if not self._use_cpp:
+            return [self._compute_indicators_python(price_data) for price_data in batch]
+        
+        try:
+            cpp_batch = [self._convert_price_data_to_cpp(price_data) for price_data in batch]
+            cpp_results = self._engine.compute_indicators_batch(cpp_batch)
+            return [self._convert_cpp_results_to_python(result) for result in cpp_results]
+        except Exception as e:
+            raise ValueError(f"Failed to compute indicators: {str(e)}")
+    
+    async def compute_indicators_async(self, price_data: PriceData) -> IndicatorResults:
+        """
+        Awaitable compute_indicators that does not block the event loop.
+        
+        The C++ engine computes on its worker pool with the GIL released and
+        resolves the awaited future through the running loop; the Python
+        fallback runs in the loop's default executor.
+        
+        Args:
+            price_data: Price data with OHLC bars
+        
+        Returns:
+            IndicatorResults with all computed indicators
+        
+        Raises:
+            ValueError: If insufficient data or invalid input
+        """
+        if not self._use_cpp:
+            loop = asyncio.get_running_loop()
+            return await loop.run_in_executor(None, self._compute_indicators_python, price_data)
+        
+        cpp_price_data = self._convert_price_data_to_cpp(price_data)
+        cpp_results = await self._await_native(
+            lambda done: self._engine.submit_indicators(cpp_price_data, done),
+            "Failed to compute indicators"
+        )
+        return self._convert_cpp_results_to_python(cpp_results)
+    
+    async def compute_indicators_batch_async(self, batch: List[PriceData]) -> List[IndicatorResults]:
+        """
+        Awaitable compute_indicators_batch that does not block the event loop.
+        
+        Args:
+            batch: Price data for each symbol
+        
+        Returns:
+            IndicatorResults in the same order as the input
+        
+        Raises:
+            ValueError: If any symbol has insufficient or invalid data
+        """
+        if not self._use_cpp:
+            loop = asyncio.get_running_loop()
+            return await loop.run_in_executor(None, self.compute_indicators_batch, batch)
+        
+        cpp_batch = [self._convert_price_data_to_cpp(price_data) for price_data in batch]
+        cpp_results = await self._await_native(
+            lambda done: self._engine.submit_indicators_batch(cpp_batch, done),
+            "Failed to compute indicators"
+        )
+        return [self._convert_cpp_results_to_python(result) for result in cpp_results]
+    
+    def _await_native(self, submit, error_prefix: str) -> "asyncio.Future":
+        """
+        Submit native work and return a future of the running loop for it.
+        
+        submit receives the completion callback, which the engine calls on
+        its worker thread; the result is handed to the loop thread with
+        call_soon_threadsafe. A cancelled future just drops the result.
+        """
+        loop = asyncio.get_running_loop()
+        future = loop.create_future()
+        
+        def resolve(result: Any, error: Optional[str]) -> None:
+            if future.cancelled():
+                return
+            if error is not None:
+                future.set_exception(ValueError(f"{error_prefix}: {error}"))
+            else:
+                future.set_result(result)
+        
+        def done(result: Any, error: Optional[str]) -> None:
+            try:
+                loop.call_soon_threadsafe(resolve, result, error)
+            except RuntimeError:
+                # The loop was closed while the computation ran
+                pass
+        
+        submit(done)
+        return future
+    
+    def try_compute_indicators(self, price_data: PriceData) -> IndicatorComputation:
+        """
+        Compute the indicators the available bars allow, without raising.
+        
+        Meant for the many short-history symbols (newly listed, illiquid)
+        for which compute_indicators would raise: indicators with enough
+        bars are still returned, the others are NaN and flagged invalid.
+        
+        Args:
+            price_data: Price data with OHLC bars, possibly fewer than 50
+        
+        Returns:
+            IndicatorComputation with status, results and validity flags
+        """
+        if not self._use_cpp:
+            return self._try_compute_indicators_python(price_data)
+        
+        columns = self._convert_price_data_to_columns(price_data)
+        return self._convert_cpp_computation_to_python(self._engine.try_compute_indicators(**columns))
+    
+    def try_compute_indicators_batch(self, batch: List[PriceData]) -> List[IndicatorComputation]:
+        """
+        Non-raising compute_indicators_batch: one IndicatorComputation per symbol.
+        
+        Args:
+            batch: Price data for each symbol
+        
+        Returns:
+            IndicatorComputation in the same order as the input
+        """
+        if not self._use_cpp:
+            return [self._try_compute_indicators_python(price_data) for price_data in batch]
+        
+        cpp_batch = [self._convert_price_data_to_cpp(price_data) for price_data in batch]
+        return [
+            self._convert_cpp_computation_to_python(computed)
+            for computed in self._engine.try_compute_indicators_batch(cpp_batch)
+        ]
+    
+    def _convert_cpp_computation_to_python(self, computed: Any) -> IndicatorComputation:
+        """Convert C++ ComputedResults to Python IndicatorComputation."""
+        valid = computed.valid
+        return IndicatorComputation(
+            status=computed.status.name.lower(),
+            results=self._convert_cpp_results_to_python(computed.results),
+            valid={field: getattr(valid, field) for field in _RESULT_FIELD_BARS},
+            required_bars=computed.required_bars,
+        )
+    
     def generate_signals(self, indicators: IndicatorResults, current_price: float) -> TechnicalSignals:
         """
         Generate trading signals based on indicator values.
@@ -179,11 +672,269 @@ class TechnicalIndicatorEngine:
         except Exception as e:
             raise ValueError(f"Failed to generate signals: {str(e)}")
     
+    def analyze(self, price_data: PriceData) -> Tuple[IndicatorResults, TechnicalSignals]:
+        """
+        Indicators and signals at the last close, cached per symbol.
+        
+        Repeated requests for a symbol whose bars have not changed (same
+        bar count and identical last bar) are answered from the engine's
+        result cache without recomputing or converting the bars. A new or
+        revised last bar misses and replaces the cached entry. Safe to call
+        from several threads.
+        
+        Args:
+            price_data: Price data with OHLC bars
+        
+        Returns:
+            Tuple of IndicatorResults and TechnicalSignals
+        
+        Raises:
+            ValueError: If insufficient data or invalid input
+        """
+        if not price_data.bars:
+            raise ValueError("Failed to compute indicators: Empty price data")
+        symbol = price_data.symbol
+        last = price_data.bars[-1]
+        
+        if not self._use_cpp:
+            key = (len(price_data.bars), last.open, last.high, last.low, last.close,
+                   last.volume, last.timestamp)
+            with self._results_lock:
+                cached = self._results.get(symbol)
+                if cached is not None and cached[0] == key:
+                    self._cache_hits += 1
+                    return cached[1], cached[2]
+                self._cache_misses += 1
+            results = self._compute_indicators_python(price_data)
+            signals = self._generate_signals_python(results, last.close)
+            with self._results_lock:
+                self._results[symbol] = (key, results, signals)
+            return results, signals
+        
+        try:
+            analysis = self._engine.result_cache.lookup(
+                symbol, len(price_data.bars), self._convert_ohlc_to_cpp(last)
+            )
+            if analysis is None:
+                columns = self._convert_price_data_to_columns(price_data)
+                analysis = self._engine.analyze(symbol, **columns)
+            return (self._convert_cpp_results_to_python(analysis.indicators),
+                    self._convert_cpp_signals_to_python(analysis.signals))
+        except Exception as e:
+            raise ValueError(f"Failed to compute indicators: {str(e)}")
+    
+    async def analyze_async(self, price_data: PriceData) -> Tuple[IndicatorResults, TechnicalSignals]:
+        """
+        Awaitable analyze that does not block the event loop.
+        
+        Cache hits are answered immediately; misses are computed on the
+        engine's worker pool, or in the loop's default executor for the
+        Python fallback.
+        
+        Args:
+            price_data: Price data with OHLC bars
+        
+        Returns:
+            Tuple of IndicatorResults and TechnicalSignals
+        
+        Raises:
+            ValueError: If insufficient data or invalid input
+        """
+        if not self._use_cpp:
+            loop = asyncio.get_running_loop()
+            return await loop.run_in_executor(None, self.analyze, price_data)
+        if not price_data.bars:
+            raise ValueError("Failed to compute indicators: Empty price data")
+        
+        analysis = self._engine.result_cache.lookup(
+            price_data.symbol, len(price_data.bars), self._convert_ohlc_to_cpp(price_data.bars[-1])
+        )
+        if analysis is None:
+            cpp_price_data = self._convert_price_data_to_cpp(price_data)
+            analysis = await self._await_native(
+                lambda done: self._engine.submit_analysis(cpp_price_data, done),
+                "Failed to compute indicators"
+            )
+        return (self._convert_cpp_results_to_python(analysis.indicators),
+                self._convert_cpp_signals_to_python(analysis.signals))
+    
+    def invalidate_cached_results(self, symbol: Optional[str] = None) -> None:
+        """
+        Drop the cached analysis of a symbol, or of every symbol.
+        
+        Args:
+            symbol: Symbol to drop, or None to clear the whole cache
+        """
+        if self._use_cpp:
+            cache = self._engine.result_cache
+            if symbol is None:
+                cache.clear()
+            else:
+                cache.invalidate(symbol)
+            return
+        with self._results_lock:
+            if symbol is None:
+                self._results.clear()
+            else:
+                self._results.pop(symbol, None)
+    
+    def result_cache_stats(self) -> Dict[str, int]:
+        """Entries, hits and misses of the result cache used by analyze()."""
+        if self._use_cpp:
+            cache = self._engine.result_cache
+            return {'entries': len(cache), 'hits': cache.hits, 'misses': cache.misses}
+        with self._results_lock:
+            return {
+                'entries': len(self._results),
+                'hits': self._cache_hits,
+                'misses': self._cache_misses,
+            }
+    
+    @staticmethod
+    def profiling_snapshot() -> Dict[str, Dict[str, float]]:
+        """
+        Per-indicator timers and counters from inside the C++ engine.
+        
+        Covers the native work only, without Python marshalling. Keyed by
+        probe name (compute_indicators, close_pass, rsi, bollinger, ...);
+        probes that have not run are omitted. Empty unless the module was
+        built with -DINDICATORS_ENABLE_PROFILING=ON.
+        
+        Returns:
+            Dict of probe name to calls, bars, allocations, heap_allocations,
+            total_ns, mean_ns, p50_ns, p99_ns and max_ns
+        """
+        if not CPP_AVAILABLE or not cpp_profiling_enabled():
+            return {}
+        return {
+            probe.name: {
+                'calls': probe.calls,
+                'bars': probe.bars,
+                'allocations': probe.allocations,
+                'heap_allocations': probe.heap_allocations,
+                'total_ns': probe.total_ns,
+                'mean_ns': probe.mean_ns,
+                'p50_ns': probe.p50_ns,
+                'p99_ns': probe.p99_ns,
+                'max_ns': probe.max_ns,
+            }
+            for probe in cpp_profiling_snapshot()
+            if probe.calls > 0
+        }
+    
+    @staticmethod
+    def reset_profiling() -> None:
+        """Restart the C++ engine's profiling counters from zero."""
+        if CPP_AVAILABLE:
+            cpp_reset_profiling()
+    
+    def _convert_spec_to_cpp(self, spec: IndicatorSpec) -> CppIndicatorSpec:
+        """Convert a Python IndicatorSpec to the C++ IndicatorSpec."""
+        cpp_spec = CppIndicatorSpec()
+        cpp_spec.rsi = spec.rsi
+        cpp_spec.rsi_period = spec.rsi_period
+        cpp_spec.macd = spec.macd
+        cpp_spec.macd_fast_period = spec.macd_fast_period
+        cpp_spec.macd_slow_period = spec.macd_slow_period
+        cpp_spec.macd_signal_period = spec.macd_signal_period
+        cpp_spec.bollinger = spec.bollinger
+        cpp_spec.bollinger_period = spec.bollinger_period
+        cpp_spec.bollinger_std_dev = spec.bollinger_std_dev
+        cpp_spec.atr = spec.atr
+        cpp_spec.atr_period = spec.atr_period
+        cpp_spec.obv = spec.obv
+        cpp_spec.vwap = spec.vwap
+        cpp_spec.vwap_session_seconds = spec.vwap_session_seconds
+        cpp_spec.vwap_session_offset = spec.vwap_session_offset
+        cpp_spec.mfi = spec.mfi
+        cpp_spec.mfi_period = spec.mfi_period
+        cpp_spec.volume_sma = spec.volume_sma
+        cpp_spec.volume_sma_period = spec.volume_sma_period
+        cpp_spec.moving_averages = (
+            [CppMovingAverageSpec(CppMovingAverageType.SMA, p) for p in spec.sma_periods] +
+            [CppMovingAverageSpec(CppMovingAverageType.EMA, p) for p in spec.ema_periods]
+        )
+        return cpp_spec
+    
+    def _compute_selected_indicators_python(self, price_data: PriceData, spec: IndicatorSpec) -> Dict[str, float]:
+        """Python fallback implementation for selected indicator computation."""
+        from src.indicators.python_indicators import PythonIndicatorEngine
+        
+        closes = [bar.close for bar in price_data.bars]
+        result: Dict[str, float] = {}
+        try:
+            if spec.rsi:
+                result['rsi'] = PythonIndicatorEngine.compute_rsi(closes, spec.rsi_period)
+            if spec.macd:
+                macd = PythonIndicatorEngine.compute_macd(
+                    closes, spec.macd_fast_period, spec.macd_slow_period, spec.macd_signal_period
+                )
+                result['macd_line'] = macd.macd_line
+                result['signal_line'] = macd.signal_line
+                result['histogram'] = macd.histogram
+            if spec.bollinger:
+                bands = PythonIndicatorEngine.compute_bollinger_bands(
+                    closes, spec.bollinger_period, spec.bollinger_std_dev
+                )
+                result['bb_upper'] = bands.upper
+                result['bb_middle'] = bands.middle
+                result['bb_lower'] = bands.lower
+            if spec.atr:
+                result['atr'] = PythonIndicatorEngine.compute_atr(price_data.bars, spec.atr_period)
+            if spec.obv:
+                result['obv'] = PythonIndicatorEngine.compute_obv(price_data.bars)
+            if spec.vwap:
+                result['vwap'] = PythonIndicatorEngine.compute_vwap(
+                    price_data.bars, spec.vwap_session_seconds, spec.vwap_session_offset
+                )
+            if spec.mfi:
+                result['mfi'] = PythonIndicatorEngine.compute_mfi(price_data.bars, spec.mfi_period)
+            if spec.volume_sma:
+                result['volume_sma'] = PythonIndicatorEngine.compute_volume_sma(
+                    price_data.bars, spec.volume_sma_period
+                )
+            for period in spec.sma_periods:
+                result[f'sma_{period}'] = PythonIndicatorEngine.compute_sma(closes, period)
+            for period in spec.ema_periods:
+                result[f'ema_{period}'] = PythonIndicatorEngine.compute_ema(closes, period)
+        except Exception as e:
+            raise ValueError(f"Failed to compute indicators: {str(e)}")
+        return result
+    
     def _compute_indicators_python(self, price_data: PriceData) -> IndicatorResults:
         """Python fallback implementation for indicator computation."""
         from src.indicators.python_indicators import PythonIndicatorEngine
         return PythonIndicatorEngine.compute_indicators(price_data)
     
+    def _try_compute_indicators_python(self, price_data: PriceData) -> IndicatorComputation:
+        """Python fallback for try_compute_indicators."""
+        from src.indicators.python_indicators import PythonIndicatorEngine
+        bars = price_data.bars
+        closes = [bar.close for bar in bars]
+        valid = {field: len(bars) >= count for field, count in _RESULT_FIELD_BARS.items()}
+        nan = float('nan')
+        
+        results = IndicatorResults(
+            rsi=PythonIndicatorEngine.compute_rsi(closes, 14) if valid['rsi'] else nan,
+            macd=(PythonIndicatorEngine.compute_macd(closes, 12, 26, 9) if valid['macd']
+                  else MACDResult(macd_line=nan, signal_line=nan, histogram=nan)),
+            bollinger=(PythonIndicatorEngine.compute_bollinger_bands(closes, 20, 2.0) if valid['bollinger']
+                       else BollingerBands(upper=nan, middle=nan, lower=nan)),
+            sma_20=PythonIndicatorEngine.compute_sma(closes, 20) if valid['sma_20'] else nan,
+            sma_50=PythonIndicatorEngine.compute_sma(closes, 50) if valid['sma_50'] else nan,
+            ema_12=PythonIndicatorEngine.compute_ema(closes, 12) if valid['ema_12'] else nan,
+            ema_26=PythonIndicatorEngine.compute_ema(closes, 26) if valid['ema_26'] else nan,
+            atr=PythonIndicatorEngine.compute_atr(bars, 14) if valid['atr'] else nan,
+        )
+        
+        if all(valid.values()):
+            status = 'ok'
+        elif any(valid.values()):
+            status = 'partial'
+        else:
+            status = 'insufficient_data'
+        return IndicatorComputation(status=status, results=results, valid=valid)
+    
     def _generate_signals_python(self, indicators: IndicatorResults, current_price: float) -> TechnicalSignals:
         """Python fallback implementation for signal generation."""
         # RSI signals
@@ -215,3 +966,631 @@ class TechnicalIndicatorEngine:
             macd_signal=macd_signal,
             bb_signal=bb_signal,
         )
+
+
+class IncrementalIndicatorState:
+    """
+    Per-symbol streaming indicator state.
+    
+    Wraps the C++ IncrementalIndicatorState, which updates every indicator
+    in O(1) per bar. Falls back to recomputing over the accumulated bars
+    with the Python engine when the C++ module is unavailable.
+    """
+    
+    MIN_BARS = 50
+    
+    def __init__(self, symbol: str, vwap_session_seconds: int = 86400, vwap_session_offset: int = 0):
+        """
+        Initialize streaming state.
+        
+        Args:
+            symbol: Stock symbol this state tracks
+            vwap_session_seconds: VWAP session length, as in IndicatorSpec
+            vwap_session_offset: VWAP session start offset, as in IndicatorSpec
+        """
+        if vwap_session_seconds <= 0:
+            raise ValueError("VWAP session length must be positive")
+        self.symbol = symbol
+        self._engine = TechnicalIndicatorEngine()
+        self._vwap_session = (vwap_session_seconds, vwap_session_offset)
+        if CPP_AVAILABLE:
+            self._state = CppIncrementalIndicatorState(vwap_session_seconds, vwap_session_offset)
+        else:
+            self._state = None
+            self._bars: List[OHLC] = []
+        self._last_bar: Optional[OHLC] = None
+    
+    @property
+    def bar_count(self) -> int:
+        """Number of bars pushed so far."""
+        if self._state is not None:
+            return self._state.bar_count()
+        return len(self._bars)
+    
+    @property
+    def ready(self) -> bool:
+        """Whether enough bars have been pushed to produce results."""
+        return self.bar_count >= self.MIN_BARS
+    
+    @property
+    def last_bar(self) -> Optional[OHLC]:
+        """Most recent bar, or None if no bars were pushed."""
+        return self._last_bar
+    
+    def push_bar(self, bar: OHLC) -> None:
+        """
+        Append a new closed or forming bar.
+        
+        Args:
+            bar: New OHLC bar
+        """
+        if self._state is not None:
+            self._state.push_bar(self._engine._convert_ohlc_to_cpp(bar))
+        else:
+            self._bars.append(bar)
+        self._last_bar = bar
+    
+    def update_last_bar(self, bar: OHLC) -> None:
+        """
+        Replace the most recent bar, e.g. with a revised forming bar.
+        
+        Args:
+            bar: Revised OHLC bar
+            
+        Raises:
+            ValueError: If no bar has been pushed yet
+        """
+        if self._last_bar is None:
+            raise ValueError("No bar to update")
+        if self._state is not None:
+            self._state.update_last_bar(self._engine._convert_ohlc_to_cpp(bar))
+        else:
+            self._bars[-1] = bar
+        self._last_bar = bar
+    
+    def apply_tick(self, price: float, volume: int = 0) -> None:
+        """
+        Fold one trade into the forming (most recent) bar.
+        
+        The close moves to price, high and low widen to include it and
+        volume is added. Only the forming bar's contribution is
+        recomputed, so intrabar indicators can be refreshed at tick rate.
+        
+        Args:
+            price: Trade price
+            volume: Trade size
+        
+        Raises:
+            ValueError: If no bar has been pushed yet
+        """
+        if self._last_bar is None:
+            raise ValueError("No bar to update")
+        last = self._last_bar
+        bar = replace(
+            last,
+            high=max(last.high, price),
+            low=min(last.low, price),
+            close=price,
+            volume=last.volume + volume
+        )
+        if self._state is not None:
+            self._state.apply_tick(price, volume)
+        else:
+            self._bars[-1] = bar
+        self._last_bar = bar
+    
+    def results(self) -> IndicatorResults:
+        """
+        Current indicator values.
+        
+        Returns:
+            IndicatorResults for all bars pushed so far
+            
+        Raises:
+            ValueError: If fewer than MIN_BARS bars have been pushed
+        """
+        if self._state is None:
+            timestamp = self._last_bar.timestamp if self._last_bar else datetime.now()
+            price_data = PriceData(symbol=self.symbol, bars=list(self._bars), timestamp=timestamp)
+            return self._engine._compute_indicators_python(price_data)
+        
+        try:
+            return self._engine._convert_cpp_results_to_python(self._state.results())
+        except Exception as e:
+            raise ValueError(f"Failed to compute indicators: {str(e)}")
+    
+    def volume_indicators(self) -> Dict[str, float]:
+        """
+        Current volume indicator values.
+        
+        Returns:
+            Dictionary with obv, vwap (of the last bar's session), mfi
+            (period 14) and volume_sma (period 20)
+        
+        Raises:
+            ValueError: If fewer than MIN_BARS bars have been pushed
+        """
+        if self._state is None:
+            from src.indicators.python_indicators import PythonIndicatorEngine
+            if not self.ready:
+                raise ValueError(f"Insufficient data: need at least {self.MIN_BARS} bars")
+            return {
+                'obv': PythonIndicatorEngine.compute_obv(self._bars),
+                'vwap': PythonIndicatorEngine.compute_vwap(self._bars, *self._vwap_session),
+                'mfi': PythonIndicatorEngine.compute_mfi(self._bars, 14),
+                'volume_sma': PythonIndicatorEngine.compute_volume_sma(self._bars, 20),
+            }
+        
+        try:
+            values = self._state.volume_indicators()
+        except Exception as e:
+            raise ValueError(f"Failed to compute indicators: {str(e)}")
+        return {
+            'obv': values.obv,
+            'vwap': values.vwap,
+            'mfi': values.mfi,
+            'volume_sma': values.volume_sma,
+        }
+
+    def snapshot(self) -> bytes:
+        """
+        Encode the whole state as a compact, versioned binary snapshot.
+        
+        Restoring the snapshot and pushing the bars that arrived since
+        gives exactly the indicators of a state that never stopped, so a
+        restarted worker does not have to replay the full history.
+        
+        Returns:
+            Snapshot bytes for restore()
+        
+        Raises:
+            NotImplementedError: If the C++ module is not available
+        """
+        if self._state is None:
+            raise NotImplementedError("State snapshots require the C++ indicators engine")
+        return self._state.snapshot()
+    
+    @classmethod
+    def restore(cls, symbol: str, data: bytes) -> "IncrementalIndicatorState":
+        """
+        Rebuild a state from snapshot().
+        
+        Args:
+            symbol: Stock symbol the state tracks
+            data: Snapshot bytes
+        
+        Returns:
+            Restored state; last_bar carries a UTC timestamp
+        
+        Raises:
+            NotImplementedError: If the C++ module is not available
+            ValueError: If the snapshot is truncated, corrupted or from
+                another snapshot version
+        """
+        if not CPP_AVAILABLE:
+            raise NotImplementedError("State snapshots require the C++ indicators engine")
+        try:
+            cpp_state = CppIncrementalIndicatorState.restore(data)
+        except Exception as e:
+            raise ValueError(f"Failed to restore indicator state: {str(e)}")
+        
+        state = cls(symbol)
+        state._state = cpp_state
+        if cpp_state.bar_count() > 0:
+            bar = cpp_state.last_bar()
+            state._last_bar = OHLC(
+                open=bar.open,
+                high=bar.high,
+                low=bar.low,
+                close=bar.close,
+                volume=bar.volume,
+                timestamp=datetime.fromtimestamp(bar.timestamp, tz=timezone.utc),
+            )
+        return state
+
+
+class MultiTimeframeIndicatorState:
+    """
+    Streaming indicator state for several timeframes of one bar feed.
+    
+    Base bars (or ticks) are rolled into every timeframe at once: a
+    timeframe of s seconds buckets bars by floor((timestamp - offset) / s),
+    and its forming bar is revised as base bars arrive and closes when the
+    first bar of a later bucket comes in. Each timeframe keeps its own
+    incremental indicators. Uses the C++ BarAggregator when available and
+    otherwise aggregates in Python over IncrementalIndicatorState.
+    """
+    
+    def __init__(self, symbol: str, timeframes: Sequence[Union[int, timedelta]],
+                 offset_seconds: int = 0):
+        """
+        Initialize multi-timeframe state.
+        
+        Args:
+            symbol: Stock symbol this state tracks
+            timeframes: Bucket lengths, as seconds or timedeltas
+            offset_seconds: Shift of the bucket boundaries from the Unix epoch
+        
+        Raises:
+            ValueError: If no timeframe is given or one is not positive
+        """
+        self.symbol = symbol
+        self.timeframes = [
+            int(tf.total_seconds()) if isinstance(tf, timedelta) else int(tf) for tf in timeframes
+        ]
+        if not self.timeframes:
+            raise ValueError("At least one timeframe is required")
+        if any(tf <= 0 for tf in self.timeframes):
+            raise ValueError("Timeframe length must be positive")
+        self.offset_seconds = offset_seconds
+        self._engine = TechnicalIndicatorEngine()
+        self._last_base: Optional[OHLC] = None
+        
+        if CPP_AVAILABLE:
+            self._aggregator = CppBarAggregator(self.timeframes, offset_seconds)
+        else:
+            self._aggregator = None
+            count = len(self.timeframes)
+            self._states = [IncrementalIndicatorState(symbol) for _ in range(count)]
+            self._buckets: List[Optional[int]] = [None] * count
+            self._committed: List[Optional[OHLC]] = [None] * count
+            self._closed: List[Optional[OHLC]] = [None] * count
+            self._closed_results: List[Optional[IndicatorResults]] = [None] * count
+    
+    def _index(self, timeframe: Union[int, timedelta]) -> int:
+        seconds = int(timeframe.total_seconds()) if isinstance(timeframe, timedelta) else int(timeframe)
+        try:
+            return self.timeframes.index(seconds)
+        except ValueError:
+            raise KeyError(f"No {seconds}s timeframe")
+    
+    def _bucket_start(self, timestamp: int, seconds: int) -> int:
+        return (timestamp - self.offset_seconds) // seconds * seconds + self.offset_seconds
+    
+    def _from_cpp_bar(self, bar: CppOHLC) -> OHLC:
+        # Bucket starts are expressed relative to the last base bar, keeping its tzinfo
+        shift = int(self._last_base.timestamp.timestamp()) - bar.timestamp
+        return OHLC(
+            open=bar.open,
+            high=bar.high,
+            low=bar.low,
+            close=bar.close,
+            volume=bar.volume,
+            timestamp=self._last_base.timestamp - timedelta(seconds=shift),
+        )
+    
+    @staticmethod
+    def _merge(bucket: OHLC, bar: OHLC) -> OHLC:
+        return OHLC(
+            open=bucket.open,
+            high=max(bucket.high, bar.high),
+            low=min(bucket.low, bar.low),
+            close=bar.close,
+            volume=bucket.volume + bar.volume,
+            timestamp=bucket.timestamp,
+        )
+    
+    def push_bar(self, bar: OHLC) -> List[int]:
+        """
+        Feed the next base bar.
+        
+        Args:
+            bar: Base OHLC bar, not older than the previous one
+        
+        Returns:
+            Timeframes (seconds) whose bar this push closed
+        
+        Raises:
+            ValueError: If the bar is older than the previous base bar
+        """
+        if self._last_base is not None and bar.timestamp < self._last_base.timestamp:
+            raise ValueError("Base bars must arrive in timestamp order")
+        
+        if self._aggregator is not None:
+            self._last_base = bar
+            closed = self._aggregator.push_bar(self._engine._convert_ohlc_to_cpp(bar))
+            return [self.timeframes[i] for i in closed]
+        
+        closed = []
+        timestamp = int(bar.timestamp.timestamp())
+        for i, seconds in enumerate(self.timeframes):
+            start = self._bucket_start(timestamp, seconds)
+            state = self._states[i]
+            if start == self._buckets[i]:
+                self._committed[i] = state.last_bar
+                state.update_last_bar(self._merge(self._committed[i], bar))
+                continue
+            
+            if self._buckets[i] is not None:
+                self._closed[i] = state.last_bar
+                self._closed_results[i] = state.results() if state.ready else None
+                closed.append(seconds)
+            self._buckets[i] = start
+            self._committed[i] = None
+            state.push_bar(replace(bar, timestamp=bar.timestamp - timedelta(seconds=timestamp - start)))
+        self._last_base = bar
+        return closed
+    
+    def update_last_bar(self, bar: OHLC) -> None:
+        """
+        Revise the most recent base bar.
+        
+        Args:
+            bar: Revised base bar with the same timestamp
+        
+        Raises:
+            ValueError: If no bar was pushed or the timestamp differs
+        """
+        if self._last_base is None:
+            raise ValueError("No bar to update")
+        if bar.timestamp != self._last_base.timestamp:
+            raise ValueError("A revised base bar must keep its timestamp")
+        
+        if self._aggregator is not None:
+            self._aggregator.update_last_bar(self._engine._convert_ohlc_to_cpp(bar))
+        else:
+            for i, state in enumerate(self._states):
+                committed = self._committed[i]
+                if committed is not None:
+                    state.update_last_bar(self._merge(committed, bar))
+                else:
+                    state.update_last_bar(replace(bar, timestamp=state.last_bar.timestamp))
+        self._last_base = bar
+    
+    def push_tick(self, timestamp: datetime, price: float, volume: int) -> List[int]:
+        """
+        Feed one trade as a single-price base bar.
+        
+        Returns:
+            Timeframes (seconds) whose bar this tick closed
+        """
+        return self.push_bar(OHLC(
+            open=price, high=price, low=price, close=price, volume=volume, timestamp=timestamp
+        ))
+    
+    def bar_count(self, timeframe: Union[int, timedelta]) -> int:
+        """Number of bars of a timeframe, including the forming one."""
+        index = self._index(timeframe)
+        if self._aggregator is not None:
+            return self._aggregator.state(index).bar_count()
+        return self._states[index].bar_count
+    
+    def ready(self, timeframe: Union[int, timedelta]) -> bool:
+        """Whether a timeframe has enough bars to produce results."""
+        return self.bar_count(timeframe) >= IncrementalIndicatorState.MIN_BARS
+    
+    def current_bar(self, timeframe: Union[int, timedelta]) -> Optional[OHLC]:
+        """Forming bar of a timeframe, or None if no bars were pushed."""
+        index = self._index(timeframe)
+        if self._last_base is None:
+            return None
+        if self._aggregator is not None:
+            return self._from_cpp_bar(self._aggregator.current_bar(index))
+        return self._states[index].last_bar
+    
+    def last_closed_bar(self, timeframe: Union[int, timedelta]) -> Optional[OHLC]:
+        """Most recently closed bar of a timeframe, or None before the first close."""
+        index = self._index(timeframe)
+        if self._aggregator is not None:
+            if not self._aggregator.has_closed_bar(index):
+                return None
+            return self._from_cpp_bar(self._aggregator.last_closed_bar(index))
+        return self._closed[index]
+    
+    def results(self, timeframe: Union[int, timedelta]) -> IndicatorResults:
+        """
+        Indicator values of a timeframe, including its forming bar.
+        
+        Raises:
+            ValueError: If the timeframe has fewer than MIN_BARS bars
+        """
+        index = self._index(timeframe)
+        if self._aggregator is None:
+            return self._states[index].results()
+        try:
+            return self._engine._convert_cpp_results_to_python(self._aggregator.state(index).results())
+        except Exception as e:
+            raise ValueError(f"Failed to compute indicators: {str(e)}")
+    
+    def closed_results(self, timeframe: Union[int, timedelta]) -> IndicatorResults:
+        """
+        Indicator values of a timeframe as of its last close.
+        
+        Raises:
+            ValueError: If the timeframe had fewer than MIN_BARS bars at its last close
+        """
+        index = self._index(timeframe)
+        if self._aggregator is None:
+            if self._closed_results[index] is None:
+                raise ValueError("Insufficient data: need at least 50 closed bars")
+            return self._closed_results[index]
+        try:
+            return self._engine._convert_cpp_results_to_python(self._aggregator.closed_results(index))
+        except Exception as e:
+            raise ValueError(f"Failed to compute indicators: {str(e)}")
+
+# Regime base scores, as in SignalAggregator._normalize_regime
+_REGIME_SCORES = {
+    RegimeType.TRENDING_UP: 1.0,
+    RegimeType.TRENDING_DOWN: -1.0,
+    RegimeType.RANGING: 0.0,
+    RegimeType.VOLATILE: -0.3,
+    RegimeType.CALM: 0.2,
+}
+
+
+class CompositeScorer:
+    """
+    Composite Market Score straight from price data.
+    
+    With the C++ module, indicators, technical signals, the normalized
+    technical score and the weighted CMS are computed in native code without
+    building intermediate Python IndicatorResults. Scores equal those of
+    SignalAggregator.compute_cms for the same inputs and weights.
+    """
+    
+    def __init__(
+        self,
+        weight_sentiment: Optional[float] = None,
+        weight_technical: Optional[float] = None,
+        weight_regime: Optional[float] = None
+    ):
+        """
+        Initialize the scorer.
+        
+        Args:
+            weight_sentiment: Weight for sentiment component (default from settings)
+            weight_technical: Weight for technical component (default from settings)
+            weight_regime: Weight for regime component (default from settings)
+        """
+        if None in (weight_sentiment, weight_technical, weight_regime):
+            from src.shared.config import settings
+            weight_sentiment = weight_sentiment if weight_sentiment is not None else settings.cms_weight_sentiment
+            weight_technical = weight_technical if weight_technical is not None else settings.cms_weight_technical
+            weight_regime = weight_regime if weight_regime is not None else settings.cms_weight_regime
+        
+        self._engine = TechnicalIndicatorEngine()
+        if self._engine._use_cpp:
+            self._scorer = CppCompositeScorer(weight_sentiment, weight_technical, weight_regime)
+            self.weights = {
+                'sentiment': self._scorer.weight_sentiment,
+                'technical': self._scorer.weight_technical,
+                'regime': self._scorer.weight_regime,
+            }
+        else:
+            self._scorer = None
+            total = weight_sentiment + weight_technical + weight_regime
+            if abs(total - 1.0) > 0.001:
+                weight_sentiment /= total
+                weight_technical /= total
+                weight_regime /= total
+            self.weights = {
+                'sentiment': weight_sentiment,
+                'technical': weight_technical,
+                'regime': weight_regime,
+            }
+    
+    def score(
+        self,
+        price_data: PriceData,
+        sentiment_score: float,
+        regime: MarketRegime
+    ) -> Tuple[TechnicalSignals, CompositeMarketScore]:
+        """
+        Compute the technical signals and CMS for one symbol.
+        
+        Args:
+            price_data: Price data with OHLC bars
+            sentiment_score: News sentiment in [-1, 1]
+            regime: Current market regime
+            
+        Returns:
+            Technical signals at the last close and the Composite Market Score
+            
+        Raises:
+            ValueError: If insufficient data or invalid input
+        """
+        return self.score_batch([price_data], [sentiment_score], [regime])[0]
+    
+    def score_batch(
+        self,
+        batch: List[PriceData],
+        sentiment_scores: Sequence[float],
+        regimes: Sequence[MarketRegime]
+    ) -> List[Tuple[TechnicalSignals, CompositeMarketScore]]:
+        """
+        Compute signals and CMS for many symbols at once.
+        
+        The C++ path computes the indicators on the engine thread pool and
+        scores every symbol in one native call.
+        
+        Args:
+            batch: Price data for each symbol
+            sentiment_scores: Sentiment score for each symbol
+            regimes: Market regime for each symbol
+            
+        Returns:
+            (signals, CMS) pairs in the same order as the input
+            
+        Raises:
+            ValueError: If the inputs differ in length or any symbol has
+                insufficient or invalid data
+        """
+        if not (len(batch) == len(sentiment_scores) == len(regimes)):
+            raise ValueError("Batch inputs must have the same length")
+        
+        if self._scorer is None:
+            return [
+                self._score_python(price_data, sentiment, regime)
+                for price_data, sentiment, regime in zip(batch, sentiment_scores, regimes)
+            ]
+        
+        engine = self._engine
+        try:
+            cpp_batch = [engine._convert_price_data_to_cpp(price_data) for price_data in batch]
+            cpp_results = engine._engine.compute_indicators_batch(cpp_batch)
+            contexts = [
+                CppMarketContext(float(sentiment), getattr(CppRegimeType, regime.regime_type.name),
+                                 float(regime.confidence))
+                for sentiment, regime in zip(sentiment_scores, regimes)
+            ]
+            current_prices = [price_data.bars[-1].close for price_data in batch]
+            scores = self._scorer.score_batch(cpp_results, current_prices, contexts)
+        except Exception as e:
+            raise ValueError(f"Failed to compute composite scores: {str(e)}")
+        
+        timestamp = datetime.now()
+        return [
+            (
+                engine._convert_cpp_signals_to_python(score.signals),
+                CompositeMarketScore(
+                    score=score.score,
+                    sentiment_component=score.sentiment_component,
+                    technical_component=score.technical_component,
+                    regime_component=score.regime_component,
+                    weights=dict(self.weights),
+                    timestamp=timestamp,
+                ),
+            )
+            for score in scores
+        ]
+    
+    def _score_python(
+        self,
+        price_data: PriceData,
+        sentiment_score: float,
+        regime: MarketRegime
+    ) -> Tuple[TechnicalSignals, CompositeMarketScore]:
+        """Python fallback implementation for composite scoring."""
+        indicators = self._engine.compute_indicators(price_data)
+        signals = self._engine.generate_signals(indicators, price_data.bars[-1].close)
+        
+        votes = {
+            TechnicalSignalType.OVERSOLD: 1.0,
+            TechnicalSignalType.BULLISH_CROSS: 1.0,
+            TechnicalSignalType.LOWER_BREACH: 1.0,
+            TechnicalSignalType.OVERBOUGHT: -1.0,
+            TechnicalSignalType.BEARISH_CROSS: -1.0,
+            TechnicalSignalType.UPPER_BREACH: -1.0,
+        }
+        technical = sum(
+            votes.get(signal, 0.0)
+            for signal in (signals.rsi_signal, signals.macd_signal, signals.bb_signal)
+        ) / 3.0
+        regime_score = _REGIME_SCORES.get(regime.regime_type, 0.0) * regime.confidence
+        
+        weights = self.weights
+        cms = (
+            weights['sentiment'] * sentiment_score +
+            weights['technical'] * technical +
+            weights['regime'] * regime_score
+        ) * 100
+        
+        return signals, CompositeMarketScore(
+            score=max(-100.0, min(100.0, cms)),
+            sentiment_component=sentiment_score * 100,
+            technical_component=technical * 100,
+            regime_component=regime_score * 100,
+            weights=dict(weights),
+            timestamp=datetime.now(),
+        )
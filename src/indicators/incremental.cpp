@@ -0,0 +1,385 @@
+#include "indicators.h"
+#include "simd_kernels.h"
+#include <cmath>
+#include <limits>
+
+namespace indicators {
+
+namespace {
+
+double true_range(const OHLC& bar, double prev_close) {
+    double high_low = bar.high - bar.low;
+    double high_close = std::abs(bar.high - prev_close);
+    double low_close = std::abs(bar.low - prev_close);
+    return std::max({high_low, high_close, low_close});
+}
+
+// Same expressions as the volume kernels, so the streaming values match
+// the batch ones exactly
+double typical_price(const OHLC& bar) {
+    return (bar.high + bar.low + bar.close) / 3.0;
+}
+
+double money_flow(const OHLC& bar, double prev_typical) {
+    double typical = typical_price(bar);
+    double flow = typical * static_cast<double>(bar.volume);
+    if (typical > prev_typical) {
+        return flow;
+    }
+    return typical < prev_typical ? -flow : 0.0;
+}
+
+// Slot of the most recent value in a ring after pushed values
+size_t last_slot(size_t pushed, size_t size) {
+    return (pushed - 1) % size;
+}
+
+} // namespace
+
+// EMA accumulator
+EmaAccumulator::EmaAccumulator(int period)
+    : period(period), multiplier(2.0 / (period + 1.0)), value(0.0), count(0) {
+    if (period <= 0) {
+        throw std::invalid_argument("EMA period must be positive");
+    }
+}
+
+void EmaAccumulator::add(double price) {
+    if (count < static_cast<size_t>(period)) {
+        // Accumulate the seed SMA
+        value += price;
+        ++count;
+        if (count == static_cast<size_t>(period)) {
+            value /= period;
+        }
+        return;
+    }
+    value = (price - value) * multiplier + value;
+    ++count;
+}
+
+// RSI accumulator
+RsiAccumulator::RsiAccumulator(int period)
+    : period(period), avg_gain(0.0), avg_loss(0.0), count(0) {
+    if (period <= 0) {
+        throw std::invalid_argument("RSI period must be positive");
+    }
+}
+
+void RsiAccumulator::add(double change) {
+    double gain = (change > 0) ? change : 0.0;
+    double loss = (change < 0) ? std::abs(change) : 0.0;
+    
+    if (count < static_cast<size_t>(period)) {
+        // Initial simple average of the first period changes
+        avg_gain += gain;
+        avg_loss += loss;
+        ++count;
+        if (count == static_cast<size_t>(period)) {
+            avg_gain /= period;
+            avg_loss /= period;
+        }
+        return;
+    }
+    avg_gain = (avg_gain * (period - 1) + gain) / period;
+    avg_loss = (avg_loss * (period - 1) + loss) / period;
+    ++count;
+}
+
+double RsiAccumulator::value() const {
+    if (avg_loss == 0.0) {
+        return 100.0;
+    }
+    double rs = avg_gain / avg_loss;
+    return 100.0 - (100.0 / (1.0 + rs));
+}
+
+// Rolling moments
+void RollingMoments::add(double value) {
+    ++count_;
+    double delta = value - mean_;
+    mean_ += delta / count_;
+    m2_ += delta * (value - mean_);
+}
+
+void RollingMoments::replace(double previous, double value) {
+    double delta = value - previous;
+    double old_mean = mean_;
+    mean_ += delta / count_;
+    m2_ += delta * ((value - mean_) + (previous - old_mean));
+}
+
+void RollingMoments::reset(const double* values, size_t n) {
+    count_ = n;
+    if (n == 0) {
+        mean_ = 0.0;
+        m2_ = 0.0;
+        return;
+    }
+    mean_ = simd::sum(values, n) / n;
+    m2_ = simd::sum_squared_deviations(values, n, mean_);
+}
+
+double RollingMoments::variance() const {
+    if (count_ == 0) {
+        return 0.0;
+    }
+    // Rounding can leave a constant window slightly negative
+    return m2_ > 0.0 ? m2_ / count_ : 0.0;
+}
+
+// Rolling window
+RollingWindow::RollingWindow(int period)
+    : head_(0), count_(0), updates_since_reset_(0) {
+    if (period <= 0) {
+        throw std::invalid_argument("Window period must be positive");
+    }
+    values_.assign(static_cast<size_t>(period), 0.0);
+}
+
+void RollingWindow::push(double value) {
+    if (full()) {
+        moments_.replace(values_[head_], value);
+    } else {
+        moments_.add(value);
+        ++count_;
+    }
+    values_[head_] = value;
+    head_ = (head_ + 1) % values_.size();
+    reanchor_if_due();
+}
+
+void RollingWindow::replace_last(double value) {
+    if (count_ == 0) {
+        throw std::runtime_error("No value to replace in rolling window");
+    }
+    size_t last = (head_ + values_.size() - 1) % values_.size();
+    moments_.replace(values_[last], value);
+    values_[last] = value;
+    reanchor_if_due();
+}
+
+// Recompute the moments once per window length of updates: O(period) work
+// every period updates keeps push O(1) amortized and the drift bounded.
+// Until the window fills, its values occupy values_[0, count_).
+void RollingWindow::reanchor_if_due() {
+    if (++updates_since_reset_ < values_.size()) {
+        return;
+    }
+    moments_.reset(values_.data(), count_);
+    updates_since_reset_ = 0;
+}
+
+double RollingWindow::mean() const {
+    return moments_.mean();
+}
+
+// Population standard deviation of the window
+double RollingWindow::std_dev() const {
+    return std::sqrt(moments_.variance());
+}
+
+// Incremental indicator state
+IncrementalIndicatorState::IncrementalIndicatorState()
+    : IncrementalIndicatorState(86400, 0) {}
+
+IncrementalIndicatorState::IncrementalIndicatorState(int64_t vwap_session_seconds,
+                                                     int64_t vwap_session_offset)
+    : closes_20_(20),
+      closes_50_(50),
+      true_ranges_(14),
+      money_flows_(14, 0.0),
+      flows_pushed_(0),
+      volumes_(20, 0),
+      volumes_pushed_(0),
+      volume_sum_(0),
+      session_seconds_(vwap_session_seconds),
+      session_offset_(vwap_session_offset),
+      last_bar_{} {
+    if (vwap_session_seconds <= 0) {
+        throw std::invalid_argument("VWAP session length must be positive");
+    }
+    committed_.ema_fast = EmaAccumulator(12);
+    committed_.ema_slow = EmaAccumulator(26);
+    committed_.macd_signal = EmaAccumulator(9);
+    committed_.rsi = RsiAccumulator(14);
+    committed_.macd_line = 0.0;
+    committed_.last_close = 0.0;
+    committed_.obv = 0;
+    committed_.session = 0;
+    committed_.session_price_volume = 0.0;
+    committed_.session_volume = 0.0;
+    committed_.last_typical = 0.0;
+    committed_.bar_count = 0;
+    current_ = committed_;
+}
+
+// Advance the recursive indicators by one bar
+void IncrementalIndicatorState::apply_bar(RecursiveState& state, const OHLC& bar) const {
+    if (state.bar_count > 0) {
+        state.rsi.add(bar.close - state.last_close);
+        if (bar.close > state.last_close) {
+            state.obv += bar.volume;
+        } else if (bar.close < state.last_close) {
+            state.obv -= bar.volume;
+        }
+    }
+    
+    state.ema_fast.add(bar.close);
+    state.ema_slow.add(bar.close);
+    
+    // MACD history starts once the slow EMA has one smoothed value,
+    // matching TechnicalIndicatorEngine::compute_macd
+    if (state.bar_count >= static_cast<size_t>(state.ema_slow.period)) {
+        state.macd_line = state.ema_fast.value - state.ema_slow.value;
+        state.macd_signal.add(state.macd_line);
+    }
+    
+    // VWAP sums restart with each session
+    const int64_t session = session_of(bar.timestamp, session_seconds_, session_offset_);
+    if (state.bar_count == 0 || session != state.session) {
+        state.session = session;
+        state.session_price_volume = 0.0;
+        state.session_volume = 0.0;
+    }
+    const double typical = typical_price(bar);
+    state.session_price_volume += typical * static_cast<double>(bar.volume);
+    state.session_volume += static_cast<double>(bar.volume);
+    
+    state.last_close = bar.close;
+    state.last_typical = typical;
+    ++state.bar_count;
+}
+
+void IncrementalIndicatorState::push_bar(const OHLC& bar) {
+    committed_ = current_;
+    apply_bar(current_, bar);
+    
+    closes_20_.push(bar.close);
+    closes_50_.push(bar.close);
+    if (committed_.bar_count > 0) {
+        true_ranges_.push(true_range(bar, committed_.last_close));
+        money_flows_[flows_pushed_ % money_flows_.size()] =
+            money_flow(bar, committed_.last_typical);
+        ++flows_pushed_;
+    }
+    
+    size_t slot = volumes_pushed_ % volumes_.size();
+    if (volumes_pushed_ >= volumes_.size()) {
+        volume_sum_ -= volumes_[slot];
+    }
+    volumes_[slot] = bar.volume;
+    volume_sum_ += bar.volume;
+    ++volumes_pushed_;
+    
+    last_bar_ = bar;
+}
+
+void IncrementalIndicatorState::update_last_bar(const OHLC& bar) {
+    if (current_.bar_count == 0) {
+        throw std::runtime_error("No bar to update");
+    }
+    
+    // Only what reads the revised fields is recomputed: ticks that leave
+    // the close alone (a volume print, a new high or low) keep the close
+    // windows, and the recursive state is kept when only the open moved
+    const bool close_changed = bar.close != last_bar_.close;
+    const bool range_changed =
+        close_changed || bar.high != last_bar_.high || bar.low != last_bar_.low;
+    const bool volume_changed = bar.volume != last_bar_.volume;
+    if (range_changed || volume_changed || bar.timestamp != last_bar_.timestamp) {
+        current_ = committed_;
+        apply_bar(current_, bar);
+    }
+    if (close_changed) {
+        closes_20_.replace_last(bar.close);
+        closes_50_.replace_last(bar.close);
+    }
+    if (committed_.bar_count > 0 && range_changed) {
+        true_ranges_.replace_last(true_range(bar, committed_.last_close));
+    }
+    if (committed_.bar_count > 0 && (range_changed || volume_changed)) {
+        money_flows_[last_slot(flows_pushed_, money_flows_.size())] =
+            money_flow(bar, committed_.last_typical);
+    }
+    if (volume_changed) {
+        int64_t& last = volumes_[last_slot(volumes_pushed_, volumes_.size())];
+        volume_sum_ += bar.volume - last;
+        last = bar.volume;
+    }
+    
+    last_bar_ = bar;
+}
+
+void IncrementalIndicatorState::apply_tick(double price, int64_t volume) {
+    if (current_.bar_count == 0) {
+        throw std::runtime_error("No bar to update");
+    }
+    
+    OHLC bar = last_bar_;
+    bar.high = std::max(bar.high, price);
+    bar.low = std::min(bar.low, price);
+    bar.close = price;
+    bar.volume += volume;
+    update_last_bar(bar);
+}
+
+const OHLC& IncrementalIndicatorState::last_bar() const {
+    if (current_.bar_count == 0) {
+        throw std::runtime_error("No bars pushed");
+    }
+    return last_bar_;
+}
+
+IndicatorResults IncrementalIndicatorState::results() const {
+    if (!ready()) {
+        throw std::runtime_error("Insufficient data: need at least 50 bars");
+    }
+    
+    IndicatorResults results;
+    results.rsi = current_.rsi.value();
+    results.macd.macd_line = current_.macd_line;
+    results.macd.signal_line = current_.macd_signal.value;
+    results.macd.histogram = current_.macd_line - current_.macd_signal.value;
+    
+    double middle = closes_20_.mean();
+    double std = closes_20_.std_dev();
+    results.bollinger = BollingerBands{middle + 2.0 * std, middle, middle - 2.0 * std};
+    
+    results.sma_20 = middle;
+    results.sma_50 = closes_50_.mean();
+    results.ema_12 = current_.ema_fast.value;
+    results.ema_26 = current_.ema_slow.value;
+    results.atr = true_ranges_.mean();
+    return results;
+}
+
+VolumeIndicators IncrementalIndicatorState::volume_indicators() const {
+    if (!ready()) {
+        throw std::runtime_error("Insufficient data: need at least 50 bars");
+    }
+    
+    VolumeIndicators values;
+    values.obv = static_cast<double>(current_.obv);
+    values.vwap = current_.session_volume > 0.0
+                      ? current_.session_price_volume / current_.session_volume
+                      : std::numeric_limits<double>::quiet_NaN();
+    
+    // Oldest flow first, as compute_mfi sums them
+    double positive = 0.0;
+    double negative = 0.0;
+    const size_t size = money_flows_.size();
+    for (size_t k = 0; k < size; ++k) {
+        double flow = money_flows_[(flows_pushed_ + k) % size];
+        if (flow > 0.0) {
+            positive += flow;
+        } else {
+            negative -= flow;
+        }
+    }
+    values.mfi = negative <= 0.0 ? 100.0 : 100.0 - (100.0 / (1.0 + positive / negative));
+    values.volume_sma = static_cast<double>(volume_sum_) / static_cast<double>(volumes_.size());
+    return values;
+}
+
+} // namespace indicators
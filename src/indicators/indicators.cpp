@@ -1,149 +1,406 @@
 #include "indicators.h"
+#include "bar_series.h"
+#include "compact_bar_series.h"
+#include "profiling.h"
+#include "result_cache.h"
+#include "scratch_arena.h"
+#include "simd_kernels.h"
 #include <numeric>
 #include <cmath>
+#include <limits>
+#include <type_traits>
 
 namespace indicators {
 
-// Extract close prices from OHLC bars
-std::vector<double> TechnicalIndicatorEngine::extract_closes(const std::vector<OHLC>& bars) {
-    std::vector<double> closes;
-    closes.reserve(bars.size());
-    for (const auto& bar : bars) {
-        closes.push_back(bar.close);
-    }
-    return closes;
+TechnicalIndicatorEngine::TechnicalIndicatorEngine()
+    : cache_(std::make_shared<ResultCache>()) {}
+
+TechnicalIndicatorEngine::TechnicalIndicatorEngine(size_t num_threads)
+    : cache_(std::make_shared<ResultCache>()), pool_(std::make_shared<ThreadPool>(num_threads)) {}
+
+ThreadPool& TechnicalIndicatorEngine::pool() {
+    return pool_ ? *pool_ : *ThreadPool::shared();
 }
 
-// Compute standard deviation
-double TechnicalIndicatorEngine::compute_std_dev(const std::vector<double>& values, double mean) {
-    double sum_sq_diff = 0.0;
-    for (double val : values) {
-        double diff = val - mean;
-        sum_sq_diff += diff * diff;
+namespace {
+
+template <int N>
+using FixedPeriod = std::integral_constant<int, N>;
+
+// Call fn with the period as a compile-time constant for the common
+// settings, so their kernels get constant loop bounds and multipliers, and
+// as a plain int otherwise. Both run the same code and give identical
+// results.
+template <typename Fn>
+double with_period(int period, Fn&& fn) {
+    switch (period) {
+        case 9:
+            return fn(FixedPeriod<9>{});
+        case 12:
+            return fn(FixedPeriod<12>{});
+        case 14:
+            return fn(FixedPeriod<14>{});
+        case 20:
+            return fn(FixedPeriod<20>{});
+        case 26:
+            return fn(FixedPeriod<26>{});
+        case 50:
+            return fn(FixedPeriod<50>{});
+        default:
+            return fn(period);
     }
-    return std::sqrt(sum_sq_diff / values.size());
 }
 
-// Simple Moving Average
-double TechnicalIndicatorEngine::compute_sma(const std::vector<double>& prices, int period) {
-    if (prices.size() < static_cast<size_t>(period)) {
-        throw std::invalid_argument("Insufficient data for SMA calculation");
+// EMA recurrence, seeded with the SMA of the first period values. Every
+// EMA in this file (standalone, MACD legs and signal, fused pass) steps
+// through this one definition, so they agree bit for bit.
+template <typename Period>
+struct EmaState {
+    Period period{};
+    double multiplier = 0.0;
+    double value = 0.0;
+    
+    EmaState() = default;
+    explicit EmaState(Period p) : period(p), multiplier(2.0 / (p + 1.0)) {}
+    
+    // Feed the index-th input value
+    void step(size_t index, double x) {
+        if (index < static_cast<size_t>(period)) {
+            value += x;
+            if (index + 1 == static_cast<size_t>(period)) {
+                value /= period;
+            }
+        } else {
+            value = (x - value) * multiplier + value;
+        }
     }
+};
+
+// RSI averages with Wilder smoothing, seeded with the plain average of the
+// first period changes
+template <typename Period>
+struct RsiState {
+    Period period{};
+    double avg_gain = 0.0;
+    double avg_loss = 0.0;
     
-    double sum = 0.0;
-    for (size_t i = prices.size() - period; i < prices.size(); ++i) {
-        sum += prices[i];
+    explicit RsiState(Period p) : period(p) {}
+    
+    // Feed the change from bar index - 1 to bar index (index >= 1)
+    void step(size_t index, double change) {
+        if (index <= static_cast<size_t>(period)) {
+            if (change > 0) {
+                avg_gain += change;
+            } else {
+                avg_loss += std::abs(change);
+            }
+            if (index == static_cast<size_t>(period)) {
+                avg_gain /= period;
+                avg_loss /= period;
+            }
+        } else {
+            double gain = (change > 0) ? change : 0.0;
+            double loss = (change < 0) ? std::abs(change) : 0.0;
+            avg_gain = (avg_gain * (period - 1) + gain) / period;
+            avg_loss = (avg_loss * (period - 1) + loss) / period;
+        }
     }
-    return sum / period;
+    
+    double value() const {
+        if (avg_loss == 0.0) {
+            return 100.0;
+        }
+        double rs = avg_gain / avg_loss;
+        return 100.0 - (100.0 / (1.0 + rs));
+    }
+};
+
+template <typename Period>
+double ema_kernel(PriceView prices, Period period) {
+    EmaState<Period> ema(period);
+    for (size_t i = 0; i < prices.size(); ++i) {
+        ema.step(i, prices[i]);
+    }
+    return ema.value;
 }
 
-// Exponential Moving Average
-double TechnicalIndicatorEngine::compute_ema(const std::vector<double>& prices, int period) {
-    if (prices.size() < static_cast<size_t>(period)) {
-        throw std::invalid_argument("Insufficient data for EMA calculation");
+template <typename Period>
+double rsi_kernel(PriceView prices, Period period) {
+    RsiState<Period> rsi(period);
+    for (size_t i = 1; i < prices.size(); ++i) {
+        rsi.step(i, prices[i] - prices[i - 1]);
+    }
+    return rsi.value();
+}
+
+// MACD pass behind compute_macd_pass, templated like ema_kernel
+template <typename Fast, typename Slow, typename Signal>
+MACDResult macd_kernel(PriceView prices,
+                       Fast fast_period,
+                       Slow slow_period,
+                       Signal signal_period,
+                       SeriesBuffer* macd_series,
+                       SeriesBuffer* signal_series,
+                       SeriesBuffer* histogram_series) {
+    const size_t slow = static_cast<size_t>(slow_period);
+    const size_t signal = static_cast<size_t>(signal_period);
+    
+    EmaState<Fast> fast_ema(fast_period);
+    EmaState<Slow> slow_ema(slow_period);
+    EmaState<Signal> signal_ema(signal_period);
+    double macd_line = 0.0;
+    size_t history_count = 0;
+    
+    for (size_t i = 0; i < prices.size(); ++i) {
+        fast_ema.step(i, prices[i]);
+        slow_ema.step(i, prices[i]);
+        if (i < slow) {
+            continue;
+        }
+        
+        // Signal line is the EMA of the MACD history
+        macd_line = fast_ema.value - slow_ema.value;
+        signal_ema.step(history_count++, macd_line);
+        
+        if (macd_series) {
+            (*macd_series)[i] = macd_line;
+            if (history_count >= signal) {
+                (*signal_series)[i] = signal_ema.value;
+                (*histogram_series)[i] = macd_line - signal_ema.value;
+            }
+        }
     }
     
-    // Calculate initial SMA as starting point
-    double ema = 0.0;
-    for (size_t i = 0; i < static_cast<size_t>(period); ++i) {
-        ema += prices[i];
+    return MACDResult{macd_line, signal_ema.value, macd_line - signal_ema.value};
+}
+
+// One walk over the prices advancing RSI, MACD, OBV and every EMA of the
+// spec together. EMAs whose period equals a MACD leg reuse that leg's
+// state. SMA, Bollinger Bands and the other volume indicators only read
+// the trailing window and are left to the caller. values must come from
+// empty_values(); volume may be empty unless spec.obv.
+template <typename RsiPeriod, typename Fast, typename Slow, typename Signal>
+void fused_close_pass(PriceView prices,
+                      ArrayView<int64_t> volume,
+                      const IndicatorSpec& spec,
+                      RsiPeriod rsi_period,
+                      Fast fast_period,
+                      Slow slow_period,
+                      Signal signal_period,
+                      IndicatorValues& values) {
+    const bool use_rsi = spec.rsi;
+    const bool use_macd = spec.macd;
+    const bool use_obv = spec.obv;
+    const size_t slow = static_cast<size_t>(slow_period);
+    
+    RsiState<RsiPeriod> rsi(rsi_period);
+    EmaState<Fast> fast_ema(fast_period);
+    EmaState<Slow> slow_ema(slow_period);
+    EmaState<Signal> signal_ema(signal_period);
+    double macd_line = 0.0;
+    size_t history_count = 0;
+    int64_t obv = 0;
+    
+    // Where each spec moving average reads its EMA from
+    enum Source { OWN, FAST, SLOW, NONE };
+    std::array<Source, IndicatorSpec::kMaxMovingAverages> sources;
+    std::array<size_t, IndicatorSpec::kMaxMovingAverages> slots;
+    std::array<EmaState<int>, IndicatorSpec::kMaxMovingAverages> emas;
+    size_t ema_count = 0;
+    for (size_t k = 0; k < spec.moving_averages.size(); ++k) {
+        const MovingAverageSpec& average = spec.moving_averages[k];
+        if (average.type != MovingAverageType::EMA) {
+            sources[k] = NONE;
+        } else if (use_macd && average.period == static_cast<int>(fast_period)) {
+            sources[k] = FAST;
+        } else if (use_macd && average.period == static_cast<int>(slow_period)) {
+            sources[k] = SLOW;
+        } else {
+            sources[k] = OWN;
+            slots[k] = ema_count;
+            emas[ema_count++] = EmaState<int>(average.period);
+        }
     }
-    ema /= period;
     
-    // Calculate EMA using smoothing factor
-    double multiplier = 2.0 / (period + 1.0);
-    for (size_t i = period; i < prices.size(); ++i) {
-        ema = (prices[i] - ema) * multiplier + ema;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        const double price = prices[i];
+        if (use_rsi && i > 0) {
+            rsi.step(i, price - prices[i - 1]);
+        }
+        if (use_obv && i > 0) {
+            if (price > prices[i - 1]) {
+                obv += volume[i];
+            } else if (price < prices[i - 1]) {
+                obv -= volume[i];
+            }
+        }
+        if (use_macd) {
+            fast_ema.step(i, price);
+            slow_ema.step(i, price);
+            if (i >= slow) {
+                macd_line = fast_ema.value - slow_ema.value;
+                signal_ema.step(history_count++, macd_line);
+            }
+        }
+        for (size_t k = 0; k < ema_count; ++k) {
+            emas[k].step(i, price);
+        }
     }
     
-    return ema;
+    if (use_rsi) {
+        values.rsi = rsi.value();
+    }
+    if (use_macd) {
+        values.macd = MACDResult{macd_line, signal_ema.value, macd_line - signal_ema.value};
+    }
+    if (use_obv) {
+        values.obv = static_cast<double>(obv);
+    }
+    for (size_t k = 0; k < spec.moving_averages.size(); ++k) {
+        double value = 0.0;
+        switch (sources[k]) {
+            case OWN:
+                value = emas[slots[k]].value;
+                break;
+            case FAST:
+                value = fast_ema.value;
+                break;
+            case SLOW:
+                value = slow_ema.value;
+                break;
+            case NONE:
+                continue;
+        }
+        values.moving_averages[k].value = value;
+    }
 }
 
-// Relative Strength Index
-double TechnicalIndicatorEngine::compute_rsi(const std::vector<double>& prices, int period) {
-    if (prices.size() < static_cast<size_t>(period + 1)) {
-        throw std::invalid_argument("Insufficient data for RSI calculation");
+} // namespace
+
+// Copy the high, low and close of OHLC bars into scratch columns, and the
+// volume and timestamp as well when with_volume
+BarColumns TechnicalIndicatorEngine::gather_columns(const std::vector<OHLC>& bars, ScratchArena& arena,
+                                                    bool with_volume) {
+    INDICATORS_PROFILE(GATHER_COLUMNS, bars.size());
+    const size_t n = bars.size();
+    double* high = arena.allocate<double>(n);
+    double* low = arena.allocate<double>(n);
+    double* close = arena.allocate<double>(n);
+    for (size_t i = 0; i < n; ++i) {
+        high[i] = bars[i].high;
+        low[i] = bars[i].low;
+        close[i] = bars[i].close;
     }
     
-    double avg_gain = 0.0;
-    double avg_loss = 0.0;
-    
-    // Calculate initial average gain and loss
-    for (size_t i = 1; i <= static_cast<size_t>(period); ++i) {
-        double change = prices[i] - prices[i - 1];
-        if (change > 0) {
-            avg_gain += change;
-        } else {
-            avg_loss += std::abs(change);
+    BarColumns columns;
+    columns.high = PriceView(high, n);
+    columns.low = PriceView(low, n);
+    columns.close = PriceView(close, n);
+    if (with_volume) {
+        int64_t* volume = arena.allocate<int64_t>(n);
+        int64_t* timestamp = arena.allocate<int64_t>(n);
+        for (size_t i = 0; i < n; ++i) {
+            volume[i] = bars[i].volume;
+            timestamp[i] = bars[i].timestamp;
         }
+        columns.volume = ArrayView<int64_t>(volume, n);
+        columns.timestamp = ArrayView<int64_t>(timestamp, n);
     }
-    avg_gain /= period;
-    avg_loss /= period;
-    
-    // Calculate RSI using smoothed averages
-    for (size_t i = period + 1; i < prices.size(); ++i) {
-        double change = prices[i] - prices[i - 1];
-        double gain = (change > 0) ? change : 0.0;
-        double loss = (change < 0) ? std::abs(change) : 0.0;
-        
-        avg_gain = (avg_gain * (period - 1) + gain) / period;
-        avg_loss = (avg_loss * (period - 1) + loss) / period;
+    return columns;
+}
+
+// Compute standard deviation
+double TechnicalIndicatorEngine::compute_std_dev(PriceView values, double mean) {
+    double sum_sq_diff = simd::sum_squared_deviations(values.data(), values.size(), mean);
+    return std::sqrt(sum_sq_diff / values.size());
+}
+
+// Simple Moving Average
+double TechnicalIndicatorEngine::compute_sma(PriceView prices, int period) {
+    INDICATORS_PROFILE(SMA, prices.size());
+    if (prices.size() < static_cast<size_t>(period)) {
+        throw std::invalid_argument("Insufficient data for SMA calculation");
     }
     
-    if (avg_loss == 0.0) {
-        return 100.0;
+    PriceView window = prices.last(period);
+    return simd::sum(window.data(), window.size()) / period;
+}
+
+// Exponential Moving Average
+double TechnicalIndicatorEngine::compute_ema(PriceView prices, int period) {
+    INDICATORS_PROFILE(EMA, prices.size());
+    if (prices.size() < static_cast<size_t>(period)) {
+        throw std::invalid_argument("Insufficient data for EMA calculation");
     }
-    
-    double rs = avg_gain / avg_loss;
-    return 100.0 - (100.0 / (1.0 + rs));
+    return with_period(period, [&](auto p) { return ema_kernel(prices, p); });
+}
+
+// Relative Strength Index
+double TechnicalIndicatorEngine::compute_rsi(PriceView prices, int period) {
+    INDICATORS_PROFILE(RSI, prices.size());
+    if (prices.size() < static_cast<size_t>(period + 1)) {
+        throw std::invalid_argument("Insufficient data for RSI calculation");
+    }
+    return with_period(period, [&](auto p) { return rsi_kernel(prices, p); });
 }
 
 // MACD (Moving Average Convergence Divergence)
-MACDResult TechnicalIndicatorEngine::compute_macd(const std::vector<double>& prices,
+MACDResult TechnicalIndicatorEngine::compute_macd(PriceView prices,
                                                   int fast_period,
                                                   int slow_period,
                                                   int signal_period) {
+    INDICATORS_PROFILE(MACD, prices.size());
+    return compute_macd_pass(prices, fast_period, slow_period, signal_period,
+                             nullptr, nullptr, nullptr);
+}
+
+// MACD with the full line, signal and histogram history
+MACDSeries TechnicalIndicatorEngine::compute_macd_series(PriceView prices,
+                                                         int fast_period,
+                                                         int slow_period,
+                                                         int signal_period) {
+    MACDSeries series;
+    series.macd_line.resize(prices.size());
+    series.signal_line.resize(prices.size());
+    series.histogram.resize(prices.size());
+    compute_macd_series(prices, series.macd_line, series.signal_line, series.histogram,
+                        fast_period, slow_period, signal_period);
+    return series;
+}
+
+// Single pass over the prices carrying the fast, slow and signal EMA state.
+// The MACD history feeding the signal line starts at index slow_period, and
+// each EMA is seeded with the SMA of its first period values, so the result
+// matches running compute_ema over every prefix of the series. Output
+// buffers, when given, must already be filled with NaN.
+MACDResult TechnicalIndicatorEngine::compute_macd_pass(PriceView prices,
+                                                       int fast_period,
+                                                       int slow_period,
+                                                       int signal_period,
+                                                       SeriesBuffer* macd_series,
+                                                       SeriesBuffer* signal_series,
+                                                       SeriesBuffer* histogram_series) {
+    if (fast_period <= 0 || slow_period <= 0 || signal_period <= 0) {
+        throw std::invalid_argument("MACD periods must be positive");
+    }
     if (prices.size() < static_cast<size_t>(slow_period + signal_period)) {
         throw std::invalid_argument("Insufficient data for MACD calculation");
     }
     
-    // Calculate fast and slow EMAs
-    double fast_ema = compute_ema(prices, fast_period);
-    double slow_ema = compute_ema(prices, slow_period);
-    
-    // MACD line is the difference
-    double macd_line = fast_ema - slow_ema;
-    
-    // Calculate signal line (EMA of MACD line)
-    // For simplicity, we'll use a simple approximation
-    // In production, you'd maintain a history of MACD values
-    std::vector<double> macd_history;
-    
-    // Build MACD history for signal line calculation
-    size_t start_idx = slow_period;
-    for (size_t i = start_idx; i < prices.size(); ++i) {
-        std::vector<double> subset(prices.begin(), prices.begin() + i + 1);
-        double f_ema = compute_ema(subset, fast_period);
-        double s_ema = compute_ema(subset, slow_period);
-        macd_history.push_back(f_ema - s_ema);
-    }
-    
-    double signal_line = 0.0;
-    if (macd_history.size() >= static_cast<size_t>(signal_period)) {
-        signal_line = compute_ema(macd_history, signal_period);
-    } else {
-        signal_line = macd_line;
+    // The default 12/26/9 configuration runs with compile-time periods
+    if (fast_period == 12 && slow_period == 26 && signal_period == 9) {
+        return macd_kernel(prices, FixedPeriod<12>{}, FixedPeriod<26>{}, FixedPeriod<9>{},
+                           macd_series, signal_series, histogram_series);
     }
-    
-    double histogram = macd_line - signal_line;
-    
-    return MACDResult{macd_line, signal_line, histogram};
+    return macd_kernel(prices, fast_period, slow_period, signal_period,
+                       macd_series, signal_series, histogram_series);
 }
 
 // Bollinger Bands
-BollingerBands TechnicalIndicatorEngine::compute_bollinger_bands(const std::vector<double>& prices,
+BollingerBands TechnicalIndicatorEngine::compute_bollinger_bands(PriceView prices,
                                                                  int period,
                                                                  double std_dev) {
+    INDICATORS_PROFILE(BOLLINGER, prices.size());
     if (prices.size() < static_cast<size_t>(period)) {
         throw std::invalid_argument("Insufficient data for Bollinger Bands calculation");
     }
@@ -152,8 +409,7 @@ BollingerBands TechnicalIndicatorEngine::compute_bollinger_bands(const std::vect
     double middle = compute_sma(prices, period);
     
     // Calculate standard deviation of recent prices
-    std::vector<double> recent_prices(prices.end() - period, prices.end());
-    double std = compute_std_dev(recent_prices, middle);
+    double std = compute_std_dev(prices.last(period), middle);
     
     // Calculate upper and lower bands
     double upper = middle + (std_dev * std);
@@ -164,59 +420,547 @@ BollingerBands TechnicalIndicatorEngine::compute_bollinger_bands(const std::vect
 
 // Average True Range
 double TechnicalIndicatorEngine::compute_atr(const std::vector<OHLC>& bars, int period) {
+    INDICATORS_PROFILE(ATR, bars.size());
     if (bars.size() < static_cast<size_t>(period + 1)) {
         throw std::invalid_argument("Insufficient data for ATR calculation");
     }
     
-    std::vector<double> true_ranges;
-    true_ranges.reserve(bars.size() - 1);
-    
-    for (size_t i = 1; i < bars.size(); ++i) {
+    // ATR is the SMA of the last period true ranges
+    double sum = 0.0;
+    for (size_t i = bars.size() - period; i < bars.size(); ++i) {
         double high_low = bars[i].high - bars[i].low;
         double high_close = std::abs(bars[i].high - bars[i - 1].close);
         double low_close = std::abs(bars[i].low - bars[i - 1].close);
         
-        double tr = std::max({high_low, high_close, low_close});
-        true_ranges.push_back(tr);
+        sum += std::max({high_low, high_close, low_close});
+    }
+    return sum / period;
+}
+
+// Average True Range over high/low/close columns
+double TechnicalIndicatorEngine::compute_atr(PriceView high, PriceView low, PriceView close, int period) {
+    INDICATORS_PROFILE(ATR, close.size());
+    if (high.size() != close.size() || low.size() != close.size()) {
+        throw std::invalid_argument("High, low and close lengths do not match");
+    }
+    if (close.size() < static_cast<size_t>(period + 1)) {
+        throw std::invalid_argument("Insufficient data for ATR calculation");
     }
     
-    // Calculate ATR as SMA of true ranges
-    return compute_sma(true_ranges, period);
+    // Columns are contiguous, so the previous close of bar i is close[i - 1]
+    size_t first = close.size() - period;
+    double sum = simd::sum_true_range(high.data() + first, low.data() + first,
+                                      close.data() + first - 1, period);
+    return sum / period;
+}
+
+namespace {
+
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// Spec behind the fixed compute_indicators overloads
+const IndicatorSpec& default_spec() {
+    static const IndicatorSpec spec;
+    return spec;
+}
+
+IndicatorValues empty_values() {
+    IndicatorValues values;
+    values.rsi = kNaN;
+    values.macd = MACDResult{kNaN, kNaN, kNaN};
+    values.bollinger = BollingerBands{kNaN, kNaN, kNaN};
+    values.atr = kNaN;
+    values.obv = kNaN;
+    values.vwap = kNaN;
+    values.mfi = kNaN;
+    values.volume_sma = kNaN;
+    return values;
+}
+
+// Fused close pass, with compile-time periods for the default RSI and MACD
+// settings
+void run_close_pass(PriceView closes, ArrayView<int64_t> volume, const IndicatorSpec& spec,
+                    IndicatorValues& values) {
+    if (spec.rsi_period == 14 && spec.macd_fast_period == 12 && spec.macd_slow_period == 26 &&
+        spec.macd_signal_period == 9) {
+        fused_close_pass(closes, volume, spec, FixedPeriod<14>{}, FixedPeriod<12>{}, FixedPeriod<26>{},
+                         FixedPeriod<9>{}, values);
+    } else {
+        fused_close_pass(closes, volume, spec, spec.rsi_period, spec.macd_fast_period,
+                         spec.macd_slow_period, spec.macd_signal_period, values);
+    }
+}
+
+// Column lengths agree; high and low may be empty unless needs_range, and
+// volume unless needs_volume
+bool columns_match(const BarColumns& bars, bool needs_range, bool needs_volume) {
+    const size_t n = bars.size();
+    auto matches = [n](size_t size, bool required) {
+        return size == n || (size == 0 && !required);
+    };
+    return matches(bars.high.size(), needs_range) && matches(bars.low.size(), needs_range) &&
+           matches(bars.open.size(), false) && matches(bars.volume.size(), needs_volume) &&
+           matches(bars.timestamp.size(), false);
+}
+
+// Fixed result set from values computed with default_spec()
+IndicatorResults to_results(const IndicatorValues& values) {
+    IndicatorResults results;
+    results.rsi = values.rsi;
+    results.macd = values.macd;
+    results.bollinger = values.bollinger;
+    results.sma_20 = values.moving_averages[0].value;
+    results.sma_50 = values.moving_averages[1].value;
+    results.ema_12 = values.moving_averages[2].value;
+    results.ema_26 = values.moving_averages[3].value;
+    results.atr = values.atr;
+    return results;
+}
+
+} // namespace
+
+void IndicatorSpec::validate() const {
+    auto check = [](bool enabled, int period, const char* name) {
+        if (enabled && period <= 0) {
+            throw std::invalid_argument(std::string(name) + " period must be positive");
+        }
+    };
+    check(rsi, rsi_period, "RSI");
+    check(macd, macd_fast_period, "MACD fast");
+    check(macd, macd_slow_period, "MACD slow");
+    check(macd, macd_signal_period, "MACD signal");
+    check(bollinger, bollinger_period, "Bollinger");
+    check(atr, atr_period, "ATR");
+    check(mfi, mfi_period, "MFI");
+    check(volume_sma, volume_sma_period, "Volume SMA");
+    if (vwap && vwap_session_seconds <= 0) {
+        throw std::invalid_argument("VWAP session length must be positive");
+    }
+    for (const auto& average : moving_averages) {
+        check(true, average.period, "Moving average");
+    }
+    if (moving_averages.size() > kMaxMovingAverages) {
+        throw std::invalid_argument("Too many moving averages: at most " +
+                                    std::to_string(kMaxMovingAverages) + " are supported");
+    }
+}
+
+bool IndicatorSpec::is_valid() const {
+    auto positive = [](bool enabled, int period) { return !enabled || period > 0; };
+    if (!positive(rsi, rsi_period) || !positive(macd, macd_fast_period) ||
+        !positive(macd, macd_slow_period) || !positive(macd, macd_signal_period) ||
+        !positive(bollinger, bollinger_period) || !positive(atr, atr_period) ||
+        !positive(mfi, mfi_period) || !positive(volume_sma, volume_sma_period) ||
+        (vwap && vwap_session_seconds <= 0)) {
+        return false;
+    }
+    for (const auto& average : moving_averages) {
+        if (average.period <= 0) {
+            return false;
+        }
+    }
+    return moving_averages.size() <= kMaxMovingAverages;
+}
+
+size_t IndicatorSpec::required_bars() const {
+    size_t bars = 1;
+    auto need = [&bars](bool enabled, int count) {
+        if (enabled) {
+            bars = std::max(bars, static_cast<size_t>(count));
+        }
+    };
+    need(rsi, rsi_period + 1);
+    need(macd, macd_slow_period + macd_signal_period);
+    need(bollinger, bollinger_period);
+    need(atr, atr_period + 1);
+    need(mfi, mfi_period + 1);
+    need(volume_sma, volume_sma_period);
+    for (const auto& average : moving_averages) {
+        need(true, average.period);
+    }
+    return bars;
+}
+
+double IndicatorValues::sma(int period) const {
+    for (size_t i = 0; i < moving_average_count; ++i) {
+        if (moving_averages[i].type == MovingAverageType::SMA && moving_averages[i].period == period) {
+            return moving_averages[i].value;
+        }
+    }
+    throw std::out_of_range("SMA " + std::to_string(period) + " was not computed");
+}
+
+double IndicatorValues::ema(int period) const {
+    for (size_t i = 0; i < moving_average_count; ++i) {
+        if (moving_averages[i].type == MovingAverageType::EMA && moving_averages[i].period == period) {
+            return moving_averages[i].value;
+        }
+    }
+    throw std::out_of_range("EMA " + std::to_string(period) + " was not computed");
+}
+
+// Validate column lengths and the bar count. High and low may be left
+// empty when no range indicator needs them, and volume when no volume
+// indicator does.
+void TechnicalIndicatorEngine::check_columns(const BarColumns& bars, size_t required_bars,
+                                             bool needs_range, bool needs_volume) {
+    const size_t n = bars.size();
+    if (!columns_match(bars, needs_range, needs_volume)) {
+        throw std::invalid_argument("Bar column lengths do not match");
+    }
+    
+    if (n == 0) {
+        throw std::invalid_argument("Empty price data");
+    }
+    
+    if (n < required_bars) {
+        throw std::invalid_argument("Insufficient data: need at least " +
+                                    std::to_string(required_bars) + " bars");
+    }
 }
 
 // Main computation method
 IndicatorResults TechnicalIndicatorEngine::compute_indicators(const PriceData& prices) {
+    return to_results(compute_indicators(prices, default_spec()));
+}
+
+// Main computation method over column views, e.g. NumPy arrays
+IndicatorResults TechnicalIndicatorEngine::compute_indicators(const BarColumns& bars) {
+    return to_results(compute_indicators(bars, default_spec()));
+}
+
+// Main computation method over columnar bar storage, without copying
+IndicatorResults TechnicalIndicatorEngine::compute_indicators(const BarSeries& bars) {
+    return compute_indicators(bars.columns());
+}
+
+// Main computation method over reduced-precision storage
+IndicatorResults TechnicalIndicatorEngine::compute_indicators(const CompactBarSeries& bars) {
+    return to_results(compute_indicators(bars, default_spec()));
+}
+
+IndicatorValues TechnicalIndicatorEngine::compute_indicators(const PriceData& prices,
+                                                             const IndicatorSpec& spec) {
+    spec.validate();
     if (prices.bars.empty()) {
         throw std::invalid_argument("Empty price data");
     }
     
-    if (prices.bars.size() < 50) {
-        throw std::invalid_argument("Insufficient data: need at least 50 bars");
+    const size_t required = spec.required_bars();
+    if (prices.bars.size() < required) {
+        throw std::invalid_argument("Insufficient data: need at least " +
+                                    std::to_string(required) + " bars");
     }
     
-    std::vector<double> closes = extract_closes(prices.bars);
+    // The columns live in this thread's scratch arena until the call returns
+    ScratchArena& arena = ScratchArena::local();
+    ScratchArena::Scope scope(arena);
+    return compute_indicators(gather_columns(prices.bars, arena, spec.needs_volume()), spec);
+}
+
+IndicatorValues TechnicalIndicatorEngine::compute_indicators(const BarColumns& bars,
+                                                             const IndicatorSpec& spec) {
+    INDICATORS_PROFILE(COMPUTE_INDICATORS, bars.size());
+    spec.validate();
+    check_columns(bars, spec.required_bars(), spec.needs_range(), spec.needs_volume());
     
-    IndicatorResults results;
+    IndicatorValues values = empty_values();
     
     try {
-        results.rsi = compute_rsi(closes, 14);
-        results.macd = compute_macd(closes, 12, 26, 9);
-        results.bollinger = compute_bollinger_bands(closes, 20, 2.0);
-        results.sma_20 = compute_sma(closes, 20);
-        results.sma_50 = compute_sma(closes, 50);
-        results.ema_12 = compute_ema(closes, 12);
-        results.ema_26 = compute_ema(closes, 26);
-        results.atr = compute_atr(prices.bars, 14);
+        const PriceView closes = bars.close;
+        for (const auto& average : spec.moving_averages) {
+            values.moving_averages[values.moving_average_count++] =
+                MovingAverageValue{average.type, average.period, kNaN};
+        }
+        
+        // RSI, MACD, OBV and the EMAs share one pass over the closes; the
+        // window indicators below only read the tail
+        {
+            INDICATORS_PROFILE(CLOSE_PASS, closes.size());
+            run_close_pass(closes, bars.volume, spec, values);
+        }
+        if (spec.bollinger) {
+            values.bollinger = compute_bollinger_bands(closes, spec.bollinger_period,
+                                                       spec.bollinger_std_dev);
+        }
+        if (spec.atr) {
+            values.atr = compute_atr(bars.high, bars.low, closes, spec.atr_period);
+        }
+        if (spec.vwap) {
+            values.vwap = compute_vwap(bars.high, bars.low, closes, bars.volume, bars.timestamp,
+                                       spec.vwap_session_seconds, spec.vwap_session_offset);
+        }
+        if (spec.mfi) {
+            values.mfi = compute_mfi(bars.high, bars.low, closes, bars.volume, spec.mfi_period);
+        }
+        if (spec.volume_sma) {
+            values.volume_sma = compute_volume_sma(bars.volume, spec.volume_sma_period);
+        }
+        for (size_t k = 0; k < spec.moving_averages.size(); ++k) {
+            if (spec.moving_averages[k].type == MovingAverageType::SMA) {
+                values.moving_averages[k].value = compute_sma(closes, spec.moving_averages[k].period);
+            }
+        }
     } catch (const std::exception& e) {
         throw std::runtime_error(std::string("Indicator computation failed: ") + e.what());
     }
     
+    return values;
+}
+
+IndicatorValues TechnicalIndicatorEngine::compute_indicators(const BarSeries& bars,
+                                                             const IndicatorSpec& spec) {
+    return compute_indicators(bars.columns(), spec);
+}
+
+IndicatorValues TechnicalIndicatorEngine::compute_indicators(const CompactBarSeries& bars,
+                                                             const IndicatorSpec& spec) {
+    ScratchArena& arena = ScratchArena::local();
+    ScratchArena::Scope scope(arena);
+    return compute_indicators(bars.price_columns(arena, spec.needs_volume()), spec);
+}
+
+ComputedResults TechnicalIndicatorEngine::try_compute_indicators(const PriceData& prices) {
+    ScratchArena& arena = ScratchArena::local();
+    ScratchArena::Scope scope(arena);
+    return try_compute_indicators(gather_columns(prices.bars, arena));
+}
+
+ComputedResults TechnicalIndicatorEngine::try_compute_indicators(const BarColumns& bars) {
+    ComputedValues computed = try_compute_indicators(bars, default_spec());
+    
+    ComputedResults outcome;
+    outcome.status = computed.status;
+    outcome.results = to_results(computed.values);
+    outcome.valid.rsi = computed.valid.rsi;
+    outcome.valid.macd = computed.valid.macd;
+    outcome.valid.bollinger = computed.valid.bollinger;
+    outcome.valid.sma_20 = computed.valid.moving_averages[0];
+    outcome.valid.sma_50 = computed.valid.moving_averages[1];
+    outcome.valid.ema_12 = computed.valid.moving_averages[2];
+    outcome.valid.ema_26 = computed.valid.moving_averages[3];
+    outcome.valid.atr = computed.valid.atr;
+    outcome.required_bars = computed.required_bars;
+    return outcome;
+}
+
+ComputedResults TechnicalIndicatorEngine::try_compute_indicators(const BarSeries& bars) {
+    return try_compute_indicators(bars.columns());
+}
+
+ComputedValues TechnicalIndicatorEngine::try_compute_indicators(const PriceData& prices,
+                                                                const IndicatorSpec& spec) {
+    ScratchArena& arena = ScratchArena::local();
+    ScratchArena::Scope scope(arena);
+    return try_compute_indicators(gather_columns(prices.bars, arena, spec.needs_volume()), spec);
+}
+
+// Same kernels and order as compute_indicators, so every valid field equals
+// what the throwing overload returns once there are enough bars
+ComputedValues TechnicalIndicatorEngine::try_compute_indicators(const BarColumns& bars,
+                                                                const IndicatorSpec& spec) {
+    INDICATORS_PROFILE(COMPUTE_INDICATORS, bars.size());
+    ComputedValues computed;
+    computed.values = empty_values();
+    if (!spec.is_valid() || !columns_match(bars, spec.needs_range(), spec.needs_volume())) {
+        return computed;
+    }
+    
+    IndicatorValues& values = computed.values;
+    IndicatorValidity& valid = computed.valid;
+    const PriceView closes = bars.close;
+    const size_t n = closes.size();
+    auto enough = [n](int count) { return n >= static_cast<size_t>(count); };
+    computed.required_bars = spec.required_bars();
+    
+    valid.rsi = spec.rsi && enough(spec.rsi_period + 1);
+    valid.macd = spec.macd && enough(spec.macd_slow_period + spec.macd_signal_period);
+    valid.bollinger = spec.bollinger && enough(spec.bollinger_period);
+    valid.atr = spec.atr && enough(spec.atr_period + 1);
+    valid.obv = spec.obv && enough(1);
+    valid.vwap = spec.vwap && enough(1);
+    valid.mfi = spec.mfi && enough(spec.mfi_period + 1);
+    valid.volume_sma = spec.volume_sma && enough(spec.volume_sma_period);
+    size_t requested = (spec.rsi ? 1 : 0) + (spec.macd ? 1 : 0) + (spec.bollinger ? 1 : 0) +
+                       (spec.atr ? 1 : 0) + (spec.obv ? 1 : 0) + (spec.vwap ? 1 : 0) +
+                       (spec.mfi ? 1 : 0) + (spec.volume_sma ? 1 : 0) +
+                       spec.moving_averages.size();
+    size_t computed_count = (valid.rsi ? 1 : 0) + (valid.macd ? 1 : 0) +
+                            (valid.bollinger ? 1 : 0) + (valid.atr ? 1 : 0) +
+                            (valid.obv ? 1 : 0) + (valid.vwap ? 1 : 0) + (valid.mfi ? 1 : 0) +
+                            (valid.volume_sma ? 1 : 0);
+    bool any_ema = false;
+    for (size_t k = 0; k < spec.moving_averages.size(); ++k) {
+        const MovingAverageSpec& average = spec.moving_averages[k];
+        values.moving_averages[values.moving_average_count++] =
+            MovingAverageValue{average.type, average.period, kNaN};
+        valid.moving_averages[k] = enough(average.period);
+        computed_count += valid.moving_averages[k] ? 1 : 0;
+        any_ema = any_ema || (valid.moving_averages[k] && average.type == MovingAverageType::EMA);
+    }
+    
+    // The close pass runs the spec as given; values of indicators that are
+    // still warming up are discarded below
+    if (valid.rsi || valid.macd || valid.obv || any_ema) {
+        INDICATORS_PROFILE(CLOSE_PASS, n);
+        run_close_pass(closes, bars.volume, spec, values);
+    }
+    if (!valid.rsi) {
+        values.rsi = kNaN;
+    }
+    if (!valid.macd) {
+        values.macd = MACDResult{kNaN, kNaN, kNaN};
+    }
+    if (valid.bollinger) {
+        values.bollinger = compute_bollinger_bands(closes, spec.bollinger_period,
+                                                   spec.bollinger_std_dev);
+    }
+    if (valid.atr) {
+        values.atr = compute_atr(bars.high, bars.low, closes, spec.atr_period);
+    }
+    if (valid.vwap) {
+        values.vwap = compute_vwap(bars.high, bars.low, closes, bars.volume, bars.timestamp,
+                                   spec.vwap_session_seconds, spec.vwap_session_offset);
+    }
+    if (valid.mfi) {
+        values.mfi = compute_mfi(bars.high, bars.low, closes, bars.volume, spec.mfi_period);
+    }
+    if (valid.volume_sma) {
+        values.volume_sma = compute_volume_sma(bars.volume, spec.volume_sma_period);
+    }
+    for (size_t k = 0; k < spec.moving_averages.size(); ++k) {
+        if (!valid.moving_averages[k]) {
+            values.moving_averages[k].value = kNaN;
+        } else if (spec.moving_averages[k].type == MovingAverageType::SMA) {
+            values.moving_averages[k].value = compute_sma(closes, spec.moving_averages[k].period);
+        }
+    }
+    
+    if (computed_count == requested) {
+        computed.status = ComputeStatus::OK;
+    } else if (computed_count > 0) {
+        computed.status = ComputeStatus::PARTIAL;
+    } else {
+        computed.status = ComputeStatus::INSUFFICIENT_DATA;
+    }
+    return computed;
+}
+
+std::vector<ComputedResults> TechnicalIndicatorEngine::try_compute_indicators_batch(
+    const std::vector<PriceData>& batch) {
+    INDICATORS_PROFILE(BATCH, batch.size());
+    std::vector<ComputedResults> results(batch.size());
+    pool().parallel_for(batch.size(), [&](size_t i) {
+        results[i] = try_compute_indicators(batch[i]);
+    });
+    return results;
+}
+
+// Compute indicators for many symbols in parallel on the thread pool
+std::vector<IndicatorResults> TechnicalIndicatorEngine::compute_indicators_batch(
+    const std::vector<PriceData>& batch) {
+    INDICATORS_PROFILE(BATCH, batch.size());
+    std::vector<IndicatorResults> results(batch.size());
+    std::vector<std::string> errors(batch.size());
+    
+    pool().parallel_for(batch.size(), [&](size_t i) {
+        try {
+            results[i] = compute_indicators(batch[i]);
+        } catch (const std::exception& e) {
+            errors[i] = e.what();
+        }
+    });
+    
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!errors[i].empty()) {
+            throw std::runtime_error("Batch computation failed for " + batch[i].symbol +
+                                     ": " + errors[i]);
+        }
+    }
+    
     return results;
 }
 
 // Generate trading signals based on indicators
 TechnicalSignals TechnicalIndicatorEngine::generate_signals(const IndicatorResults& indicators,
                                                            double current_price) {
+    return classify_signals(indicators, current_price);
+}
+
+IndicatorAnalysis TechnicalIndicatorEngine::analyze(const PriceData& prices) {
+    const ResultKey key = result_key(prices);
+    IndicatorAnalysis analysis;
+    if (cache_->lookup(prices.symbol, key, analysis)) {
+        return analysis;
+    }
+    
+    analysis.indicators = compute_indicators(prices);
+    analysis.signals = classify_signals(analysis.indicators, key.last_bar.close);
+    cache_->store(prices.symbol, key, analysis);
+    return analysis;
+}
+
+IndicatorAnalysis TechnicalIndicatorEngine::analyze(const std::string& symbol, const BarColumns& bars) {
+    const ResultKey key = result_key(bars);
+    IndicatorAnalysis analysis;
+    if (cache_->lookup(symbol, key, analysis)) {
+        return analysis;
+    }
+    
+    analysis.indicators = compute_indicators(bars);
+    analysis.signals = classify_signals(analysis.indicators, key.last_bar.close);
+    cache_->store(symbol, key, analysis);
+    return analysis;
+}
+
+namespace {
+
+// Run compute on the pool, reporting to done before the future is set
+template <typename T, typename Compute>
+std::future<T> submit_with_completion(ThreadPool& pool, Compute compute, CompletionCallback<T> done) {
+    return pool.submit([compute = std::move(compute), done = std::move(done)]() -> T {
+        T result{};
+        try {
+            result = compute();
+        } catch (...) {
+            if (done) {
+                done(T{}, std::current_exception());
+            }
+            throw;
+        }
+        if (done) {
+            done(result, nullptr);
+        }
+        return result;
+    });
+}
+
+} // namespace
+
+std::future<IndicatorResults> TechnicalIndicatorEngine::submit_indicators(
+    PriceData prices, CompletionCallback<IndicatorResults> done) {
+    return submit_with_completion<IndicatorResults>(
+        pool(), [this, prices = std::move(prices)]() { return compute_indicators(prices); },
+        std::move(done));
+}
+
+// The batch task fans out over the same pool; parallel_for lets the task's
+// worker help, so a busy pool cannot deadlock on it
+std::future<std::vector<IndicatorResults>> TechnicalIndicatorEngine::submit_indicators_batch(
+    std::vector<PriceData> batch, CompletionCallback<std::vector<IndicatorResults>> done) {
+    return submit_with_completion<std::vector<IndicatorResults>>(
+        pool(), [this, batch = std::move(batch)]() { return compute_indicators_batch(batch); },
+        std::move(done));
+}
+
+std::future<IndicatorAnalysis> TechnicalIndicatorEngine::submit_analysis(
+    PriceData prices, CompletionCallback<IndicatorAnalysis> done) {
+    return submit_with_completion<IndicatorAnalysis>(
+        pool(), [this, prices = std::move(prices)]() { return analyze(prices); },
+        std::move(done));
+}
+
+TechnicalSignals classify_signals(const IndicatorResults& indicators, double current_price) {
     TechnicalSignals signals;
     
     // RSI signals
@@ -1,10 +1,18 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <string>
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "thread_pool.h"
 
 namespace indicators {
 
@@ -24,12 +32,103 @@ struct PriceData {
     int64_t timestamp;
 };
 
+// Non-owning view over contiguous values (std::span is C++20). Kernels take
+// views so they can read std::vector storage and external buffers such as
+// NumPy arrays without copying.
+template <typename T>
+class ArrayView {
+public:
+    ArrayView() : data_(nullptr), size_(0) {}
+    ArrayView(const T* data, size_t size) : data_(data), size_(size) {}
+    ArrayView(const std::vector<T>& values) : data_(values.data()), size_(values.size()) {}
+    
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    const T& back() const { return data_[size_ - 1]; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    
+    // Views over the first or last count values
+    ArrayView first(size_t count) const { return ArrayView(data_, count); }
+    ArrayView last(size_t count) const { return ArrayView(data_ + size_ - count, count); }
+    
+private:
+    const T* data_;
+    size_t size_;
+};
+
+using PriceView = ArrayView<double>;
+
+// Writable counterpart of ArrayView for caller-provided output buffers
+template <typename T>
+class MutableArrayView {
+public:
+    MutableArrayView() : data_(nullptr), size_(0) {}
+    MutableArrayView(T* data, size_t size) : data_(data), size_(size) {}
+    MutableArrayView(std::vector<T>& values) : data_(values.data()), size_(values.size()) {}
+    
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    T& operator[](size_t i) const { return data_[i]; }
+    
+private:
+    T* data_;
+    size_t size_;
+};
+
+using SeriesBuffer = MutableArrayView<double>;
+
+// Column views over a bar series. open, volume and timestamp are optional
+// (empty) since no price indicator reads them.
+struct BarColumns {
+    PriceView open;
+    PriceView high;
+    PriceView low;
+    PriceView close;
+    ArrayView<int64_t> volume;
+    ArrayView<int64_t> timestamp;
+    
+    size_t size() const { return close.size(); }
+};
+
+// Closes of several symbols sampled at the same bars, one time step per
+// row: the close of symbol s at bar t is data[t * symbols + s]. This is a
+// column-major symbols x bars matrix, or a C-order (bars, symbols) array.
+template <typename T>
+struct BasicPriceMatrix {
+    const T* data = nullptr;
+    size_t symbols = 0;
+    size_t bars = 0;
+    
+    BasicPriceMatrix() = default;
+    BasicPriceMatrix(const T* data, size_t symbols, size_t bars)
+        : data(data), symbols(symbols), bars(bars) {}
+    
+    const T* row(size_t t) const { return data + t * symbols; }
+    size_t size() const { return symbols * bars; }
+};
+
+using PriceMatrix = BasicPriceMatrix<double>;
+// Single-precision closes: half the memory traffic and twice the SIMD
+// lanes, at the accuracy documented on the float cross-section overloads
+using PriceMatrixF = BasicPriceMatrix<float>;
+
 struct MACDResult {
     double macd_line;
     double signal_line;
     double histogram;
 };
 
+// Full MACD history, one entry per input bar. Entries before the first
+// bar at which a value is defined are NaN.
+struct MACDSeries {
+    std::vector<double> macd_line;
+    std::vector<double> signal_line;
+    std::vector<double> histogram;
+};
+
 struct BollingerBands {
     double upper;
     double middle;
@@ -47,6 +146,147 @@ struct IndicatorResults {
     double atr;
 };
 
+enum class MovingAverageType {
+    SMA,
+    EMA
+};
+
+struct MovingAverageSpec {
+    MovingAverageType type;
+    int period;
+};
+
+// Which indicators to compute and with which parameters. Disabled
+// indicators are skipped entirely. The defaults match the fixed set
+// returned in IndicatorResults.
+struct IndicatorSpec {
+    static constexpr size_t kMaxMovingAverages = 8;
+    
+    bool rsi = true;
+    int rsi_period = 14;
+    
+    bool macd = true;
+    int macd_fast_period = 12;
+    int macd_slow_period = 26;
+    int macd_signal_period = 9;
+    
+    bool bollinger = true;
+    int bollinger_period = 20;
+    double bollinger_std_dev = 2.0;
+    
+    bool atr = true;
+    int atr_period = 14;
+    
+    // Volume indicators read the volume column and are off by default.
+    // VWAP restarts at every session boundary, sessions being
+    // floor((timestamp - vwap_session_offset) / vwap_session_seconds);
+    // without timestamps the whole input is one session.
+    bool obv = false;
+    
+    bool vwap = false;
+    int64_t vwap_session_seconds = 86400;
+    int64_t vwap_session_offset = 0;
+    
+    bool mfi = false;
+    int mfi_period = 14;
+    
+    bool volume_sma = false;
+    int volume_sma_period = 20;
+    
+    std::vector<MovingAverageSpec> moving_averages = {
+        {MovingAverageType::SMA, 20},
+        {MovingAverageType::SMA, 50},
+        {MovingAverageType::EMA, 12},
+        {MovingAverageType::EMA, 26},
+    };
+    
+    // Throws std::invalid_argument for non-positive periods or more than
+    // kMaxMovingAverages moving averages
+    void validate() const;
+    // validate() without throwing
+    bool is_valid() const;
+    // Fewest bars for which every enabled indicator is defined
+    size_t required_bars() const;
+    bool needs_range() const { return atr || vwap || mfi; }
+    bool needs_volume() const { return obv || vwap || mfi || volume_sma; }
+};
+
+struct MovingAverageValue {
+    MovingAverageType type;
+    int period;
+    double value;
+};
+
+// Values produced for an IndicatorSpec. Fields of disabled indicators are
+// NaN; moving averages are stored in spec order.
+struct IndicatorValues {
+    double rsi;
+    MACDResult macd;
+    BollingerBands bollinger;
+    double atr;
+    double obv;
+    double vwap;
+    double mfi;
+    double volume_sma;
+    std::array<MovingAverageValue, IndicatorSpec::kMaxMovingAverages> moving_averages;
+    size_t moving_average_count = 0;
+    
+    // Throws std::out_of_range if the moving average was not requested
+    double sma(int period) const;
+    double ema(int period) const;
+};
+
+// Outcome of the non-throwing try_compute_indicators overloads
+enum class ComputeStatus {
+    OK,                 // every requested indicator was computed
+    PARTIAL,            // some indicators lack enough bars and are NaN
+    INSUFFICIENT_DATA,  // no requested indicator has enough bars
+    INVALID_INPUT       // invalid spec or mismatched columns, nothing computed
+};
+
+// Which fields of IndicatorValues hold a value; the rest are NaN
+struct IndicatorValidity {
+    bool rsi = false;
+    bool macd = false;
+    bool bollinger = false;
+    bool atr = false;
+    bool obv = false;
+    bool vwap = false;
+    bool mfi = false;
+    bool volume_sma = false;
+    std::array<bool, IndicatorSpec::kMaxMovingAverages> moving_averages{};
+};
+
+struct ComputedValues {
+    ComputeStatus status = ComputeStatus::INVALID_INPUT;
+    IndicatorValues values;
+    IndicatorValidity valid;
+    size_t required_bars = 0;  // bars needed for status OK
+    
+    bool ok() const { return status == ComputeStatus::OK; }
+};
+
+// Which fields of IndicatorResults hold a value; the rest are NaN
+struct ResultValidity {
+    bool rsi = false;
+    bool macd = false;
+    bool bollinger = false;
+    bool sma_20 = false;
+    bool sma_50 = false;
+    bool ema_12 = false;
+    bool ema_26 = false;
+    bool atr = false;
+};
+
+struct ComputedResults {
+    ComputeStatus status = ComputeStatus::INVALID_INPUT;
+    IndicatorResults results;
+    ResultValidity valid;
+    size_t required_bars = 0;  // bars needed for status OK
+    
+    bool ok() const { return status == ComputeStatus::OK; }
+};
+
 enum class SignalType {
     OVERBOUGHT,
     OVERSOLD,
@@ -63,32 +303,365 @@ struct TechnicalSignals {
     SignalType bb_signal;
 };
 
+// Indicators and the signals they give at the last close
+struct IndicatorAnalysis {
+    IndicatorResults indicators;
+    TechnicalSignals signals;
+};
+
+// Completion hook for the submit_* methods of TechnicalIndicatorEngine. It
+// runs on the pool thread that finished the task, with error set (and a
+// default result) if the computation threw. It must not throw.
+template <typename T>
+using CompletionCallback = std::function<void(const T& result, std::exception_ptr error)>;
+
+// Threshold signals: RSI 70/30, MACD histogram sign, price outside the
+// Bollinger Bands
+TechnicalSignals classify_signals(const IndicatorResults& indicators, double current_price);
+
+// Reads and writes the private streaming state below for encode_state and
+// decode_state (state_codec.h)
+struct StateCodec;
+
+// Exponential moving average seeded with the SMA of its first period values
+struct EmaAccumulator {
+    explicit EmaAccumulator(int period = 1);
+    
+    void add(double value);
+    bool ready() const { return count >= static_cast<size_t>(period); }
+    
+    int period;
+    double multiplier;
+    double value;
+    size_t count;
+};
+
+// Wilder-smoothed average gain and loss over price changes
+struct RsiAccumulator {
+    explicit RsiAccumulator(int period = 14);
+    
+    void add(double change);
+    bool ready() const { return count >= static_cast<size_t>(period); }
+    double value() const;
+    
+    int period;
+    double avg_gain;
+    double avg_loss;
+    size_t count;
+};
+
+// Running mean and sum of squared deviations of a window, updated with
+// Welford's recurrence extended to replacing a value. Unlike a running sum
+// of squares this does not cancel catastrophically when the spread is tiny
+// next to the price level; the owner bounds the remaining rounding drift
+// by calling reset() about once per window.
+class RollingMoments {
+public:
+    // Grow the window by one value
+    void add(double value);
+    // Swap one value of the window for another (slide or revise)
+    void replace(double previous, double value);
+    // Recompute exactly from the n values currently in the window
+    void reset(const double* values, size_t n);
+    
+    size_t count() const { return count_; }
+    double mean() const { return mean_; }
+    // Population variance
+    double variance() const;
+    
+private:
+    friend struct StateCodec;
+    
+    size_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+};
+
+// Fixed-length window with a running mean and variance, O(1) per update
+class RollingWindow {
+public:
+    explicit RollingWindow(int period = 1);
+    
+    void push(double value);
+    void replace_last(double value);
+    
+    bool full() const { return count_ == values_.size(); }
+    size_t size() const { return count_; }
+    double mean() const;
+    double std_dev() const;
+    
+private:
+    friend struct StateCodec;
+    
+    void reanchor_if_due();
+    
+    std::vector<double> values_;
+    size_t head_;
+    size_t count_;
+    RollingMoments moments_;
+    size_t updates_since_reset_;
+};
+
+// Session index of a timestamp for session-anchored VWAP:
+// floor((timestamp - session_offset) / session_seconds)
+int64_t session_of(int64_t timestamp, int64_t session_seconds, int64_t session_offset);
+
+// Volume indicators of IncrementalIndicatorState, with the IndicatorSpec
+// default periods
+struct VolumeIndicators {
+    double obv;
+    double vwap;
+    double mfi;
+    double volume_sma;
+};
+
+// Per-symbol streaming state producing the same indicator set as
+// TechnicalIndicatorEngine::compute_indicators at O(1) cost per bar.
+// update_last_bar revises the most recent bar in place, e.g. while the
+// bar is still forming: the recursive indicators are re-applied from the
+// snapshot taken before that bar and the windows swap their last entry,
+// so a revision costs the same as a push regardless of history length.
+class IncrementalIndicatorState {
+public:
+    static constexpr size_t kMinBars = 50;
+    
+    IncrementalIndicatorState();
+    // VWAP sessions as in IndicatorSpec
+    explicit IncrementalIndicatorState(int64_t vwap_session_seconds,
+                                       int64_t vwap_session_offset = 0);
+    
+    void push_bar(const OHLC& bar);
+    void update_last_bar(const OHLC& bar);
+    // Fold one trade into the forming bar: close becomes price, high and
+    // low widen to include it and volume is added
+    void apply_tick(double price, int64_t volume = 0);
+    
+    bool ready() const { return current_.bar_count >= kMinBars; }
+    size_t bar_count() const { return current_.bar_count; }
+    const OHLC& last_bar() const;
+    IndicatorResults results() const;
+    // OBV, session VWAP, MFI(14) and volume SMA(20); throws until ready()
+    VolumeIndicators volume_indicators() const;
+    
+private:
+    friend struct StateCodec;
+    
+    // Recursive indicator state; committed_ covers every bar except the
+    // last one so that the last bar can be re-applied cheaply.
+    struct RecursiveState {
+        EmaAccumulator ema_fast;
+        EmaAccumulator ema_slow;
+        EmaAccumulator macd_signal;
+        RsiAccumulator rsi;
+        double macd_line;
+        double last_close;
+        int64_t obv;
+        int64_t session;
+        double session_price_volume;
+        double session_volume;
+        double last_typical;
+        size_t bar_count;
+    };
+    
+    void apply_bar(RecursiveState& state, const OHLC& bar) const;
+    
+    RecursiveState committed_;
+    RecursiveState current_;
+    RollingWindow closes_20_;
+    RollingWindow closes_50_;
+    RollingWindow true_ranges_;
+    // Rings of the last signed money flows and volumes, summed exactly as
+    // compute_mfi and compute_volume_sma do
+    std::vector<double> money_flows_;
+    size_t flows_pushed_;
+    std::vector<int64_t> volumes_;
+    size_t volumes_pushed_;
+    int64_t volume_sum_;
+    int64_t session_seconds_;
+    int64_t session_offset_;
+    OHLC last_bar_;
+};
+
+class BarSeries;
+class CompactBarSeries;
+class ResultCache;
+class ScratchArena;
+
 // Technical Indicator Engine class
 class TechnicalIndicatorEngine {
 public:
-    TechnicalIndicatorEngine() = default;
+    TechnicalIndicatorEngine();
+    // Use a dedicated pool of num_threads workers for batch computation
+    // instead of the process-wide shared pool
+    explicit TechnicalIndicatorEngine(size_t num_threads);
     
     // Main computation methods
     IndicatorResults compute_indicators(const PriceData& prices);
+    IndicatorResults compute_indicators(const BarColumns& bars);
+    IndicatorResults compute_indicators(const BarSeries& bars);
+    // Widens the compact float32 columns to double in the scratch arena;
+    // see CompactBarSeries for how far the results can move
+    IndicatorResults compute_indicators(const CompactBarSeries& bars);
+    // Compute only the indicators enabled in spec
+    IndicatorValues compute_indicators(const PriceData& prices, const IndicatorSpec& spec);
+    IndicatorValues compute_indicators(const BarColumns& bars, const IndicatorSpec& spec);
+    IndicatorValues compute_indicators(const BarSeries& bars, const IndicatorSpec& spec);
+    IndicatorValues compute_indicators(const CompactBarSeries& bars, const IndicatorSpec& spec);
+    std::vector<IndicatorResults> compute_indicators_batch(const std::vector<PriceData>& batch);
+    
+    // Non-throwing variants for short or bad input: indicators with
+    // enough bars are computed, the others come back NaN with their
+    // validity flag cleared, and status summarizes the outcome
+    ComputedResults try_compute_indicators(const PriceData& prices);
+    ComputedResults try_compute_indicators(const BarColumns& bars);
+    ComputedResults try_compute_indicators(const BarSeries& bars);
+    ComputedValues try_compute_indicators(const PriceData& prices, const IndicatorSpec& spec);
+    ComputedValues try_compute_indicators(const BarColumns& bars, const IndicatorSpec& spec);
+    std::vector<ComputedResults> try_compute_indicators_batch(const std::vector<PriceData>& batch);
     TechnicalSignals generate_signals(const IndicatorResults& indicators, double current_price);
     
+    // compute_indicators plus generate_signals at the last close, served
+    // from result_cache() while the symbol's bars are unchanged
+    IndicatorAnalysis analyze(const PriceData& prices);
+    IndicatorAnalysis analyze(const std::string& symbol, const BarColumns& bars);
+    ResultCache& result_cache() { return *cache_; }
+    
+    // Asynchronous variants that return at once: the input is moved into a
+    // task on the engine's thread pool. The future yields the result or
+    // rethrows, and done, if set, is called first from the worker. The
+    // engine must outlive its pending tasks.
+    std::future<IndicatorResults> submit_indicators(
+        PriceData prices, CompletionCallback<IndicatorResults> done = nullptr);
+    std::future<std::vector<IndicatorResults>> submit_indicators_batch(
+        std::vector<PriceData> batch, CompletionCallback<std::vector<IndicatorResults>> done = nullptr);
+    std::future<IndicatorAnalysis> submit_analysis(
+        PriceData prices, CompletionCallback<IndicatorAnalysis> done = nullptr);
+    
     // Individual indicator calculations
-    double compute_rsi(const std::vector<double>& prices, int period = 14);
-    MACDResult compute_macd(const std::vector<double>& prices, 
+    double compute_rsi(PriceView prices, int period = 14);
+    MACDResult compute_macd(PriceView prices, 
                            int fast_period = 12, 
                            int slow_period = 26, 
                            int signal_period = 9);
-    BollingerBands compute_bollinger_bands(const std::vector<double>& prices, 
+    MACDSeries compute_macd_series(PriceView prices,
+                                   int fast_period = 12,
+                                   int slow_period = 26,
+                                   int signal_period = 9);
+    BollingerBands compute_bollinger_bands(PriceView prices, 
                                           int period = 20, 
                                           double std_dev = 2.0);
-    double compute_sma(const std::vector<double>& prices, int period);
-    double compute_ema(const std::vector<double>& prices, int period);
+    double compute_sma(PriceView prices, int period);
+    double compute_ema(PriceView prices, int period);
     double compute_atr(const std::vector<OHLC>& bars, int period = 14);
+    double compute_atr(PriceView high, PriceView low, PriceView close, int period = 14);
+    
+    // Volume indicators. VWAP weights the typical price (high + low +
+    // close) / 3 by volume from the start of the last bar's session (see
+    // IndicatorSpec) and is NaN while the session has no volume. OBV
+    // starts at 0 on the first bar. MFI applies RSI's formula to the
+    // typical-price money flow of the last period bars, 100 when none of
+    // it is negative.
+    double compute_obv(PriceView close, ArrayView<int64_t> volume);
+    double compute_vwap(PriceView high, PriceView low, PriceView close,
+                        ArrayView<int64_t> volume,
+                        ArrayView<int64_t> timestamp = ArrayView<int64_t>(),
+                        int64_t session_seconds = 86400,
+                        int64_t session_offset = 0);
+    double compute_mfi(PriceView high, PriceView low, PriceView close,
+                       ArrayView<int64_t> volume, int period = 14);
+    double compute_volume_sma(ArrayView<int64_t> volume, int period = 20);
+    
+    // Full-series calculations. Each fills caller-provided buffers of the
+    // same length as the input in one O(n) pass; out[i] is the value the
+    // scalar method returns for the first i + 1 bars, and entries before
+    // the warm-up period are NaN. The SMA, Bollinger, ATR and MFI kernels
+    // slide running window sums and recompute them from the window once
+    // per period: out[i] equals the scalar value there and, in between,
+    // differs only by the rounding of fewer than period slides, about
+    // period * 2^-52 times the largest value summed, however long the
+    // series.
+    void compute_sma_series(PriceView prices, SeriesBuffer out, int period);
+    void compute_ema_series(PriceView prices, SeriesBuffer out, int period);
+    void compute_rsi_series(PriceView prices, SeriesBuffer out, int period = 14);
+    void compute_macd_series(PriceView prices,
+                             SeriesBuffer macd_line,
+                             SeriesBuffer signal_line,
+                             SeriesBuffer histogram,
+                             int fast_period = 12,
+                             int slow_period = 26,
+                             int signal_period = 9);
+    void compute_bollinger_series(PriceView prices,
+                                  SeriesBuffer upper,
+                                  SeriesBuffer middle,
+                                  SeriesBuffer lower,
+                                  int period = 20,
+                                  double std_dev = 2.0);
+    void compute_atr_series(PriceView high,
+                            PriceView low,
+                            PriceView close,
+                            SeriesBuffer out,
+                            int period = 14);
+    void compute_obv_series(PriceView close, ArrayView<int64_t> volume, SeriesBuffer out);
+    void compute_vwap_series(PriceView high,
+                             PriceView low,
+                             PriceView close,
+                             ArrayView<int64_t> volume,
+                             ArrayView<int64_t> timestamp,
+                             SeriesBuffer out,
+                             int64_t session_seconds = 86400,
+                             int64_t session_offset = 0);
+    void compute_mfi_series(PriceView high,
+                            PriceView low,
+                            PriceView close,
+                            ArrayView<int64_t> volume,
+                            SeriesBuffer out,
+                            int period = 14);
+    void compute_volume_sma_series(ArrayView<int64_t> volume, SeriesBuffer out, int period = 20);
+    
+    // Cross-sectional calculations over every symbol of a PriceMatrix. The
+    // recursions run along time with the symbols in SIMD lanes, and blocks
+    // of symbols are spread over the thread pool. last[s] gets exactly what
+    // compute_ema / compute_rsi return for symbol s's closes; series, when
+    // not empty, gets the full history in the matrix layout with NaN
+    // warm-up entries.
+    void compute_ema_cross_section(const PriceMatrix& closes, SeriesBuffer last, int period,
+                                   SeriesBuffer series = SeriesBuffer());
+    void compute_rsi_cross_section(const PriceMatrix& closes, SeriesBuffer last, int period = 14,
+                                   SeriesBuffer series = SeriesBuffer());
+    // Single-precision variants that keep the state in float too. Each
+    // step rounds once more than the double recursion, so the EMA stays
+    // within about 1.5 * (period + 1) * 2^-24 * max|close| of the double
+    // result (the rounding errors decay with the smoothing weight), and
+    // RSI within about 100 * (period + 1) * 2^-24 * max|close| /
+    // (avg_gain + avg_loss) points.
+    void compute_ema_cross_section(const PriceMatrixF& closes, MutableArrayView<float> last,
+                                   int period,
+                                   MutableArrayView<float> series = MutableArrayView<float>());
+    void compute_rsi_cross_section(const PriceMatrixF& closes, MutableArrayView<float> last,
+                                   int period = 14,
+                                   MutableArrayView<float> series = MutableArrayView<float>());
     
 private:
+    ThreadPool& pool();
+    
+    // Declared before pool_ so it outlives the workers joined by ~ThreadPool,
+    // which may still be running submit_analysis tasks
+    std::shared_ptr<ResultCache> cache_;
+    std::shared_ptr<ThreadPool> pool_;
+    
     // Helper methods
-    std::vector<double> extract_closes(const std::vector<OHLC>& bars);
-    double compute_std_dev(const std::vector<double>& values, double mean);
+    BarColumns gather_columns(const std::vector<OHLC>& bars, ScratchArena& arena,
+                              bool with_volume = false);
+    double compute_std_dev(PriceView values, double mean);
+    void check_columns(const BarColumns& bars, size_t required_bars, bool needs_range,
+                       bool needs_volume = false);
+    MACDResult compute_macd_pass(PriceView prices,
+                                 int fast_period,
+                                 int slow_period,
+                                 int signal_period,
+                                 SeriesBuffer* macd_line,
+                                 SeriesBuffer* signal_line,
+                                 SeriesBuffer* histogram);
 };
 
 } // namespace indicators
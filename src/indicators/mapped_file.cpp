@@ -0,0 +1,157 @@
+#include "mapped_file.h"
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace indicators {
+
+namespace {
+
+std::runtime_error system_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + ": " + path);
+}
+
+std::string capitalize(std::string text) {
+    if (!text.empty()) {
+        text[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(text[0])));
+    }
+    return text;
+}
+
+} // namespace
+
+void* map_file(const std::string& path, size_t size, bool create, const std::string& kind) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), create ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw system_error("Cannot open " + kind, path);
+    }
+    if (!create) {
+        LARGE_INTEGER file_size;
+        GetFileSizeEx(file, &file_size);
+        if (static_cast<uint64_t>(file_size.QuadPart) < size) {
+            CloseHandle(file);
+            throw system_error(capitalize(kind) + " file is truncated", path);
+        }
+    }
+    const uint64_t mapped = size;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, create ? PAGE_READWRITE : PAGE_READONLY,
+                                        static_cast<DWORD>(mapped >> 32),
+                                        static_cast<DWORD>(mapped & 0xFFFFFFFFu), nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        throw system_error("Cannot map " + kind, path);
+    }
+    void* view = MapViewOfFile(mapping, create ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+    CloseHandle(mapping);
+    if (!view) {
+        throw system_error("Cannot map " + kind, path);
+    }
+    return view;
+#else
+    int fd = ::open(path.c_str(), create ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+    if (fd < 0) {
+        throw system_error("Cannot open " + kind, path);
+    }
+    struct stat info;
+    bool sized = create ? ::ftruncate(fd, static_cast<off_t>(size)) == 0
+                        : ::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= size;
+    if (!sized) {
+        ::close(fd);
+        throw system_error(create ? "Cannot size " + kind : capitalize(kind) + " file is truncated", path);
+    }
+    void* view = ::mmap(nullptr, size, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        throw system_error("Cannot map " + kind, path);
+    }
+    return view;
+#endif
+}
+
+void unmap_file(void* view, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(view);
+#else
+    ::munmap(view, size);
+#endif
+}
+
+void flush_file(void* view, size_t size, const std::string& path, const std::string& kind) {
+#ifdef _WIN32
+    bool flushed = FlushViewOfFile(view, size) != 0;
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        flushed = false;
+    } else {
+        flushed = FlushFileBuffers(file) != 0 && flushed;
+        CloseHandle(file);
+    }
+#else
+    bool flushed = ::msync(view, size, MS_SYNC) == 0;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        flushed = false;
+    } else {
+        flushed = ::fsync(fd) == 0 && flushed;
+        ::close(fd);
+    }
+#endif
+    if (!flushed) {
+        throw system_error("Cannot flush " + kind, path);
+    }
+}
+
+void replace_file(const std::string& from, const std::string& to, const std::string& kind) {
+#ifdef _WIN32
+    bool moved = MoveFileExA(from.c_str(), to.c_str(),
+                             MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    bool moved = std::rename(from.c_str(), to.c_str()) == 0;
+    if (moved) {
+        const size_t slash = to.find_last_of('/');
+        const std::string directory = slash == std::string::npos ? "." : to.substr(0, slash + 1);
+        int fd = ::open(directory.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            // Best effort: some filesystems cannot fsync a directory
+            ::fsync(fd);
+            ::close(fd);
+        }
+    }
+#endif
+    if (!moved) {
+        throw system_error("Cannot replace " + kind, to);
+    }
+}
+
+std::string temporary_path(const std::string& path) {
+    static std::atomic<uint64_t> next{0};
+#ifdef _WIN32
+    const unsigned long process = GetCurrentProcessId();
+#else
+    const unsigned long process = static_cast<unsigned long>(::getpid());
+#endif
+    return path + "." + std::to_string(process) + "." +
+           std::to_string(next.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+}
+
+} // namespace indicators
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace indicators {
+
+// Thin wrappers over mmap/MapViewOfFile shared by the file-backed stores.
+// kind names the store in error messages ("Cannot open <kind>: <path>").
+
+// Map the first size bytes of path. With create the file is created or
+// truncated to size bytes (zero-filled) and mapped writable; otherwise it
+// must already hold at least size bytes and is mapped read-only.
+void* map_file(const std::string& path, size_t size, bool create, const std::string& kind);
+void unmap_file(void* view, size_t size);
+
+// Write a writable mapping of path back and flush the file to stable
+// storage
+void flush_file(void* view, size_t size, const std::string& path, const std::string& kind);
+
+// Move from over to, replacing to if it exists. On POSIX the directory is
+// flushed too, so the rename itself survives a crash.
+void replace_file(const std::string& from, const std::string& to, const std::string& kind);
+
+// Name next to path, distinct for every call in this process and across
+// processes, for writing a file that is then moved over path
+std::string temporary_path(const std::string& path);
+
+} // namespace indicators
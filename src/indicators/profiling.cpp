@@ -0,0 +1,271 @@
+#include "profiling.h"
+
+#if INDICATORS_PROFILING
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#endif
+
+namespace indicators {
+namespace profiling {
+
+const char* probe_name(Probe probe) {
+    switch (probe) {
+        case Probe::COMPUTE_INDICATORS: return "compute_indicators";
+        case Probe::GATHER_COLUMNS: return "gather_columns";
+        case Probe::CLOSE_PASS: return "close_pass";
+        case Probe::BATCH: return "compute_indicators_batch";
+        case Probe::RSI: return "rsi";
+        case Probe::MACD: return "macd";
+        case Probe::BOLLINGER: return "bollinger";
+        case Probe::SMA: return "sma";
+        case Probe::EMA: return "ema";
+        case Probe::ATR: return "atr";
+        case Probe::OBV: return "obv";
+        case Probe::VWAP: return "vwap";
+        case Probe::MFI: return "mfi";
+        case Probe::VOLUME_SMA: return "volume_sma";
+        case Probe::SMA_SERIES: return "sma_series";
+        case Probe::EMA_SERIES: return "ema_series";
+        case Probe::RSI_SERIES: return "rsi_series";
+        case Probe::MACD_SERIES: return "macd_series";
+        case Probe::BOLLINGER_SERIES: return "bollinger_series";
+        case Probe::ATR_SERIES: return "atr_series";
+        case Probe::OBV_SERIES: return "obv_series";
+        case Probe::VWAP_SERIES: return "vwap_series";
+        case Probe::MFI_SERIES: return "mfi_series";
+        case Probe::VOLUME_SMA_SERIES: return "volume_sma_series";
+        case Probe::EMA_CROSS_SECTION: return "ema_cross_section";
+        case Probe::RSI_CROSS_SECTION: return "rsi_cross_section";
+        case Probe::COUNT: break;
+    }
+    return "unknown";
+}
+
+#if INDICATORS_PROFILING
+
+namespace {
+
+// Latency histogram: exact below 16 ns, then 8 sub-buckets per power of two
+constexpr size_t kLinearBuckets = 16;
+constexpr int kSubBucketBits = 3;
+constexpr size_t kSubBuckets = size_t(1) << kSubBucketBits;
+constexpr size_t kBuckets = kLinearBuckets + (64 - 4) * kSubBuckets;
+
+int highest_bit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+size_t bucket_of(uint64_t nanoseconds) {
+    if (nanoseconds < kLinearBuckets) {
+        return static_cast<size_t>(nanoseconds);
+    }
+    int exponent = highest_bit(nanoseconds);
+    size_t sub = static_cast<size_t>(nanoseconds >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return kLinearBuckets + static_cast<size_t>(exponent - 4) * kSubBuckets + sub;
+}
+
+// Midpoint of a bucket
+double bucket_value(size_t bucket) {
+    if (bucket < kLinearBuckets) {
+        return static_cast<double>(bucket);
+    }
+    int exponent = static_cast<int>((bucket - kLinearBuckets) / kSubBuckets) + 4;
+    size_t sub = (bucket - kLinearBuckets) % kSubBuckets;
+    double width = std::ldexp(1.0, exponent - kSubBucketBits);
+    return (kSubBuckets + sub) * width + width / 2.0;
+}
+
+// One thread's counters. Only the owning thread writes them, so updates
+// are a relaxed load and store with no read-modify-write; snapshots read
+// them concurrently.
+struct Counters {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> bars;
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> heap_allocations;
+    std::atomic<uint64_t> total_ns;
+    std::atomic<uint64_t> buckets[kBuckets];
+};
+
+struct ThreadStats {
+    Counters probes[kProbeCount];
+};
+
+struct Totals {
+    uint64_t calls;
+    uint64_t bars;
+    uint64_t allocations;
+    uint64_t heap_allocations;
+    uint64_t total_ns;
+    uint64_t buckets[kBuckets];
+};
+
+using TotalsTable = std::vector<Totals>;
+
+void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void accumulate(TotalsTable& totals, const ThreadStats& stats) {
+    for (size_t p = 0; p < kProbeCount; ++p) {
+        const Counters& counters = stats.probes[p];
+        Totals& total = totals[p];
+        total.calls += counters.calls.load(std::memory_order_relaxed);
+        total.bars += counters.bars.load(std::memory_order_relaxed);
+        total.allocations += counters.allocations.load(std::memory_order_relaxed);
+        total.heap_allocations += counters.heap_allocations.load(std::memory_order_relaxed);
+        total.total_ns += counters.total_ns.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < kBuckets; ++b) {
+            total.buckets[b] += counters.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Live threads plus the totals of threads that have exited. reset() moves
+// the baseline instead of writing other threads' counters.
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadStats*> live;
+    TotalsTable retired = TotalsTable(kProbeCount, Totals{});
+    TotalsTable baseline = TotalsTable(kProbeCount, Totals{});
+    
+    TotalsTable current() const {
+        TotalsTable totals = retired;
+        for (const ThreadStats* stats : live) {
+            accumulate(totals, *stats);
+        }
+        return totals;
+    }
+};
+
+// Leaked so threads exiting during static destruction can still retire
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+struct ThreadSlot {
+    ThreadStats* stats = nullptr;
+    
+    ~ThreadSlot() {
+        if (!stats) {
+            return;
+        }
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        accumulate(shared.retired, *stats);
+        shared.live.erase(std::find(shared.live.begin(), shared.live.end(), stats));
+        delete stats;
+    }
+};
+
+ThreadStats& local_stats() {
+    thread_local ThreadSlot slot;
+    if (!slot.stats) {
+        slot.stats = new ThreadStats();  // value-initialized to zero
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.live.push_back(slot.stats);
+    }
+    return *slot.stats;
+}
+
+double quantile(const Totals& total, double q) {
+    uint64_t rank = static_cast<uint64_t>(std::ceil(q * total.calls));
+    uint64_t seen = 0;
+    for (size_t b = 0; b < kBuckets; ++b) {
+        seen += total.buckets[b];
+        if (seen >= std::max<uint64_t>(rank, 1)) {
+            return bucket_value(b);
+        }
+    }
+    return 0.0;
+}
+
+} // namespace
+
+AllocationCount& thread_allocations() {
+    thread_local AllocationCount count{0, 0};
+    return count;
+}
+
+void record(Probe probe, uint64_t bars, uint64_t nanoseconds, uint64_t allocations,
+            uint64_t heap_allocations) {
+    Counters& counters = local_stats().probes[static_cast<size_t>(probe)];
+    bump(counters.calls, 1);
+    bump(counters.bars, bars);
+    bump(counters.allocations, allocations);
+    bump(counters.heap_allocations, heap_allocations);
+    bump(counters.total_ns, nanoseconds);
+    bump(counters.buckets[bucket_of(nanoseconds)], 1);
+}
+
+std::vector<ProbeStats> snapshot() {
+    TotalsTable totals;
+    {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        totals = shared.current();
+        for (size_t p = 0; p < kProbeCount; ++p) {
+            const Totals& base = shared.baseline[p];
+            Totals& total = totals[p];
+            total.calls -= base.calls;
+            total.bars -= base.bars;
+            total.allocations -= base.allocations;
+            total.heap_allocations -= base.heap_allocations;
+            total.total_ns -= base.total_ns;
+            for (size_t b = 0; b < kBuckets; ++b) {
+                total.buckets[b] -= base.buckets[b];
+            }
+        }
+    }
+    
+    std::vector<ProbeStats> result(kProbeCount);
+    for (size_t p = 0; p < kProbeCount; ++p) {
+        const Totals& total = totals[p];
+        ProbeStats& stats = result[p];
+        stats.name = probe_name(static_cast<Probe>(p));
+        stats.calls = total.calls;
+        stats.bars = total.bars;
+        stats.allocations = total.allocations;
+        stats.heap_allocations = total.heap_allocations;
+        stats.total_ns = total.total_ns;
+        if (total.calls == 0) {
+            continue;
+        }
+        stats.mean_ns = static_cast<double>(total.total_ns) / total.calls;
+        stats.p50_ns = quantile(total, 0.50);
+        stats.p99_ns = quantile(total, 0.99);
+        stats.max_ns = quantile(total, 1.0);
+    }
+    return result;
+}
+
+void reset() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.baseline = shared.current();
+}
+
+#else
+
+std::vector<ProbeStats> snapshot() {
+    return {};
+}
+
+void reset() {}
+
+#endif
+
+} // namespace profiling
+} // namespace indicators
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-indicator timers and counters for the engine hot paths. Compiled in
+// only when INDICATORS_PROFILING is 1 (cmake -DINDICATORS_ENABLE_PROFILING=ON);
+// otherwise INDICATORS_PROFILE expands to nothing and its arguments are not
+// evaluated. The snapshot API exists in both builds and reports enabled().
+#ifndef INDICATORS_PROFILING
+#define INDICATORS_PROFILING 0
+#endif
+
+namespace indicators {
+namespace profiling {
+
+// Instrumented regions. Timings are inclusive: a probe nested inside
+// another (compute_sma inside compute_bollinger_bands) is counted under
+// both.
+enum class Probe {
+    COMPUTE_INDICATORS,
+    GATHER_COLUMNS,  // PriceData bars to scratch columns
+    CLOSE_PASS,      // fused RSI, MACD and EMA pass of compute_indicators
+    BATCH,           // bars counts symbols
+    RSI,
+    MACD,
+    BOLLINGER,
+    SMA,
+    EMA,
+    ATR,
+    OBV,
+    VWAP,
+    MFI,
+    VOLUME_SMA,
+    SMA_SERIES,
+    EMA_SERIES,
+    RSI_SERIES,
+    MACD_SERIES,
+    BOLLINGER_SERIES,
+    ATR_SERIES,
+    OBV_SERIES,
+    VWAP_SERIES,
+    MFI_SERIES,
+    VOLUME_SMA_SERIES,
+    EMA_CROSS_SECTION,  // bars counts symbols x bars
+    RSI_CROSS_SECTION,
+    COUNT
+};
+
+constexpr size_t kProbeCount = static_cast<size_t>(Probe::COUNT);
+
+const char* probe_name(Probe probe);
+
+// Totals for one probe since the last reset(). Latency quantiles come from
+// a log-linear histogram with 8 sub-buckets per power of two, so they are
+// within 12.5% of the exact value.
+struct ProbeStats {
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t bars = 0;              // input bars processed
+    uint64_t allocations = 0;       // scratch-arena allocations
+    uint64_t heap_allocations = 0;  // arena blocks taken from the heap
+    uint64_t total_ns = 0;
+    double mean_ns = 0.0;
+    double p50_ns = 0.0;
+    double p99_ns = 0.0;
+    double max_ns = 0.0;
+};
+
+constexpr bool enabled() { return INDICATORS_PROFILING != 0; }
+
+// One entry per probe, in Probe order, summed over all threads. Empty when
+// profiling is compiled out.
+std::vector<ProbeStats> snapshot();
+// Start counting from zero
+void reset();
+
+#if INDICATORS_PROFILING
+
+using Clock = std::chrono::steady_clock;
+
+// Scratch allocations made by the calling thread so far
+struct AllocationCount {
+    uint64_t allocations;
+    uint64_t heap_allocations;
+};
+
+AllocationCount& thread_allocations();
+void record(Probe probe, uint64_t bars, uint64_t nanoseconds, uint64_t allocations,
+            uint64_t heap_allocations);
+
+// Times its scope and records it under probe on destruction
+class ScopedProbe {
+public:
+    ScopedProbe(Probe probe, size_t bars)
+        : probe_(probe), bars_(bars), allocations_(thread_allocations()), start_(Clock::now()) {}
+    
+    ~ScopedProbe() {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_);
+        const AllocationCount& now = thread_allocations();
+        record(probe_, bars_, static_cast<uint64_t>(elapsed.count()),
+               now.allocations - allocations_.allocations,
+               now.heap_allocations - allocations_.heap_allocations);
+    }
+    
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+private:
+    Probe probe_;
+    uint64_t bars_;
+    AllocationCount allocations_;
+    Clock::time_point start_;
+};
+
+#define INDICATORS_PROFILE_CONCAT_(a, b) a##b
+#define INDICATORS_PROFILE_NAME_(line) INDICATORS_PROFILE_CONCAT_(indicators_probe_, line)
+#define INDICATORS_PROFILE(probe, bars) \
+    ::indicators::profiling::ScopedProbe INDICATORS_PROFILE_NAME_(__LINE__)( \
+        ::indicators::profiling::Probe::probe, (bars))
+
+#else
+
+#define INDICATORS_PROFILE(probe, bars) ((void)0)
+
+#endif
+
+} // namespace profiling
+} // namespace indicators
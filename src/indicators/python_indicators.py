@@ -156,9 +156,10 @@ class PythonIndicatorEngine:
         # MACD line
         macd_line = fast_ema - slow_ema
         
-        # Build MACD history for signal line
+        # Build MACD history for signal line, starting once the slow EMA has
+        # smoothed one price past its seed, as the native engine does
         macd_history = []
-        for i in range(slow_period, len(prices) + 1):
+        for i in range(slow_period + 1, len(prices) + 1):
             subset = prices[:i]
             f_ema = PythonIndicatorEngine.compute_ema(subset, fast_period)
             s_ema = PythonIndicatorEngine.compute_ema(subset, slow_period)
@@ -252,6 +253,121 @@ class PythonIndicatorEngine:
         # ATR is SMA of true ranges
         return PythonIndicatorEngine.compute_sma(true_ranges, period)
     
+    @staticmethod
+    def compute_obv(bars: List[OHLC]) -> float:
+        """
+        Compute On-Balance Volume.
+        
+        Volume is added on bars that close up and subtracted on bars that
+        close down, starting from 0 on the first bar.
+        
+        Args:
+            bars: List of OHLC bars
+        
+        Returns:
+            OBV value
+        """
+        if not bars:
+            raise ValueError("Insufficient data: need 1 bar, got 0")
+        
+        obv = 0
+        for i in range(1, len(bars)):
+            if bars[i].close > bars[i-1].close:
+                obv += bars[i].volume
+            elif bars[i].close < bars[i-1].close:
+                obv -= bars[i].volume
+        return float(obv)
+    
+    @staticmethod
+    def compute_vwap(
+        bars: List[OHLC],
+        session_seconds: int = 86400,
+        session_offset: int = 0
+    ) -> float:
+        """
+        Compute the session-anchored Volume Weighted Average Price.
+        
+        Typical price = (High + Low + Close) / 3, weighted by volume over the
+        bars of the last bar's session, where a bar's session is
+        floor((timestamp - session_offset) / session_seconds).
+        
+        Args:
+            bars: List of OHLC bars
+            session_seconds: Session length in seconds (default: one day)
+            session_offset: Session start offset in seconds
+        
+        Returns:
+            VWAP value, NaN if the session has no volume
+        """
+        if not bars:
+            raise ValueError("Insufficient data: need 1 bar, got 0")
+        if session_seconds <= 0:
+            raise ValueError("VWAP session length must be positive")
+        
+        def session(bar: OHLC) -> int:
+            return (int(bar.timestamp.timestamp()) - session_offset) // session_seconds
+        
+        first = len(bars) - 1
+        while first > 0 and session(bars[first - 1]) == session(bars[-1]):
+            first -= 1
+        
+        price_volume = 0.0
+        total_volume = 0.0
+        for bar in bars[first:]:
+            price_volume += (bar.high + bar.low + bar.close) / 3.0 * bar.volume
+            total_volume += bar.volume
+        return price_volume / total_volume if total_volume > 0 else float('nan')
+    
+    @staticmethod
+    def compute_mfi(bars: List[OHLC], period: int = 14) -> float:
+        """
+        Compute Money Flow Index.
+        
+        Money flow = typical price * volume, positive when the typical price
+        rose and negative when it fell.
+        MFI = 100 - 100 / (1 + positive flow / negative flow) over period bars
+        
+        Args:
+            bars: List of OHLC bars
+            period: MFI period (default: 14)
+        
+        Returns:
+            MFI value (0-100)
+        """
+        if len(bars) < period + 1:
+            raise ValueError(f"Insufficient data: need {period + 1} bars, got {len(bars)}")
+        
+        positive = 0.0
+        negative = 0.0
+        for i in range(len(bars) - period, len(bars)):
+            typical = (bars[i].high + bars[i].low + bars[i].close) / 3.0
+            previous = (bars[i-1].high + bars[i-1].low + bars[i-1].close) / 3.0
+            if typical > previous:
+                positive += typical * bars[i].volume
+            elif typical < previous:
+                negative += typical * bars[i].volume
+        
+        if negative == 0:
+            return 100.0
+        return 100.0 - (100.0 / (1.0 + positive / negative))
+    
+    @staticmethod
+    def compute_volume_sma(bars: List[OHLC], period: int = 20) -> float:
+        """
+        Compute Simple Moving Average of volume.
+        
+        Args:
+            bars: List of OHLC bars
+            period: SMA period (default: 20)
+        
+        Returns:
+            Average volume of the last period bars
+        """
+        if len(bars) < period:
+            raise ValueError(f"Insufficient data: need {period} bars, got {len(bars)}")
+        
+        return sum(bar.volume for bar in bars[-period:]) / period
+    
     @staticmethod
     def compute_indicators(price_data: PriceData) -> IndicatorResults:
         """
@@ -379,3 +495,23 @@ def compute_bollinger_bands(
 def compute_atr(bars: List[OHLC], period: int = 14) -> float:
     """Compute Average True Range."""
     return PythonIndicatorEngine.compute_atr(bars, period)
+
+
+def compute_obv(bars: List[OHLC]) -> float:
+    """Compute On-Balance Volume."""
+    return PythonIndicatorEngine.compute_obv(bars)
+
+
+def compute_vwap(bars: List[OHLC], session_seconds: int = 86400, session_offset: int = 0) -> float:
+    """Compute session-anchored VWAP."""
+    return PythonIndicatorEngine.compute_vwap(bars, session_seconds, session_offset)
+
+
+def compute_mfi(bars: List[OHLC], period: int = 14) -> float:
+    """Compute Money Flow Index."""
+    return PythonIndicatorEngine.compute_mfi(bars, period)
+
+
+def compute_volume_sma(bars: List[OHLC], period: int = 20) -> float:
+    """Compute Simple Moving Average of volume."""
+    return PythonIndicatorEngine.compute_volume_sma(bars, period)
@@ -5,14 +5,17 @@ Publishes indicator results to Redis for real-time consumption.
 
 import logging
 from datetime import datetime
-from typing import Optional, Dict, Any
+from typing import Optional, Dict, Any, Iterable, List
 
-from src.shared.models import IndicatorResults, TechnicalSignals, PriceData
+from src.shared.models import IndicatorResults, TechnicalSignals, PriceData, OHLC
 from src.shared.redis_client import RedisChannels, get_redis_client
-from src.indicators.engine import TechnicalIndicatorEngine
+from src.indicators.engine import TechnicalIndicatorEngine, IncrementalIndicatorState
 
 logger = logging.getLogger(__name__)
 
+# Redis key of a symbol's streaming state snapshot is this prefix plus the symbol
+SNAPSHOT_KEY_PREFIX = "indicator_state:"
+
 
 class IndicatorRedisStreamer:
     """
@@ -31,6 +34,7 @@ class IndicatorRedisStreamer:
         """
         self.engine = engine or TechnicalIndicatorEngine()
         self.redis_client = get_redis_client()
+        self._states: Dict[str, IncrementalIndicatorState] = {}
         logger.info("Indicator Redis streamer initialized")
     
     def compute_and_publish(
@@ -49,16 +53,15 @@ class IndicatorRedisStreamer:
             Computed indicator results
         """
         try:
-            # Compute indicators
-            indicators = self.engine.compute_indicators(price_data)
+            # Compute indicators, reusing the cached analysis of unchanged bars
+            indicators, signals = self.engine.analyze(price_data)
             
             # Publish indicators
             self.publish_indicators(indicators, price_data.symbol)
             
             # Optionally publish signals
-            if publish_signals and price_data.bars:
+            if publish_signals:
                 current_price = price_data.bars[-1].close
-                signals = self.engine.generate_signals(indicators, current_price)
                 self.publish_signals(signals, price_data.symbol, current_price)
             
             logger.debug(f"Published indicators for {price_data.symbol}")
@@ -68,6 +71,209 @@ class IndicatorRedisStreamer:
             logger.error(f"Failed to compute and publish indicators: {e}")
             raise
     
+    async def compute_and_publish_async(
+        self,
+        price_data: PriceData,
+        publish_signals: bool = True
+    ) -> IndicatorResults:
+        """
+        compute_and_publish for asyncio callers.
+        
+        The computation runs on the engine's worker pool, so the event loop
+        keeps serving Redis and other I/O until the results are ready.
+        
+        Args:
+            price_data: Price data with OHLC bars
+            publish_signals: Whether to also publish trading signals
+        
+        Returns:
+            Computed indicator results
+        """
+        try:
+            indicators, signals = await self.engine.analyze_async(price_data)
+            
+            self.publish_indicators(indicators, price_data.symbol)
+            if publish_signals:
+                current_price = price_data.bars[-1].close
+                self.publish_signals(signals, price_data.symbol, current_price)
+            
+            logger.debug(f"Published indicators for {price_data.symbol}")
+            return indicators
+        
+        except Exception as e:
+            logger.error(f"Failed to compute and publish indicators: {e}")
+            raise
+    
+    def push_bar_and_publish(
+        self,
+        symbol: str,
+        bar: OHLC,
+        new_bar: bool = True,
+        publish_signals: bool = True
+    ) -> Optional[IndicatorResults]:
+        """
+        Update the streaming state for a symbol with one bar and publish.
+        
+        Unlike compute_and_publish, only the new bar is processed, so the
+        cost per update does not grow with the history length.
+        
+        Args:
+            symbol: Stock symbol
+            bar: New bar, or the revised most recent bar
+            new_bar: True to append the bar, False to replace the last bar
+            publish_signals: Whether to also publish trading signals
+            
+        Returns:
+            Computed indicator results, or None while the state is warming up
+        """
+        state = self._states.get(symbol)
+        if state is None:
+            state = IncrementalIndicatorState(symbol)
+            self._states[symbol] = state
+        
+        if new_bar or state.bar_count == 0:
+            state.push_bar(bar)
+        else:
+            state.update_last_bar(bar)
+        return self._publish_state(state, symbol, publish_signals)
+    
+    def push_tick_and_publish(
+        self,
+        symbol: str,
+        price: float,
+        volume: int = 0,
+        publish_signals: bool = True
+    ) -> Optional[IndicatorResults]:
+        """
+        Fold one trade into the symbol's forming bar and publish.
+        
+        Only the forming bar's contribution is recomputed, so intrabar
+        indicators can be published at tick rate. Start each bar interval
+        with push_bar_and_publish.
+        
+        Args:
+            symbol: Stock symbol
+            price: Trade price
+            volume: Trade size
+            publish_signals: Whether to also publish trading signals
+        
+        Returns:
+            Computed indicator results, or None while the state is warming up
+        
+        Raises:
+            ValueError: If no bar has been pushed for the symbol yet
+        """
+        state = self._states.get(symbol)
+        if state is None:
+            raise ValueError(f"No bar to update for {symbol}")
+        
+        state.apply_tick(price, volume)
+        return self._publish_state(state, symbol, publish_signals)
+    
+    def _publish_state(
+        self,
+        state: IncrementalIndicatorState,
+        symbol: str,
+        publish_signals: bool
+    ) -> Optional[IndicatorResults]:
+        """Publish a streaming state's current indicators once it is ready."""
+        # Analyses cached from full histories are stale once the feed moves on
+        self.engine.invalidate_cached_results(symbol)
+        
+        if not state.ready:
+            return None
+        
+        try:
+            indicators = state.results()
+            self.publish_indicators(indicators, symbol)
+            
+            if publish_signals:
+                close = state.last_bar.close
+                signals = self.engine.generate_signals(indicators, close)
+                self.publish_signals(signals, symbol, close)
+            
+            return indicators
+        
+        except Exception as e:
+            logger.error(f"Failed to compute and publish streaming indicators: {e}")
+            raise
+    
+    def snapshot_states(self) -> Dict[str, bytes]:
+        """
+        Snapshot the streaming state of every symbol.
+        
+        Returns:
+            Snapshot bytes keyed by symbol
+        """
+        return {symbol: state.snapshot() for symbol, state in self._states.items()}
+    
+    def restore_states(self, snapshots: Dict[str, bytes]) -> List[str]:
+        """
+        Replace streaming states with restored snapshots.
+        
+        A snapshot that cannot be restored (another snapshot version, or
+        truncated or corrupted data) is skipped with a warning, leaving that
+        symbol to warm up from a full replay.
+        
+        Args:
+            snapshots: Snapshot bytes keyed by symbol
+        
+        Returns:
+            Symbols whose state was restored; push the bars after each
+            state's last_bar to bring them up to date
+        """
+        restored = []
+        for symbol, data in snapshots.items():
+            try:
+                self._states[symbol] = IncrementalIndicatorState.restore(symbol, data)
+            except ValueError as e:
+                logger.warning(f"Discarding state snapshot for {symbol}: {e}")
+                continue
+            self.engine.invalidate_cached_results(symbol)
+            restored.append(symbol)
+        return restored
+    
+    def save_snapshots(self, prefix: str = SNAPSHOT_KEY_PREFIX) -> int:
+        """
+        Write every symbol's state snapshot to Redis.
+        
+        Call periodically, e.g. once a minute, so a restart only replays
+        the bars since the last save.
+        
+        Args:
+            prefix: Key prefix; each key is prefix + symbol
+        
+        Returns:
+            Number of snapshots written
+        """
+        snapshots = self.snapshot_states()
+        if snapshots:
+            self.redis_client.client.mset(
+                {f"{prefix}{symbol}": data for symbol, data in snapshots.items()}
+            )
+        logger.debug(f"Saved {len(snapshots)} indicator state snapshots")
+        return len(snapshots)
+    
+    def load_snapshots(self, symbols: Iterable[str], prefix: str = SNAPSHOT_KEY_PREFIX) -> List[str]:
+        """
+        Restore streaming states from snapshots saved in Redis.
+        
+        Args:
+            symbols: Symbols to restore
+            prefix: Key prefix used by save_snapshots
+        
+        Returns:
+            Symbols whose state was restored
+        """
+        symbols = list(symbols)
+        if not symbols:
+            return []
+        values = self.redis_client.client.mget([f"{prefix}{symbol}" for symbol in symbols])
+        snapshots = {symbol: data for symbol, data in zip(symbols, values) if data is not None}
+        restored = self.restore_states(snapshots)
+        logger.info(f"Restored {len(restored)} of {len(symbols)} indicator states from Redis")
+        return restored
+    
     def publish_indicators(
         self,
         indicators: IndicatorResults,
@@ -0,0 +1,102 @@
+#include "result_cache.h"
+#include <functional>
+#include <stdexcept>
+
+namespace indicators {
+
+bool ResultKey::operator==(const ResultKey& other) const {
+    // NaN fields never compare equal, so such bars are simply not cached
+    return bar_count == other.bar_count &&
+           last_bar.timestamp == other.last_bar.timestamp &&
+           last_bar.open == other.last_bar.open &&
+           last_bar.high == other.last_bar.high &&
+           last_bar.low == other.last_bar.low &&
+           last_bar.close == other.last_bar.close &&
+           last_bar.volume == other.last_bar.volume;
+}
+
+ResultKey result_key(const PriceData& prices) {
+    if (prices.bars.empty()) {
+        throw std::invalid_argument("Empty price data");
+    }
+    return ResultKey{prices.bars.size(), prices.bars.back()};
+}
+
+ResultKey result_key(const BarColumns& bars) {
+    const size_t n = bars.size();
+    auto matches = [n](size_t size) { return size == n || size == 0; };
+    if (!matches(bars.open.size()) || !matches(bars.high.size()) || !matches(bars.low.size()) ||
+        !matches(bars.volume.size()) || !matches(bars.timestamp.size())) {
+        throw std::invalid_argument("Bar column lengths do not match");
+    }
+    if (n == 0) {
+        throw std::invalid_argument("Empty price data");
+    }
+    
+    // Absent columns key as zero
+    OHLC last{};
+    last.open = bars.open.empty() ? 0.0 : bars.open[n - 1];
+    last.high = bars.high.empty() ? 0.0 : bars.high[n - 1];
+    last.low = bars.low.empty() ? 0.0 : bars.low[n - 1];
+    last.close = bars.close[n - 1];
+    last.volume = bars.volume.empty() ? 0 : bars.volume[n - 1];
+    last.timestamp = bars.timestamp.empty() ? 0 : bars.timestamp[n - 1];
+    return ResultKey{n, last};
+}
+
+ResultCache::ResultCache(size_t shards)
+    : shards_(new Shard[shards == 0 ? 1 : shards]),
+      shard_count_(shards == 0 ? 1 : shards),
+      hits_(0),
+      misses_(0) {}
+
+ResultCache::Shard& ResultCache::shard(const std::string& symbol) const {
+    return shards_[std::hash<std::string>()(symbol) % shard_count_];
+}
+
+bool ResultCache::lookup(const std::string& symbol, const ResultKey& key,
+                         IndicatorAnalysis& out) const {
+    Shard& owner = shard(symbol);
+    {
+        std::lock_guard<std::mutex> lock(owner.mutex);
+        auto it = owner.entries.find(symbol);
+        if (it != owner.entries.end() && it->second.key == key) {
+            out = it->second.analysis;
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void ResultCache::store(const std::string& symbol, const ResultKey& key,
+                        const IndicatorAnalysis& analysis) {
+    Shard& owner = shard(symbol);
+    std::lock_guard<std::mutex> lock(owner.mutex);
+    owner.entries[symbol] = Entry{key, analysis};
+}
+
+void ResultCache::invalidate(const std::string& symbol) {
+    Shard& owner = shard(symbol);
+    std::lock_guard<std::mutex> lock(owner.mutex);
+    owner.entries.erase(symbol);
+}
+
+void ResultCache::clear() {
+    for (size_t i = 0; i < shard_count_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        shards_[i].entries.clear();
+    }
+}
+
+size_t ResultCache::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shard_count_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        total += shards_[i].entries.size();
+    }
+    return total;
+}
+
+} // namespace indicators
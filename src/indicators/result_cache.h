@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "indicators.h"
+
+namespace indicators {
+
+// Identifies the bars an analysis was computed from: the bar count and the
+// whole last bar, so a revised forming bar misses as well as a new bar
+struct ResultKey {
+    size_t bar_count;
+    OHLC last_bar;
+    
+    bool operator==(const ResultKey& other) const;
+};
+
+ResultKey result_key(const PriceData& prices);
+ResultKey result_key(const BarColumns& bars);
+
+// Latest analysis per symbol, shared by concurrent readers. Symbols are
+// spread over independently locked shards so lookups for different symbols
+// rarely contend. An entry only answers lookups with its exact key; storing
+// a newer key for the symbol replaces it.
+class ResultCache {
+public:
+    explicit ResultCache(size_t shards = 16);
+    
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+    
+    // Copy the cached analysis into out if symbol's entry has this key
+    bool lookup(const std::string& symbol, const ResultKey& key, IndicatorAnalysis& out) const;
+    void store(const std::string& symbol, const ResultKey& key, const IndicatorAnalysis& analysis);
+    // Drop symbol's entry, e.g. when a new bar arrives
+    void invalidate(const std::string& symbol);
+    void clear();
+    
+    size_t size() const;
+    uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        ResultKey key;
+        IndicatorAnalysis analysis;
+    };
+    
+    // Own cache line per shard so neighbouring locks do not false-share
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+    };
+    
+    Shard& shard(const std::string& symbol) const;
+    
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_count_;
+    mutable std::atomic<uint64_t> hits_;
+    mutable std::atomic<uint64_t> misses_;
+};
+
+} // namespace indicators
@@ -0,0 +1,150 @@
+#include "result_codec.h"
+#include "byte_order.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace indicators {
+
+namespace {
+
+const unsigned char kMagic[4] = {'E', 'D', 'I', 'R'};
+
+SignalType load_signal(const unsigned char* in) {
+    if (*in > static_cast<unsigned char>(SignalType::NEUTRAL)) {
+        throw std::invalid_argument("Encoded results: invalid signal type " + std::to_string(*in));
+    }
+    return static_cast<SignalType>(*in);
+}
+
+void encode_record(const ResultRecord& record, unsigned char* out) {
+    using namespace result_codec;
+    if (record.symbol.size() > kMaxSymbolLength) {
+        throw std::invalid_argument("Encoded results: symbol '" + record.symbol + "' is longer than " +
+                                    std::to_string(kMaxSymbolLength) + " characters");
+    }
+    std::memset(out, 0, kRecordSize);
+    std::memcpy(out, record.symbol.data(), record.symbol.size());
+    store_u64(out + 16, static_cast<uint64_t>(record.timestamp));
+    
+    const IndicatorResults& r = record.indicators;
+    const double values[kValueCount] = {
+        r.rsi, r.macd.macd_line, r.macd.signal_line, r.macd.histogram,
+        r.bollinger.upper, r.bollinger.middle, r.bollinger.lower,
+        r.sma_20, r.sma_50, r.ema_12, r.ema_26, r.atr};
+    for (size_t i = 0; i < kValueCount; ++i) {
+        store_f64(out + kValuesOffset + 8 * i, values[i]);
+    }
+    
+    if (record.has_signals) {
+        out[kSignalsOffset] = static_cast<unsigned char>(record.signals.rsi_signal);
+        out[kSignalsOffset + 1] = static_cast<unsigned char>(record.signals.macd_signal);
+        out[kSignalsOffset + 2] = static_cast<unsigned char>(record.signals.bb_signal);
+        out[kFlagsOffset] = kHasSignals;
+    }
+}
+
+} // namespace
+
+size_t encoded_results_size(size_t count) {
+    return result_codec::kHeaderSize + count * result_codec::kRecordSize;
+}
+
+void encode_results(const ResultRecord* records, size_t count, unsigned char* out) {
+    using namespace result_codec;
+    if (count > UINT32_MAX) {
+        throw std::invalid_argument("Encoded results: too many records for one batch");
+    }
+    std::memcpy(out, kMagic, sizeof(kMagic));
+    store_u16(out + 4, kVersion);
+    store_u16(out + 6, static_cast<uint16_t>(kRecordSize));
+    store_u32(out + 8, static_cast<uint32_t>(count));
+    store_u32(out + 12, 0);
+    for (size_t i = 0; i < count; ++i) {
+        encode_record(records[i], out + kHeaderSize + i * kRecordSize);
+    }
+}
+
+std::vector<unsigned char> encode_results(const std::vector<ResultRecord>& records) {
+    std::vector<unsigned char> out(encoded_results_size(records.size()));
+    encode_results(records.data(), records.size(), out.data());
+    return out;
+}
+
+// Result record view
+std::string ResultRecordView::symbol() const {
+    const char* text = reinterpret_cast<const char*>(data_);
+    return std::string(text, std::find(text, text + result_codec::kMaxSymbolLength + 1, '\0'));
+}
+
+int64_t ResultRecordView::timestamp() const {
+    return static_cast<int64_t>(load_u64(data_ + 16));
+}
+
+IndicatorResults ResultRecordView::indicators() const {
+    const unsigned char* values = data_ + result_codec::kValuesOffset;
+    IndicatorResults r;
+    r.rsi = load_f64(values);
+    r.macd = MACDResult{load_f64(values + 8), load_f64(values + 16), load_f64(values + 24)};
+    r.bollinger = BollingerBands{load_f64(values + 32), load_f64(values + 40), load_f64(values + 48)};
+    r.sma_20 = load_f64(values + 56);
+    r.sma_50 = load_f64(values + 64);
+    r.ema_12 = load_f64(values + 72);
+    r.ema_26 = load_f64(values + 80);
+    r.atr = load_f64(values + 88);
+    return r;
+}
+
+bool ResultRecordView::has_signals() const {
+    return (data_[result_codec::kFlagsOffset] & result_codec::kHasSignals) != 0;
+}
+
+TechnicalSignals ResultRecordView::signals() const {
+    const unsigned char* signals = data_ + result_codec::kSignalsOffset;
+    return TechnicalSignals{load_signal(signals), load_signal(signals + 1), load_signal(signals + 2)};
+}
+
+ResultRecord ResultRecordView::to_record() const {
+    ResultRecord record;
+    record.symbol = symbol();
+    record.timestamp = timestamp();
+    record.indicators = indicators();
+    record.has_signals = has_signals();
+    if (record.has_signals) {
+        record.signals = signals();
+    }
+    return record;
+}
+
+// Result batch view
+ResultBatchView::ResultBatchView(const void* data, size_t size) {
+    using namespace result_codec;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    if (size < kHeaderSize || std::memcmp(bytes, kMagic, sizeof(kMagic)) != 0) {
+        throw std::invalid_argument("Encoded results: missing header");
+    }
+    // Later versions only append fields, so their version 1 prefix is read
+    uint16_t version = load_u16(bytes + 4);
+    if (version < kVersion) {
+        throw std::invalid_argument("Encoded results: unsupported version " + std::to_string(version));
+    }
+    record_size_ = load_u16(bytes + 6);
+    if (record_size_ < kRecordSize) {
+        throw std::invalid_argument("Encoded results: record size " + std::to_string(record_size_) +
+                                    " is below the version 1 layout");
+    }
+    count_ = load_u32(bytes + 8);
+    if ((size - kHeaderSize) / record_size_ < count_) {
+        throw std::invalid_argument("Encoded results: buffer is shorter than its record count");
+    }
+    records_ = bytes + kHeaderSize;
+}
+
+ResultRecordView ResultBatchView::at(size_t i) const {
+    if (i >= count_) {
+        throw std::out_of_range("Encoded results: record index out of range");
+    }
+    return (*this)[i];
+}
+
+} // namespace indicators
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "indicators.h"
+
+namespace indicators {
+
+// One published indicator update
+struct ResultRecord {
+    std::string symbol;
+    int64_t timestamp = 0;  // Unix seconds
+    IndicatorResults indicators{};
+    TechnicalSignals signals{};
+    bool has_signals = false;
+};
+
+// Fixed-layout binary encoding of ResultRecord batches, the compact
+// alternative to the JSON dicts published on RedisChannels.INDICATORS.
+// Every integer and double is little-endian regardless of the host.
+//
+//   header (kHeaderSize bytes)
+//     0   char[4]     magic "EDIR"
+//     4   uint16      version
+//     6   uint16      record size in bytes
+//     8   uint32      record count
+//     12  uint32      reserved, 0
+//   record (record size bytes, kRecordSize for version 1)
+//     0   char[16]    symbol, NUL-padded
+//     16  int64       timestamp
+//     24  double[12]  rsi, macd line, signal, histogram, bollinger upper,
+//                     middle, lower, sma_20, sma_50, ema_12, ema_26, atr
+//     120 uint8[3]    rsi, macd, bollinger SignalType
+//     123 uint8       flags, bit 0: signals present
+//     124 uint8[4]    reserved, 0
+//
+// A later version may only append fields to the record. Readers accept any
+// version from 1 on, step by the record size in the header and read the
+// version 1 prefix of each record, so older readers keep working.
+namespace result_codec {
+
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderSize = 16;
+constexpr size_t kRecordSize = 128;
+constexpr size_t kMaxSymbolLength = 15;
+constexpr size_t kValueCount = 12;
+constexpr size_t kValuesOffset = 24;
+constexpr size_t kSignalsOffset = 120;
+constexpr size_t kFlagsOffset = 123;
+constexpr uint8_t kHasSignals = 1;
+
+} // namespace result_codec
+
+size_t encoded_results_size(size_t count);
+// Encode into out, which must hold encoded_results_size(count) bytes
+void encode_results(const ResultRecord* records, size_t count, unsigned char* out);
+std::vector<unsigned char> encode_results(const std::vector<ResultRecord>& records);
+
+// Reads the fields of one encoded record in place
+class ResultRecordView {
+public:
+    explicit ResultRecordView(const unsigned char* data) : data_(data) {}
+    
+    std::string symbol() const;
+    int64_t timestamp() const;
+    IndicatorResults indicators() const;
+    bool has_signals() const;
+    // Throws std::invalid_argument on an out-of-range SignalType
+    TechnicalSignals signals() const;
+    ResultRecord to_record() const;
+
+private:
+    const unsigned char* data_;
+};
+
+// Validates the header of an encoded batch and indexes its records
+// without copying; the buffer must outlive the view
+class ResultBatchView {
+public:
+    ResultBatchView(const void* data, size_t size);
+    
+    size_t size() const { return count_; }
+    size_t record_size() const { return record_size_; }
+    const unsigned char* records() const { return records_; }
+    
+    ResultRecordView operator[](size_t i) const {
+        return ResultRecordView(records_ + i * record_size_);
+    }
+    // Throws std::out_of_range
+    ResultRecordView at(size_t i) const;
+
+private:
+    const unsigned char* records_;
+    size_t record_size_;
+    size_t count_;
+};
+
+} // namespace indicators
@@ -0,0 +1,66 @@
+#include "scratch_arena.h"
+#include "profiling.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace indicators {
+
+namespace {
+
+// First block size; later blocks double so growth takes O(log n) steps
+const size_t kMinBlockSize = 64 * 1024;
+
+size_t round_up(size_t bytes, size_t alignment) {
+    return (bytes + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+ScratchArena& ScratchArena::local() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+size_t ScratchArena::capacity() const {
+    size_t total = 0;
+    for (const auto& block : blocks_) {
+        total += block.size;
+    }
+    return total;
+}
+
+void* ScratchArena::allocate_bytes(size_t bytes) {
+    bytes = round_up(std::max<size_t>(bytes, 1), kAlignment);
+#if INDICATORS_PROFILING
+    ++profiling::thread_allocations().allocations;
+#endif
+    
+    // Reuse retained blocks first
+    while (block_ < blocks_.size()) {
+        Block& block = blocks_[block_];
+        if (block.size - offset_ >= bytes) {
+            void* result = block.data + offset_;
+            offset_ += bytes;
+            return result;
+        }
+        ++block_;
+        offset_ = 0;
+    }
+    
+#if INDICATORS_PROFILING
+    ++profiling::thread_allocations().heap_allocations;
+#endif
+    size_t size = std::max({bytes, kMinBlockSize, blocks_.empty() ? 0 : 2 * blocks_.back().size});
+    Block block;
+    block.storage.reset(new unsigned char[size + kAlignment - 1]);
+    auto address = reinterpret_cast<uintptr_t>(block.storage.get());
+    block.data = reinterpret_cast<unsigned char*>(round_up(address, kAlignment));
+    block.size = size;
+    blocks_.push_back(std::move(block));
+    
+    block_ = blocks_.size() - 1;
+    offset_ = bytes;
+    return blocks_.back().data;
+}
+
+} // namespace indicators
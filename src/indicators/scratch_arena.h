@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace indicators {
+
+// Per-thread monotonic scratch memory for temporaries inside one compute
+// call. Allocation bumps a pointer; a Scope rewinds the arena to where it
+// was when the scope opened. Blocks are kept across calls, so once the
+// arena has grown to a call's working set, later calls of that size do
+// not touch the heap.
+class ScratchArena {
+public:
+    static constexpr size_t kAlignment = 64;
+    
+    // Rewinds the arena on destruction. Scopes nest and must be closed in
+    // reverse order of opening, which holds for RAII use on one thread.
+    class Scope {
+    public:
+        explicit Scope(ScratchArena& arena)
+            : arena_(arena), block_(arena.block_), offset_(arena.offset_) {}
+        ~Scope() {
+            arena_.block_ = block_;
+            arena_.offset_ = offset_;
+        }
+        
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    
+    private:
+        ScratchArena& arena_;
+        size_t block_;
+        size_t offset_;
+    };
+    
+    ScratchArena() = default;
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+    
+    // Arena of the calling thread
+    static ScratchArena& local();
+    
+    // Uninitialized storage for count objects, aligned to kAlignment
+    template <typename T>
+    T* allocate(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Scratch memory is released without running destructors");
+        return static_cast<T*>(allocate_bytes(count * sizeof(T)));
+    }
+    
+    // Bytes held in blocks, used or not
+    size_t capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> storage;
+        unsigned char* data;
+        size_t size;
+    };
+    
+    void* allocate_bytes(size_t bytes);
+    
+    std::vector<Block> blocks_;
+    size_t block_ = 0;
+    size_t offset_ = 0;
+};
+
+} // namespace indicators
@@ -0,0 +1,213 @@
+#include "indicators.h"
+#include "profiling.h"
+#include "simd_kernels.h"
+#include <cmath>
+#include <limits>
+
+namespace indicators {
+
+namespace {
+
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+void check_period(int period) {
+    if (period <= 0) {
+        throw std::invalid_argument("Indicator period must be positive");
+    }
+}
+
+// Validate an output buffer against the input length and clear it to NaN
+void prepare_output(SeriesBuffer out, size_t size) {
+    if (out.size() != size) {
+        throw std::invalid_argument("Output buffer length does not match input length");
+    }
+    std::fill(out.data(), out.data() + out.size(), kNaN);
+}
+
+double true_range(PriceView high, PriceView low, PriceView close, size_t i) {
+    double high_low = high[i] - low[i];
+    double high_close = std::abs(high[i] - close[i - 1]);
+    double low_close = std::abs(low[i] - close[i - 1]);
+    return std::max({high_low, high_close, low_close});
+}
+
+} // namespace
+
+// Simple Moving Average series from a running window sum, re-anchored from
+// the prices once per window so long runs do not accumulate drift
+void TechnicalIndicatorEngine::compute_sma_series(PriceView prices, SeriesBuffer out, int period) {
+    INDICATORS_PROFILE(SMA_SERIES, prices.size());
+    check_period(period);
+    prepare_output(out, prices.size());
+    
+    const size_t window = static_cast<size_t>(period);
+    double sum = 0.0;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        if ((i + 1) % window == 0) {
+            // Summed as compute_sma sums its window
+            sum = simd::sum(prices.data() + i + 1 - window, window);
+        } else {
+            sum += prices[i];
+            if (i >= window) {
+                sum -= prices[i - window];
+            }
+        }
+        if (i + 1 >= window) {
+            out[i] = sum / period;
+        }
+    }
+}
+
+// Exponential Moving Average series, seeded with the SMA of the first period
+void TechnicalIndicatorEngine::compute_ema_series(PriceView prices, SeriesBuffer out, int period) {
+    INDICATORS_PROFILE(EMA_SERIES, prices.size());
+    check_period(period);
+    prepare_output(out, prices.size());
+    
+    const size_t window = static_cast<size_t>(period);
+    const double multiplier = 2.0 / (period + 1.0);
+    double ema = 0.0;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        if (i < window) {
+            ema += prices[i];
+            if (i + 1 < window) {
+                continue;
+            }
+            ema /= period;
+        } else {
+            ema = (prices[i] - ema) * multiplier + ema;
+        }
+        out[i] = ema;
+    }
+}
+
+// Relative Strength Index series with Wilder smoothing
+void TechnicalIndicatorEngine::compute_rsi_series(PriceView prices, SeriesBuffer out, int period) {
+    INDICATORS_PROFILE(RSI_SERIES, prices.size());
+    check_period(period);
+    prepare_output(out, prices.size());
+    
+    const size_t window = static_cast<size_t>(period);
+    double avg_gain = 0.0;
+    double avg_loss = 0.0;
+    for (size_t i = 1; i < prices.size(); ++i) {
+        double change = prices[i] - prices[i - 1];
+        double gain = (change > 0) ? change : 0.0;
+        double loss = (change < 0) ? std::abs(change) : 0.0;
+        
+        if (i <= window) {
+            avg_gain += gain;
+            avg_loss += loss;
+            if (i < window) {
+                continue;
+            }
+            avg_gain /= period;
+            avg_loss /= period;
+        } else {
+            avg_gain = (avg_gain * (period - 1) + gain) / period;
+            avg_loss = (avg_loss * (period - 1) + loss) / period;
+        }
+        
+        if (avg_loss == 0.0) {
+            out[i] = 100.0;
+        } else {
+            double rs = avg_gain / avg_loss;
+            out[i] = 100.0 - (100.0 / (1.0 + rs));
+        }
+    }
+}
+
+// MACD series into caller-provided buffers
+void TechnicalIndicatorEngine::compute_macd_series(PriceView prices,
+                                                   SeriesBuffer macd_line,
+                                                   SeriesBuffer signal_line,
+                                                   SeriesBuffer histogram,
+                                                   int fast_period,
+                                                   int slow_period,
+                                                   int signal_period) {
+    INDICATORS_PROFILE(MACD_SERIES, prices.size());
+    check_period(fast_period);
+    check_period(slow_period);
+    check_period(signal_period);
+    prepare_output(macd_line, prices.size());
+    prepare_output(signal_line, prices.size());
+    prepare_output(histogram, prices.size());
+    
+    if (prices.size() < static_cast<size_t>(slow_period + signal_period)) {
+        return;
+    }
+    compute_macd_pass(prices, fast_period, slow_period, signal_period,
+                      &macd_line, &signal_line, &histogram);
+}
+
+// Bollinger Bands series from a rolling mean and variance, re-anchored from
+// the prices once per window so long runs do not accumulate drift
+void TechnicalIndicatorEngine::compute_bollinger_series(PriceView prices,
+                                                        SeriesBuffer upper,
+                                                        SeriesBuffer middle,
+                                                        SeriesBuffer lower,
+                                                        int period,
+                                                        double std_dev) {
+    INDICATORS_PROFILE(BOLLINGER_SERIES, prices.size());
+    check_period(period);
+    prepare_output(upper, prices.size());
+    prepare_output(middle, prices.size());
+    prepare_output(lower, prices.size());
+    
+    const size_t window = static_cast<size_t>(period);
+    RollingMoments moments;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        if (i < window) {
+            moments.add(prices[i]);
+        } else if ((i + 1) % window == 0) {
+            moments.reset(prices.data() + i + 1 - window, window);
+        } else {
+            moments.replace(prices[i - window], prices[i]);
+        }
+        if (i + 1 < window) {
+            continue;
+        }
+        
+        double mean = moments.mean();
+        double std = std::sqrt(moments.variance());
+        middle[i] = mean;
+        upper[i] = mean + (std_dev * std);
+        lower[i] = mean - (std_dev * std);
+    }
+}
+
+// Average True Range series as a running SMA of true ranges, re-anchored
+// from the bars once per window so long runs do not accumulate drift
+void TechnicalIndicatorEngine::compute_atr_series(PriceView high,
+                                                  PriceView low,
+                                                  PriceView close,
+                                                  SeriesBuffer out,
+                                                  int period) {
+    INDICATORS_PROFILE(ATR_SERIES, close.size());
+    check_period(period);
+    if (high.size() != close.size() || low.size() != close.size()) {
+        throw std::invalid_argument("High, low and close lengths do not match");
+    }
+    prepare_output(out, close.size());
+    
+    const size_t window = static_cast<size_t>(period);
+    double sum = 0.0;
+    for (size_t i = 1; i < close.size(); ++i) {
+        if (i % window == 0) {
+            // Summed as compute_atr sums its window
+            size_t first = i + 1 - window;
+            sum = simd::sum_true_range(high.data() + first, low.data() + first,
+                                       close.data() + first - 1, window);
+        } else {
+            sum += true_range(high, low, close, i);
+            if (i > window) {
+                sum -= true_range(high, low, close, i - window);
+            }
+        }
+        if (i >= window) {
+            out[i] = sum / period;
+        }
+    }
+}
+
+} // namespace indicators
@@ -0,0 +1,254 @@
+#include "shared_bar_ring.h"
+#include "bar_series.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+namespace indicators {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x474E495252414245ULL;  // "EBARRING" little-endian
+constexpr size_t kBarWords = 6;
+constexpr int kMaxReadRestarts = 16;
+// Attempts at one slot before read() gives up with BUSY. The producer is
+// another process and may die or be descheduled mid-write, so a reader
+// yields between attempts instead of spinning on it forever.
+constexpr int kMaxSlotRetries = 64;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Shared bar ring needs lock-free 64-bit atomics");
+static_assert(sizeof(OHLC) == kBarWords * sizeof(uint64_t), "Unexpected OHLC layout");
+
+const char* const kKind = "bar ring";
+
+std::runtime_error system_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + ": " + path);
+}
+
+} // namespace
+
+// Mapped layout: a header on its own cache lines, then capacity slots of one
+// cache line each. The payload is stored as relaxed atomic words so the
+// concurrent reads that the seqlock retries are not data races.
+struct SharedBarRing::Header {
+    uint64_t magic;
+    uint32_t layout_version;
+    uint32_t reserved;
+    uint64_t capacity;
+    char symbol[kMaxSymbolLength + 1];
+    alignas(64) std::atomic<uint64_t> write_count;
+};
+
+struct alignas(64) SharedBarRing::Slot {
+    std::atomic<uint64_t> sequence;  // odd while being written
+    std::atomic<uint64_t> index;
+    std::atomic<uint64_t> words[kBarWords];
+};
+
+static_assert(sizeof(SharedBarRing::Slot) == 64, "Ring slots should fill one cache line");
+
+namespace {
+
+size_t mapping_size(size_t capacity) {
+    return sizeof(SharedBarRing::Header) + capacity * sizeof(SharedBarRing::Slot);
+}
+
+} // namespace
+
+SharedBarRing SharedBarRing::create(const std::string& path, const std::string& symbol,
+                                    size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Bar ring capacity must be positive");
+    }
+    if (symbol.size() > kMaxSymbolLength) {
+        throw std::invalid_argument("Bar ring symbol is longer than " +
+                                    std::to_string(kMaxSymbolLength) + " characters");
+    }
+    
+    const size_t size = mapping_size(capacity);
+    SharedBarRing ring(map_file(path, size, true, kKind), size, true);
+    // ftruncate zero-fills, so slots start with sequence 0 (never written)
+    Header& header = ring.header();
+    header.layout_version = kLayoutVersion;
+    header.capacity = capacity;
+    std::memset(header.symbol, 0, sizeof(header.symbol));
+    std::memcpy(header.symbol, symbol.data(), symbol.size());
+    header.write_count.store(0, std::memory_order_relaxed);
+    // Consumers check the magic, so publish it last
+    std::atomic_thread_fence(std::memory_order_release);
+    header.magic = kMagic;
+    return ring;
+}
+
+SharedBarRing SharedBarRing::open(const std::string& path) {
+    SharedBarRing probe(map_file(path, sizeof(Header), false, kKind), sizeof(Header), false);
+    const Header& header = probe.header();
+    if (header.magic != kMagic) {
+        throw system_error("Not an initialized bar ring", path);
+    }
+    if (header.layout_version != kLayoutVersion) {
+        throw system_error("Unsupported bar ring layout version " +
+                           std::to_string(header.layout_version), path);
+    }
+    const size_t size = mapping_size(static_cast<size_t>(header.capacity));
+    return SharedBarRing(map_file(path, size, false, kKind), size, false);
+}
+
+SharedBarRing::SharedBarRing(void* mapping, size_t size, bool writable)
+    : mapping_(mapping), size_(size), writable_(writable) {}
+
+SharedBarRing::SharedBarRing(SharedBarRing&& other) noexcept
+    : mapping_(other.mapping_), size_(other.size_), writable_(other.writable_) {
+    other.mapping_ = nullptr;
+}
+
+SharedBarRing& SharedBarRing::operator=(SharedBarRing&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        mapping_ = other.mapping_;
+        size_ = other.size_;
+        writable_ = other.writable_;
+        other.mapping_ = nullptr;
+    }
+    return *this;
+}
+
+SharedBarRing::~SharedBarRing() {
+    unmap();
+}
+
+void SharedBarRing::unmap() {
+    if (mapping_) {
+        unmap_file(mapping_, size_);
+        mapping_ = nullptr;
+    }
+}
+
+SharedBarRing::Header& SharedBarRing::header() const {
+    return *static_cast<Header*>(mapping_);
+}
+
+SharedBarRing::Slot& SharedBarRing::slot(uint64_t index) const {
+    Slot* slots = reinterpret_cast<Slot*>(static_cast<unsigned char*>(mapping_) + sizeof(Header));
+    return slots[index % header().capacity];
+}
+
+size_t SharedBarRing::capacity() const {
+    return static_cast<size_t>(header().capacity);
+}
+
+std::string SharedBarRing::symbol() const {
+    return std::string(header().symbol);
+}
+
+uint64_t SharedBarRing::write_count() const {
+    return header().write_count.load(std::memory_order_acquire);
+}
+
+namespace {
+
+void write_slot(SharedBarRing::Slot& slot, uint64_t index, const OHLC& bar) {
+    uint64_t words[kBarWords];
+    std::memcpy(words, &bar, sizeof(bar));
+    
+    uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.index.store(index, std::memory_order_relaxed);
+    for (size_t i = 0; i < kBarWords; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+} // namespace
+
+void SharedBarRing::push(const OHLC& bar) {
+    if (!writable_) {
+        throw std::runtime_error("Bar ring is opened read-only");
+    }
+    Header& ring = header();
+    uint64_t index = ring.write_count.load(std::memory_order_relaxed);
+    write_slot(slot(index), index, bar);
+    ring.write_count.store(index + 1, std::memory_order_release);
+}
+
+void SharedBarRing::update_last(const OHLC& bar) {
+    if (!writable_) {
+        throw std::runtime_error("Bar ring is opened read-only");
+    }
+    uint64_t count = header().write_count.load(std::memory_order_relaxed);
+    if (count == 0) {
+        throw std::runtime_error("No bar to update");
+    }
+    write_slot(slot(count - 1), count - 1, bar);
+}
+
+SharedBarRing::ReadStatus SharedBarRing::read(uint64_t index, OHLC& bar) const {
+    const uint64_t count = write_count();
+    if (index >= count) {
+        return ReadStatus::NOT_WRITTEN;
+    }
+    if (count - index > header().capacity) {
+        return ReadStatus::OVERWRITTEN;
+    }
+    
+    const Slot& entry = slot(index);
+    uint64_t words[kBarWords];
+    uint64_t stored_index;
+    bool consistent = false;
+    for (int attempt = 0; attempt < kMaxSlotRetries && !consistent; ++attempt) {
+        if (attempt > 0) {
+            std::this_thread::yield();
+        }
+        uint64_t before = entry.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;  // writer is mid-update
+        }
+        stored_index = entry.index.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kBarWords; ++i) {
+            words[i] = entry.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        consistent = entry.sequence.load(std::memory_order_relaxed) == before;
+    }
+    if (!consistent) {
+        return ReadStatus::BUSY;
+    }
+    
+    if (stored_index != index) {
+        return ReadStatus::OVERWRITTEN;
+    }
+    std::memcpy(&bar, words, sizeof(bar));
+    return ReadStatus::OK;
+}
+
+uint64_t SharedBarRing::read_recent(size_t count, BarSeries& series) const {
+    for (int attempt = 0; attempt < kMaxReadRestarts; ++attempt) {
+        const uint64_t end = write_count();
+        const uint64_t available = std::min<uint64_t>(end, header().capacity);
+        const uint64_t first = end - std::min<uint64_t>(count, available);
+        
+        series.clear();
+        series.reserve(static_cast<size_t>(end - first));
+        bool lapped = false;
+        OHLC bar;
+        for (uint64_t i = first; i < end; ++i) {
+            // A busy slot gets the same restart as a lap
+            if (read(i, bar) != ReadStatus::OK) {
+                lapped = true;
+                break;
+            }
+            series.append(bar);
+        }
+        if (!lapped) {
+            return first;
+        }
+    }
+    throw std::runtime_error("Bar ring reader was repeatedly overtaken or blocked by the producer");
+}
+
+} // namespace indicators
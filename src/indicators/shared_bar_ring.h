@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "indicators.h"
+
+namespace indicators {
+
+class BarSeries;
+
+// Single-producer, multi-consumer ring of one symbol's OHLC bars in a
+// memory-mapped file, so a feed process and indicator workers on the same
+// host share bars without model objects or serialization. Put the file on
+// a RAM-backed filesystem (/dev/shm on Linux).
+//
+// The producer never waits for consumers: once the ring is full each push
+// overwrites the oldest bar. Every slot carries its own sequence counter
+// (a seqlock), odd while the slot is being written, so readers detect torn
+// or overwritten bars and neither side takes a lock. The layout is host
+// native and meant for processes on one machine.
+class SharedBarRing {
+public:
+    enum class ReadStatus {
+        OK,
+        NOT_WRITTEN,  // index >= write_count()
+        OVERWRITTEN,  // the producer has lapped this index
+        BUSY          // the slot stayed mid-write, e.g. the producer died while writing it
+    };
+    
+    static constexpr uint32_t kLayoutVersion = 1;
+    static constexpr size_t kMaxSymbolLength = 31;
+    
+    // Create or truncate the ring file; the returned ring is the producer
+    static SharedBarRing create(const std::string& path, const std::string& symbol, size_t capacity);
+    // Map an existing ring read-only as a consumer
+    static SharedBarRing open(const std::string& path);
+    
+    SharedBarRing(SharedBarRing&& other) noexcept;
+    SharedBarRing& operator=(SharedBarRing&& other) noexcept;
+    SharedBarRing(const SharedBarRing&) = delete;
+    SharedBarRing& operator=(const SharedBarRing&) = delete;
+    ~SharedBarRing();
+    
+    // Producer side
+    void push(const OHLC& bar);
+    // Revise the most recent bar, e.g. while it is still forming
+    void update_last(const OHLC& bar);
+    
+    bool writable() const { return writable_; }
+    size_t capacity() const;
+    std::string symbol() const;
+    // Bars pushed so far; bar i is readable while i + capacity() > write_count()
+    uint64_t write_count() const;
+    
+    // Copy bar index. Never blocks: a slot still mid-write after a bounded
+    // number of yielding retries is reported as BUSY.
+    ReadStatus read(uint64_t index, OHLC& bar) const;
+    // Replace series with the most recent count bars (fewer if not yet
+    // written), oldest first. Restarts if the producer laps the copy or a
+    // slot is BUSY and throws std::runtime_error if that keeps happening.
+    // Returns the index of the first copied bar.
+    uint64_t read_recent(size_t count, BarSeries& series) const;
+    
+    // Mapped layout, defined in shared_bar_ring.cpp
+    struct Header;
+    struct Slot;
+
+private:
+    SharedBarRing(void* mapping, size_t size, bool writable);
+    
+    Header& header() const;
+    Slot& slot(uint64_t index) const;
+    void unmap();
+    
+    void* mapping_;
+    size_t size_;
+    bool writable_;
+};
+
+} // namespace indicators
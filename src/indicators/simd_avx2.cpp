@@ -0,0 +1,145 @@
+// AVX2 kernels. This file is built with AVX2 enabled and only called after
+// the runtime check in simd_kernels.cpp, so it must not include headers
+// with inline functions shared by other translation units: the linker could
+// keep the AVX2 copy and run it on CPUs without AVX2. simd_lanes.h is safe
+// because it is included inside this file's anonymous namespace.
+#include <immintrin.h>
+
+#include "simd_kernels.h"
+
+namespace indicators {
+namespace simd {
+namespace avx2 {
+
+namespace {
+
+inline double horizontal_sum(__m256d v) {
+    __m128d low = _mm256_castpd256_pd128(v);
+    __m128d high = _mm256_extractf128_pd(v, 1);
+    __m128d pair = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+inline __m256d abs_pd(__m256d v) {
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), v);
+}
+
+} // namespace
+
+double sum(const double* values, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd();
+    __m256d acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(values + i + 4));
+        acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(values + i + 8));
+        acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(values + i + 12));
+    }
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+    }
+    double total = horizontal_sum(_mm256_add_pd(_mm256_add_pd(acc0, acc1),
+                                                _mm256_add_pd(acc2, acc3)));
+    for (; i < n; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+double sum_squared_deviations(const double* values, size_t n, double mean) {
+    const __m256d m = _mm256_set1_pd(mean);
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(values + i), m);
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(values + i + 4), m);
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(d0, d0));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(d1, d1));
+    }
+    for (; i + 4 <= n; i += 4) {
+        __m256d d = _mm256_sub_pd(_mm256_loadu_pd(values + i), m);
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(d, d));
+    }
+    double total = horizontal_sum(_mm256_add_pd(acc0, acc1));
+    for (; i < n; ++i) {
+        double diff = values[i] - mean;
+        total += diff * diff;
+    }
+    return total;
+}
+
+double sum_true_range(const double* high, const double* low, const double* prev_close, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d h = _mm256_loadu_pd(high + i);
+        __m256d l = _mm256_loadu_pd(low + i);
+        __m256d c = _mm256_loadu_pd(prev_close + i);
+        __m256d tr = _mm256_max_pd(_mm256_sub_pd(h, l),
+                                   _mm256_max_pd(abs_pd(_mm256_sub_pd(h, c)),
+                                                 abs_pd(_mm256_sub_pd(l, c))));
+        acc = _mm256_add_pd(acc, tr);
+    }
+    double total = horizontal_sum(acc);
+    // Tail through the scalar kernel, which lives in a baseline TU
+    return total + scalar::sum_true_range(high + i, low + i, prev_close + i, n - i);
+}
+
+// Cross-sectional lane kernels for double and float lanes
+namespace {
+
+template <typename T>
+struct Lanes;
+
+template <>
+struct Lanes<double> {
+    using Vec = __m256d;
+    using Mask = __m256d;
+    static constexpr size_t kWidth = 4;
+    static Vec load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, Vec v) { _mm256_storeu_pd(p, v); }
+    static Vec set1(double x) { return _mm256_set1_pd(x); }
+    static Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+    static Vec div(Vec a, Vec b) { return _mm256_div_pd(a, b); }
+    static Vec abs(Vec a) { return abs_pd(a); }
+    static Mask greater(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static Mask less(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static Mask equal(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static Vec select(Mask m, Vec if_set, Vec if_clear) { return _mm256_blendv_pd(if_clear, if_set, m); }
+};
+
+template <>
+struct Lanes<float> {
+    using Vec = __m256;
+    using Mask = __m256;
+    static constexpr size_t kWidth = 8;
+    static Vec load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+    static Vec set1(float x) { return _mm256_set1_ps(x); }
+    static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+    static Vec div(Vec a, Vec b) { return _mm256_div_ps(a, b); }
+    static Vec abs(Vec a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static Mask greater(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask less(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask equal(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static Vec select(Mask m, Vec if_set, Vec if_clear) { return _mm256_blendv_ps(if_clear, if_set, m); }
+};
+
+#include "simd_lanes.h"
+
+} // namespace
+
+INDICATORS_SIMD_DEFINE_LANE_KERNELS(double)
+INDICATORS_SIMD_DEFINE_LANE_KERNELS(float)
+
+} // namespace avx2
+} // namespace simd
+} // namespace indicators
@@ -0,0 +1,130 @@
+// AVX-512F kernels. Built with AVX-512 enabled and only called after the
+// runtime check in simd_kernels.cpp; see simd_avx2.cpp for why no other
+// headers are included here, apart from simd_lanes.h.
+#include <immintrin.h>
+
+#include "simd_kernels.h"
+
+namespace indicators {
+namespace simd {
+namespace avx512 {
+
+namespace {
+
+inline __m512d abs_pd(__m512d v) {
+    return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(v),
+                                                _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL)));
+}
+
+} // namespace
+
+double sum(const double* values, size_t n) {
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(values + i));
+        acc1 = _mm512_add_pd(acc1, _mm512_loadu_pd(values + i + 8));
+    }
+    if (i < n) {
+        // Masked loads read zeros past the end, covering the tail in two steps
+        size_t left = n - i;
+        __mmask8 mask0 = static_cast<__mmask8>(left >= 8 ? 0xFF : (1u << left) - 1);
+        acc0 = _mm512_add_pd(acc0, _mm512_maskz_loadu_pd(mask0, values + i));
+        if (left > 8) {
+            __mmask8 mask1 = static_cast<__mmask8>((1u << (left - 8)) - 1);
+            acc1 = _mm512_add_pd(acc1, _mm512_maskz_loadu_pd(mask1, values + i + 8));
+        }
+    }
+    return _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+}
+
+double sum_squared_deviations(const double* values, size_t n, double mean) {
+    const __m512d m = _mm512_set1_pd(mean);
+    __m512d acc = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d d = _mm512_sub_pd(_mm512_loadu_pd(values + i), m);
+        acc = _mm512_add_pd(acc, _mm512_mul_pd(d, d));
+    }
+    if (i < n) {
+        __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512d d = _mm512_maskz_sub_pd(mask, _mm512_maskz_loadu_pd(mask, values + i), m);
+        acc = _mm512_add_pd(acc, _mm512_mul_pd(d, d));
+    }
+    return _mm512_reduce_add_pd(acc);
+}
+
+double sum_true_range(const double* high, const double* low, const double* prev_close, size_t n) {
+    __m512d acc = _mm512_setzero_pd();
+    for (size_t i = 0; i < n; i += 8) {
+        size_t left = n - i;
+        __mmask8 mask = static_cast<__mmask8>(left >= 8 ? 0xFF : (1u << left) - 1);
+        __m512d h = _mm512_maskz_loadu_pd(mask, high + i);
+        __m512d l = _mm512_maskz_loadu_pd(mask, low + i);
+        __m512d c = _mm512_maskz_loadu_pd(mask, prev_close + i);
+        __m512d tr = _mm512_max_pd(_mm512_sub_pd(h, l),
+                                   _mm512_max_pd(abs_pd(_mm512_sub_pd(h, c)),
+                                                 abs_pd(_mm512_sub_pd(l, c))));
+        acc = _mm512_add_pd(acc, tr);
+    }
+    return _mm512_reduce_add_pd(acc);
+}
+
+// Cross-sectional lane kernels for double and float lanes
+namespace {
+
+template <typename T>
+struct Lanes;
+
+template <>
+struct Lanes<double> {
+    using Vec = __m512d;
+    using Mask = __mmask8;
+    static constexpr size_t kWidth = 8;
+    static Vec load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, Vec v) { _mm512_storeu_pd(p, v); }
+    static Vec set1(double x) { return _mm512_set1_pd(x); }
+    static Vec add(Vec a, Vec b) { return _mm512_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm512_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm512_mul_pd(a, b); }
+    static Vec div(Vec a, Vec b) { return _mm512_div_pd(a, b); }
+    static Vec abs(Vec a) { return abs_pd(a); }
+    static Mask greater(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static Mask less(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static Mask equal(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static Vec select(Mask m, Vec if_set, Vec if_clear) { return _mm512_mask_blend_pd(m, if_clear, if_set); }
+};
+
+template <>
+struct Lanes<float> {
+    using Vec = __m512;
+    using Mask = __mmask16;
+    static constexpr size_t kWidth = 16;
+    static Vec load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, Vec v) { _mm512_storeu_ps(p, v); }
+    static Vec set1(float x) { return _mm512_set1_ps(x); }
+    static Vec add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm512_sub_ps(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm512_mul_ps(a, b); }
+    static Vec div(Vec a, Vec b) { return _mm512_div_ps(a, b); }
+    static Vec abs(Vec a) {
+        return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a),
+                                                    _mm512_set1_epi32(0x7FFFFFFF)));
+    }
+    static Mask greater(Vec a, Vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static Mask less(Vec a, Vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static Mask equal(Vec a, Vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static Vec select(Mask m, Vec if_set, Vec if_clear) { return _mm512_mask_blend_ps(m, if_clear, if_set); }
+};
+
+#include "simd_lanes.h"
+
+} // namespace
+
+INDICATORS_SIMD_DEFINE_LANE_KERNELS(double)
+INDICATORS_SIMD_DEFINE_LANE_KERNELS(float)
+
+} // namespace avx512
+} // namespace simd
+} // namespace indicators
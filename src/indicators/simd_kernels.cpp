@@ -0,0 +1,433 @@
+#include "simd_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define INDICATORS_HAVE_NEON 1
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace indicators {
+namespace simd {
+
+// Scalar reference kernels, summing in index order like the original loops
+namespace scalar {
+
+double sum(const double* values, size_t n) {
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+double sum_squared_deviations(const double* values, size_t n, double mean) {
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double diff = values[i] - mean;
+        total += diff * diff;
+    }
+    return total;
+}
+
+double sum_true_range(const double* high, const double* low, const double* prev_close, size_t n) {
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double high_low = high[i] - low[i];
+        double high_close = std::abs(high[i] - prev_close[i]);
+        double low_close = std::abs(low[i] - prev_close[i]);
+        total += std::max({high_low, high_close, low_close});
+    }
+    return total;
+}
+
+// Cross-sectional steps, written exactly like the EmaState and RsiState
+// updates in indicators.cpp but in the lane type T
+namespace {
+
+template <typename T>
+void accumulate_lanes(T* acc, const T* values, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        acc[i] += values[i];
+    }
+}
+
+template <typename T>
+void ema_update_lanes(T* ema, const T* values, size_t n, T multiplier) {
+    for (size_t i = 0; i < n; ++i) {
+        ema[i] = (values[i] - ema[i]) * multiplier + ema[i];
+    }
+}
+
+template <typename T>
+void rsi_accumulate_lanes(T* gain, T* loss, const T* prev, const T* cur, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        T change = cur[i] - prev[i];
+        if (change > 0) {
+            gain[i] += change;
+        } else {
+            loss[i] += std::abs(change);
+        }
+    }
+}
+
+template <typename T>
+void rsi_smooth_lanes(T* avg_gain, T* avg_loss, const T* prev, const T* cur, size_t n, T period) {
+    for (size_t i = 0; i < n; ++i) {
+        T change = cur[i] - prev[i];
+        T gain = (change > 0) ? change : T(0);
+        T loss = (change < 0) ? std::abs(change) : T(0);
+        avg_gain[i] = (avg_gain[i] * (period - 1) + gain) / period;
+        avg_loss[i] = (avg_loss[i] * (period - 1) + loss) / period;
+    }
+}
+
+template <typename T>
+void rsi_value_lanes(T* out, const T* avg_gain, const T* avg_loss, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (avg_loss[i] == T(0)) {
+            out[i] = T(100);
+        } else {
+            T rs = avg_gain[i] / avg_loss[i];
+            out[i] = T(100) - (T(100) / (T(1) + rs));
+        }
+    }
+}
+
+} // namespace
+
+INDICATORS_SIMD_DEFINE_LANE_KERNELS(double)
+INDICATORS_SIMD_DEFINE_LANE_KERNELS(float)
+
+} // namespace scalar
+
+#ifdef INDICATORS_HAVE_NEON
+namespace neon {
+
+double sum(const double* values, size_t n) {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc0 = vaddq_f64(acc0, vld1q_f64(values + i));
+        acc1 = vaddq_f64(acc1, vld1q_f64(values + i + 2));
+    }
+    double total = vaddvq_f64(vaddq_f64(acc0, acc1));
+    for (; i < n; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+double sum_squared_deviations(const double* values, size_t n, double mean) {
+    const float64x2_t m = vdupq_n_f64(mean);
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float64x2_t d0 = vsubq_f64(vld1q_f64(values + i), m);
+        float64x2_t d1 = vsubq_f64(vld1q_f64(values + i + 2), m);
+        acc0 = vaddq_f64(acc0, vmulq_f64(d0, d0));
+        acc1 = vaddq_f64(acc1, vmulq_f64(d1, d1));
+    }
+    double total = vaddvq_f64(vaddq_f64(acc0, acc1));
+    for (; i < n; ++i) {
+        double diff = values[i] - mean;
+        total += diff * diff;
+    }
+    return total;
+}
+
+double sum_true_range(const double* high, const double* low, const double* prev_close, size_t n) {
+    float64x2_t acc = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t h = vld1q_f64(high + i);
+        float64x2_t l = vld1q_f64(low + i);
+        float64x2_t c = vld1q_f64(prev_close + i);
+        float64x2_t tr = vmaxq_f64(vsubq_f64(h, l),
+                                   vmaxq_f64(vabsq_f64(vsubq_f64(h, c)),
+                                             vabsq_f64(vsubq_f64(l, c))));
+        acc = vaddq_f64(acc, tr);
+    }
+    double total = vaddvq_f64(acc);
+    return total + scalar::sum_true_range(high + i, low + i, prev_close + i, n - i);
+}
+
+namespace {
+
+// Lane operations for the cross-sectional kernels, one traits struct per
+// lane type so the kernels below are written once
+template <typename T>
+struct Lanes;
+
+template <>
+struct Lanes<double> {
+    using Vec = float64x2_t;
+    using Mask = uint64x2_t;
+    static constexpr size_t kWidth = 2;
+    static Vec load(const double* p) { return vld1q_f64(p); }
+    static void store(double* p, Vec v) { vst1q_f64(p, v); }
+    static Vec set1(double x) { return vdupq_n_f64(x); }
+    static Vec add(Vec a, Vec b) { return vaddq_f64(a, b); }
+    static Vec sub(Vec a, Vec b) { return vsubq_f64(a, b); }
+    static Vec mul(Vec a, Vec b) { return vmulq_f64(a, b); }
+    static Vec div(Vec a, Vec b) { return vdivq_f64(a, b); }
+    static Vec abs(Vec a) { return vabsq_f64(a); }
+    static Mask greater(Vec a, Vec b) { return vcgtq_f64(a, b); }
+    static Mask less(Vec a, Vec b) { return vcltq_f64(a, b); }
+    static Mask equal(Vec a, Vec b) { return vceqq_f64(a, b); }
+    static Vec select(Mask m, Vec if_set, Vec if_clear) { return vbslq_f64(m, if_set, if_clear); }
+};
+
+template <>
+struct Lanes<float> {
+    using Vec = float32x4_t;
+    using Mask = uint32x4_t;
+    static constexpr size_t kWidth = 4;
+    static Vec load(const float* p) { return vld1q_f32(p); }
+    static void store(float* p, Vec v) { vst1q_f32(p, v); }
+    static Vec set1(float x) { return vdupq_n_f32(x); }
+    static Vec add(Vec a, Vec b) { return vaddq_f32(a, b); }
+    static Vec sub(Vec a, Vec b) { return vsubq_f32(a, b); }
+    static Vec mul(Vec a, Vec b) { return vmulq_f32(a, b); }
+    static Vec div(Vec a, Vec b) { return vdivq_f32(a, b); }
+    static Vec abs(Vec a) { return vabsq_f32(a); }
+    static Mask greater(Vec a, Vec b) { return vcgtq_f32(a, b); }
+    static Mask less(Vec a, Vec b) { return vcltq_f32(a, b); }
+    static Mask equal(Vec a, Vec b) { return vceqq_f32(a, b); }
+    static Vec select(Mask m, Vec if_set, Vec if_clear) { return vbslq_f32(m, if_set, if_clear); }
+};
+
+#include "simd_lanes.h"
+
+} // namespace
+
+INDICATORS_SIMD_DEFINE_LANE_KERNELS(double)
+INDICATORS_SIMD_DEFINE_LANE_KERNELS(float)
+
+} // namespace neon
+#endif
+
+namespace {
+
+template <typename T>
+struct LaneKernels {
+    void (*accumulate)(T*, const T*, size_t);
+    void (*ema_update)(T*, const T*, size_t, T);
+    void (*rsi_accumulate)(T*, T*, const T*, const T*, size_t);
+    void (*rsi_smooth)(T*, T*, const T*, const T*, size_t, T);
+    void (*rsi_value)(T*, const T*, const T*, size_t);
+};
+
+struct KernelTable {
+    InstructionSet isa;
+    double (*sum)(const double*, size_t);
+    double (*sum_squared_deviations)(const double*, size_t, double);
+    double (*sum_true_range)(const double*, const double*, const double*, size_t);
+    LaneKernels<double> f64;
+    LaneKernels<float> f32;
+};
+
+#define INDICATORS_SIMD_LANE_TABLE(ns)                                                 \
+    {ns::accumulate, ns::ema_update, ns::rsi_accumulate, ns::rsi_smooth, ns::rsi_value}
+
+#define INDICATORS_SIMD_KERNEL_TABLE(isa, ns)                                          \
+    {isa, ns::sum, ns::sum_squared_deviations, ns::sum_true_range,                     \
+     INDICATORS_SIMD_LANE_TABLE(ns), INDICATORS_SIMD_LANE_TABLE(ns)}
+
+const KernelTable kScalarKernels = INDICATORS_SIMD_KERNEL_TABLE(InstructionSet::SCALAR, scalar);
+#ifdef INDICATORS_HAVE_AVX2
+const KernelTable kAvx2Kernels = INDICATORS_SIMD_KERNEL_TABLE(InstructionSet::AVX2, avx2);
+#endif
+#ifdef INDICATORS_HAVE_AVX512
+const KernelTable kAvx512Kernels = INDICATORS_SIMD_KERNEL_TABLE(InstructionSet::AVX512, avx512);
+#endif
+#ifdef INDICATORS_HAVE_NEON
+const KernelTable kNeonKernels = INDICATORS_SIMD_KERNEL_TABLE(InstructionSet::NEON, neon);
+#endif
+
+#undef INDICATORS_SIMD_KERNEL_TABLE
+#undef INDICATORS_SIMD_LANE_TABLE
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+// CPUID leaf 7 feature bit, plus the OS having enabled the matching
+// register state in XCR0
+bool msvc_cpu_supports(int ebx_bit, unsigned long long xcr0_mask) {
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & xcr0_mask) != xcr0_mask) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << ebx_bit)) != 0;
+}
+#endif
+
+bool cpu_supports(InstructionSet isa) {
+    switch (isa) {
+        case InstructionSet::SCALAR:
+            return true;
+        case InstructionSet::AVX2:
+#if defined(INDICATORS_HAVE_AVX2) && defined(_MSC_VER)
+            return msvc_cpu_supports(5, 0x6);
+#elif defined(INDICATORS_HAVE_AVX2)
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+        case InstructionSet::AVX512:
+#if defined(INDICATORS_HAVE_AVX512) && defined(_MSC_VER)
+            return msvc_cpu_supports(16, 0xE6);
+#elif defined(INDICATORS_HAVE_AVX512)
+            return __builtin_cpu_supports("avx512f");
+#else
+            return false;
+#endif
+        case InstructionSet::NEON:
+#ifdef INDICATORS_HAVE_NEON
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const KernelTable& kernels_for(InstructionSet isa) {
+    switch (isa) {
+#ifdef INDICATORS_HAVE_AVX2
+        case InstructionSet::AVX2:
+            return kAvx2Kernels;
+#endif
+#ifdef INDICATORS_HAVE_AVX512
+        case InstructionSet::AVX512:
+            return kAvx512Kernels;
+#endif
+#ifdef INDICATORS_HAVE_NEON
+        case InstructionSet::NEON:
+            return kNeonKernels;
+#endif
+        default:
+            return kScalarKernels;
+    }
+}
+
+InstructionSet best_instruction_set() {
+    const InstructionSet preference[] = {
+        InstructionSet::AVX512, InstructionSet::AVX2, InstructionSet::NEON};
+    for (InstructionSet isa : preference) {
+        if (cpu_supports(isa)) {
+            return isa;
+        }
+    }
+    return InstructionSet::SCALAR;
+}
+
+// Best supported set, lowered by INDICATORS_SIMD if it names a supported one
+InstructionSet default_instruction_set() {
+    InstructionSet isa = best_instruction_set();
+    const char* requested = std::getenv("INDICATORS_SIMD");
+    if (requested == nullptr) {
+        return isa;
+    }
+    const InstructionSet all[] = {
+        InstructionSet::SCALAR, InstructionSet::AVX2, InstructionSet::AVX512, InstructionSet::NEON};
+    for (InstructionSet candidate : all) {
+        if (std::strcmp(requested, instruction_set_name(candidate)) == 0 && cpu_supports(candidate)) {
+            return candidate;
+        }
+    }
+    return isa;
+}
+
+std::atomic<const KernelTable*>& active_kernels() {
+    static std::atomic<const KernelTable*> active(&kernels_for(default_instruction_set()));
+    return active;
+}
+
+const KernelTable& kernels() {
+    return *active_kernels().load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+const char* instruction_set_name(InstructionSet isa) {
+    switch (isa) {
+        case InstructionSet::SCALAR:
+            return "scalar";
+        case InstructionSet::AVX2:
+            return "avx2";
+        case InstructionSet::AVX512:
+            return "avx512";
+        case InstructionSet::NEON:
+            return "neon";
+    }
+    return "unknown";
+}
+
+bool is_supported(InstructionSet isa) {
+    return cpu_supports(isa);
+}
+
+InstructionSet active_instruction_set() {
+    return kernels().isa;
+}
+
+void set_instruction_set(InstructionSet isa) {
+    if (!cpu_supports(isa)) {
+        throw std::invalid_argument(std::string("Instruction set not supported: ") +
+                                    instruction_set_name(isa));
+    }
+    active_kernels().store(&kernels_for(isa), std::memory_order_relaxed);
+}
+
+double sum(const double* values, size_t n) {
+    return kernels().sum(values, n);
+}
+
+double sum_squared_deviations(const double* values, size_t n, double mean) {
+    return kernels().sum_squared_deviations(values, n, mean);
+}
+
+double sum_true_range(const double* high, const double* low, const double* prev_close, size_t n) {
+    return kernels().sum_true_range(high, low, prev_close, n);
+}
+
+#define INDICATORS_SIMD_DISPATCH_LANE_KERNELS(T, table)                                \
+    void accumulate(T* acc, const T* values, size_t n) {                              \
+        kernels().table.accumulate(acc, values, n);                                   \
+    }                                                                                 \
+    void ema_update(T* ema, const T* values, size_t n, T multiplier) {                \
+        kernels().table.ema_update(ema, values, n, multiplier);                       \
+    }                                                                                 \
+    void rsi_accumulate(T* gain, T* loss, const T* prev, const T* cur, size_t n) {    \
+        kernels().table.rsi_accumulate(gain, loss, prev, cur, n);                     \
+    }                                                                                 \
+    void rsi_smooth(T* avg_gain, T* avg_loss, const T* prev, const T* cur,            \
+                    size_t n, T period) {                                             \
+        kernels().table.rsi_smooth(avg_gain, avg_loss, prev, cur, n, period);         \
+    }                                                                                 \
+    void rsi_value(T* out, const T* avg_gain, const T* avg_loss, size_t n) {          \
+        kernels().table.rsi_value(out, avg_gain, avg_loss, n);                        \
+}
+
+INDICATORS_SIMD_DISPATCH_LANE_KERNELS(double, f64)
+INDICATORS_SIMD_DISPATCH_LANE_KERNELS(float, f32)
+
+#undef INDICATORS_SIMD_DISPATCH_LANE_KERNELS
+
+} // namespace simd
+} // namespace indicators
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+
+namespace indicators {
+namespace simd {
+
+// Vectorized reductions used by the SMA, standard deviation and ATR
+// kernels. The implementation is picked once at runtime from the best
+// instruction set the CPU supports; the INDICATORS_SIMD environment
+// variable (scalar, avx2, avx512, neon) can force a lower one.
+//
+// Vector variants add in a different order than the scalar loop, so sums
+// can differ from it in the last bits (relative error ~1e-15).
+enum class InstructionSet {
+    SCALAR,
+    AVX2,
+    AVX512,
+    NEON
+};
+
+const char* instruction_set_name(InstructionSet isa);
+bool is_supported(InstructionSet isa);
+InstructionSet active_instruction_set();
+// Throws std::invalid_argument if the CPU does not support isa
+void set_instruction_set(InstructionSet isa);
+
+// Sum of values[0, n)
+double sum(const double* values, size_t n);
+// Sum of (values[i] - mean)^2 over [0, n)
+double sum_squared_deviations(const double* values, size_t n, double mean);
+// Sum over [0, n) of max(high - low, |high - prev_close|, |low - prev_close|),
+// where prev_close[i] is the close of the bar before high[i]/low[i]
+double sum_true_range(const double* high, const double* low, const double* prev_close, size_t n);
+
+// Lane-wise steps of the cross-sectional EMA and RSI kernels, where index i
+// is a symbol rather than a bar, for double and float lanes. They only use
+// elementwise IEEE operations in the lane type, so unlike the reductions
+// above every instruction set matches the scalar recurrences bit for bit.
+//
+// accumulate: acc[i] += values[i]
+// ema_update: ema[i] = (values[i] - ema[i]) * multiplier + ema[i]
+// rsi_accumulate: add the change prev[i] -> cur[i] to the RSI seed sums; a
+//     change that is not positive counts as a loss
+// rsi_smooth: Wilder-smooth the average gain and loss with the change
+//     prev[i] -> cur[i]
+// rsi_value: RSI from the averages, 100 where avg_loss[i] is zero
+#define INDICATORS_SIMD_DECLARE_LANE_KERNELS(T)                                       \
+    void accumulate(T* acc, const T* values, size_t n);                               \
+    void ema_update(T* ema, const T* values, size_t n, T multiplier);                 \
+    void rsi_accumulate(T* gain, T* loss, const T* prev, const T* cur, size_t n);     \
+    void rsi_smooth(T* avg_gain, T* avg_loss, const T* prev, const T* cur,            \
+                    size_t n, T period);                                              \
+    void rsi_value(T* out, const T* avg_gain, const T* avg_loss, size_t n);
+
+INDICATORS_SIMD_DECLARE_LANE_KERNELS(double)
+INDICATORS_SIMD_DECLARE_LANE_KERNELS(float)
+
+// Per-instruction-set implementations
+#define INDICATORS_SIMD_DECLARE_KERNELS(ns)                                           \
+    namespace ns {                                                                    \
+    double sum(const double* values, size_t n);                                       \
+    double sum_squared_deviations(const double* values, size_t n, double mean);       \
+    double sum_true_range(const double* high, const double* low,                      \
+                          const double* prev_close, size_t n);                        \
+    INDICATORS_SIMD_DECLARE_LANE_KERNELS(double)                                      \
+    INDICATORS_SIMD_DECLARE_LANE_KERNELS(float)                                       \
+    }
+
+// Defines the lane kernels for lane type T in the enclosing namespace by
+// forwarding to templates accumulate_lanes, ema_update_lanes,
+// rsi_accumulate_lanes, rsi_smooth_lanes and rsi_value_lanes
+#define INDICATORS_SIMD_DEFINE_LANE_KERNELS(T)                                        \
+    void accumulate(T* acc, const T* values, size_t n) {                              \
+        accumulate_lanes(acc, values, n);                                             \
+    }                                                                                 \
+    void ema_update(T* ema, const T* values, size_t n, T multiplier) {                \
+        ema_update_lanes(ema, values, n, multiplier);                                 \
+    }                                                                                 \
+    void rsi_accumulate(T* gain, T* loss, const T* prev, const T* cur, size_t n) {    \
+        rsi_accumulate_lanes(gain, loss, prev, cur, n);                               \
+    }                                                                                 \
+    void rsi_smooth(T* avg_gain, T* avg_loss, const T* prev, const T* cur,            \
+                    size_t n, T period) {                                             \
+        rsi_smooth_lanes(avg_gain, avg_loss, prev, cur, n, period);                   \
+    }                                                                                 \
+    void rsi_value(T* out, const T* avg_gain, const T* avg_loss, size_t n) {          \
+        rsi_value_lanes(out, avg_gain, avg_loss, n);                                  \
+    }
+
+INDICATORS_SIMD_DECLARE_KERNELS(scalar)
+INDICATORS_SIMD_DECLARE_KERNELS(avx2)
+INDICATORS_SIMD_DECLARE_KERNELS(avx512)
+INDICATORS_SIMD_DECLARE_KERNELS(neon)
+
+#undef INDICATORS_SIMD_DECLARE_KERNELS
+#undef INDICATORS_SIMD_DECLARE_LANE_KERNELS
+
+} // namespace simd
+} // namespace indicators
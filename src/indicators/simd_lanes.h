@@ -0,0 +1,81 @@
+#pragma once
+
+// Cross-sectional lane kernels, written once over a Lanes<T> traits struct.
+// Each per-ISA translation unit includes this inside its anonymous
+// namespace, after its Lanes<double> and Lanes<float> specializations, so
+// every copy is compiled for that file's instruction set and keeps internal
+// linkage.
+
+template <typename T>
+void accumulate_lanes(T* acc, const T* values, size_t n) {
+    using L = Lanes<T>;
+    size_t i = 0;
+    for (; i + L::kWidth <= n; i += L::kWidth) {
+        L::store(acc + i, L::add(L::load(acc + i), L::load(values + i)));
+    }
+    scalar::accumulate(acc + i, values + i, n - i);
+}
+
+// Separate multiply and add rather than a fused multiply-add, to round like
+// the scalar step
+template <typename T>
+void ema_update_lanes(T* ema, const T* values, size_t n, T multiplier) {
+    using L = Lanes<T>;
+    const typename L::Vec m = L::set1(multiplier);
+    size_t i = 0;
+    for (; i + L::kWidth <= n; i += L::kWidth) {
+        typename L::Vec e = L::load(ema + i);
+        typename L::Vec d = L::sub(L::load(values + i), e);
+        L::store(ema + i, L::add(L::mul(d, m), e));
+    }
+    scalar::ema_update(ema + i, values + i, n - i, multiplier);
+}
+
+template <typename T>
+void rsi_accumulate_lanes(T* gain, T* loss, const T* prev, const T* cur, size_t n) {
+    using L = Lanes<T>;
+    const typename L::Vec zero = L::set1(T(0));
+    size_t i = 0;
+    for (; i + L::kWidth <= n; i += L::kWidth) {
+        typename L::Vec change = L::sub(L::load(cur + i), L::load(prev + i));
+        typename L::Mask up = L::greater(change, zero);
+        L::store(gain + i, L::add(L::load(gain + i), L::select(up, change, zero)));
+        L::store(loss + i, L::add(L::load(loss + i), L::select(up, zero, L::abs(change))));
+    }
+    scalar::rsi_accumulate(gain + i, loss + i, prev + i, cur + i, n - i);
+}
+
+template <typename T>
+void rsi_smooth_lanes(T* avg_gain, T* avg_loss, const T* prev, const T* cur, size_t n, T period) {
+    using L = Lanes<T>;
+    const typename L::Vec zero = L::set1(T(0));
+    const typename L::Vec p = L::set1(period);
+    const typename L::Vec keep = L::set1(period - 1);
+    size_t i = 0;
+    for (; i + L::kWidth <= n; i += L::kWidth) {
+        typename L::Vec change = L::sub(L::load(cur + i), L::load(prev + i));
+        typename L::Vec gain = L::select(L::greater(change, zero), change, zero);
+        typename L::Vec loss = L::select(L::less(change, zero), L::abs(change), zero);
+        typename L::Vec g = L::mul(L::load(avg_gain + i), keep);
+        typename L::Vec l = L::mul(L::load(avg_loss + i), keep);
+        L::store(avg_gain + i, L::div(L::add(g, gain), p));
+        L::store(avg_loss + i, L::div(L::add(l, loss), p));
+    }
+    scalar::rsi_smooth(avg_gain + i, avg_loss + i, prev + i, cur + i, n - i, period);
+}
+
+template <typename T>
+void rsi_value_lanes(T* out, const T* avg_gain, const T* avg_loss, size_t n) {
+    using L = Lanes<T>;
+    const typename L::Vec zero = L::set1(T(0));
+    const typename L::Vec one = L::set1(T(1));
+    const typename L::Vec hundred = L::set1(T(100));
+    size_t i = 0;
+    for (; i + L::kWidth <= n; i += L::kWidth) {
+        typename L::Vec l = L::load(avg_loss + i);
+        typename L::Vec rs = L::div(L::load(avg_gain + i), l);
+        typename L::Vec rsi = L::sub(hundred, L::div(hundred, L::add(one, rs)));
+        L::store(out + i, L::select(L::equal(l, zero), hundred, rsi));
+    }
+    scalar::rsi_value(out + i, avg_gain + i, avg_loss + i, n - i);
+}
@@ -0,0 +1,290 @@
+#include "state_codec.h"
+#include "byte_order.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace indicators {
+
+namespace {
+
+const unsigned char kMagic[4] = {'E', 'D', 'I', 'S'};
+
+uint32_t fnv1a(const unsigned char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+[[noreturn]] void reject(const std::string& reason) {
+    throw std::invalid_argument("State snapshot: " + reason);
+}
+
+// Appends little-endian fields to a byte buffer
+class Writer {
+public:
+    explicit Writer(std::vector<unsigned char>& out) : out_(out) {}
+    
+    void u32(uint32_t value) { store_u32(grow(4), value); }
+    void u64(uint64_t value) { store_u64(grow(8), value); }
+    void i64(int64_t value) { u64(static_cast<uint64_t>(value)); }
+    void f64(double value) { store_f64(grow(8), value); }
+    void size(size_t value) { u64(static_cast<uint64_t>(value)); }
+    
+private:
+    unsigned char* grow(size_t bytes) {
+        out_.resize(out_.size() + bytes);
+        return out_.data() + out_.size() - bytes;
+    }
+    
+    std::vector<unsigned char>& out_;
+};
+
+// Reads little-endian fields, rejecting reads past the payload
+class Reader {
+public:
+    Reader(const unsigned char* data, size_t size) : data_(data), remaining_(size) {}
+    
+    uint32_t u32() { return load_u32(take(4)); }
+    uint64_t u64() { return load_u64(take(8)); }
+    int64_t i64() { return static_cast<int64_t>(u64()); }
+    double f64() { return load_f64(take(8)); }
+    size_t size() {
+        uint64_t value = u64();
+        if (value > SIZE_MAX) {
+            reject("count out of range");
+        }
+        return static_cast<size_t>(value);
+    }
+    size_t remaining() const { return remaining_; }
+    
+private:
+    const unsigned char* take(size_t bytes) {
+        if (remaining_ < bytes) {
+            reject("payload is truncated");
+        }
+        const unsigned char* at = data_;
+        data_ += bytes;
+        remaining_ -= bytes;
+        return at;
+    }
+    
+    const unsigned char* data_;
+    size_t remaining_;
+};
+
+// Fields of a restored state are checked against the freshly constructed
+// state they overwrite, which fixes every period and window length
+void expect(bool condition, const char* reason) {
+    if (!condition) {
+        reject(reason);
+    }
+}
+
+} // namespace
+
+struct StateCodec {
+    using RecursiveState = IncrementalIndicatorState::RecursiveState;
+    
+    static void write(Writer& out, const EmaAccumulator& ema) {
+        out.u32(static_cast<uint32_t>(ema.period));
+        out.f64(ema.value);
+        out.size(ema.count);
+    }
+    
+    static void read(Reader& in, EmaAccumulator& ema) {
+        expect(in.u32() == static_cast<uint32_t>(ema.period), "EMA period does not match");
+        ema.value = in.f64();
+        ema.count = in.size();
+    }
+    
+    static void write(Writer& out, const RsiAccumulator& rsi) {
+        out.u32(static_cast<uint32_t>(rsi.period));
+        out.f64(rsi.avg_gain);
+        out.f64(rsi.avg_loss);
+        out.size(rsi.count);
+    }
+    
+    static void read(Reader& in, RsiAccumulator& rsi) {
+        expect(in.u32() == static_cast<uint32_t>(rsi.period), "RSI period does not match");
+        rsi.avg_gain = in.f64();
+        rsi.avg_loss = in.f64();
+        rsi.count = in.size();
+    }
+    
+    static void write(Writer& out, const RecursiveState& state) {
+        write(out, state.ema_fast);
+        write(out, state.ema_slow);
+        write(out, state.macd_signal);
+        write(out, state.rsi);
+        out.f64(state.macd_line);
+        out.f64(state.last_close);
+        out.i64(state.obv);
+        out.i64(state.session);
+        out.f64(state.session_price_volume);
+        out.f64(state.session_volume);
+        out.f64(state.last_typical);
+        out.size(state.bar_count);
+    }
+    
+    static void read(Reader& in, RecursiveState& state) {
+        read(in, state.ema_fast);
+        read(in, state.ema_slow);
+        read(in, state.macd_signal);
+        read(in, state.rsi);
+        state.macd_line = in.f64();
+        state.last_close = in.f64();
+        state.obv = in.i64();
+        state.session = in.i64();
+        state.session_price_volume = in.f64();
+        state.session_volume = in.f64();
+        state.last_typical = in.f64();
+        state.bar_count = in.size();
+    }
+    
+    static void write(Writer& out, const RollingWindow& window) {
+        out.u32(static_cast<uint32_t>(window.values_.size()));
+        for (double value : window.values_) {
+            out.f64(value);
+        }
+        out.size(window.head_);
+        out.size(window.count_);
+        out.size(window.updates_since_reset_);
+        out.size(window.moments_.count_);
+        out.f64(window.moments_.mean_);
+        out.f64(window.moments_.m2_);
+    }
+    
+    static void read(Reader& in, RollingWindow& window) {
+        const size_t length = window.values_.size();
+        expect(in.u32() == length, "window length does not match");
+        for (double& value : window.values_) {
+            value = in.f64();
+        }
+        window.head_ = in.size();
+        window.count_ = in.size();
+        window.updates_since_reset_ = in.size();
+        window.moments_.count_ = in.size();
+        window.moments_.mean_ = in.f64();
+        window.moments_.m2_ = in.f64();
+        expect(window.head_ < length && window.count_ <= length &&
+               window.updates_since_reset_ < length && window.moments_.count_ == window.count_,
+               "window position out of range");
+    }
+    
+    static void write(Writer& out, const IncrementalIndicatorState& state) {
+        out.i64(state.session_seconds_);
+        out.i64(state.session_offset_);
+        write(out, state.committed_);
+        write(out, state.current_);
+        write(out, state.closes_20_);
+        write(out, state.closes_50_);
+        write(out, state.true_ranges_);
+        
+        out.u32(static_cast<uint32_t>(state.money_flows_.size()));
+        for (double flow : state.money_flows_) {
+            out.f64(flow);
+        }
+        out.size(state.flows_pushed_);
+        out.u32(static_cast<uint32_t>(state.volumes_.size()));
+        for (int64_t volume : state.volumes_) {
+            out.i64(volume);
+        }
+        out.size(state.volumes_pushed_);
+        out.i64(state.volume_sum_);
+        
+        const OHLC& bar = state.last_bar_;
+        out.f64(bar.open);
+        out.f64(bar.high);
+        out.f64(bar.low);
+        out.f64(bar.close);
+        out.i64(bar.volume);
+        out.i64(bar.timestamp);
+    }
+    
+    static IncrementalIndicatorState read(Reader& in) {
+        const int64_t session_seconds = in.i64();
+        const int64_t session_offset = in.i64();
+        expect(session_seconds > 0, "VWAP session length must be positive");
+        IncrementalIndicatorState state(session_seconds, session_offset);
+        read(in, state.committed_);
+        read(in, state.current_);
+        read(in, state.closes_20_);
+        read(in, state.closes_50_);
+        read(in, state.true_ranges_);
+        
+        expect(in.u32() == state.money_flows_.size(), "money flow window length does not match");
+        for (double& flow : state.money_flows_) {
+            flow = in.f64();
+        }
+        state.flows_pushed_ = in.size();
+        expect(in.u32() == state.volumes_.size(), "volume window length does not match");
+        for (int64_t& volume : state.volumes_) {
+            volume = in.i64();
+        }
+        state.volumes_pushed_ = in.size();
+        state.volume_sum_ = in.i64();
+        
+        OHLC& bar = state.last_bar_;
+        bar.open = in.f64();
+        bar.high = in.f64();
+        bar.low = in.f64();
+        bar.close = in.f64();
+        bar.volume = in.i64();
+        bar.timestamp = in.i64();
+        
+        // The forming bar is the one bar between the two recursive states,
+        // and every bar pushed a volume and all but the first a money flow
+        const size_t bars = state.current_.bar_count;
+        expect(bars == 0 ? state.committed_.bar_count == 0 : state.committed_.bar_count == bars - 1,
+               "bar counts are inconsistent");
+        expect(state.volumes_pushed_ == bars && state.flows_pushed_ == (bars > 0 ? bars - 1 : 0),
+               "window counts are inconsistent");
+        return state;
+    }
+};
+
+std::vector<unsigned char> encode_state(const IncrementalIndicatorState& state) {
+    using namespace state_codec;
+    std::vector<unsigned char> out(kHeaderSize);
+    Writer writer(out);
+    StateCodec::write(writer, state);
+    
+    const size_t payload = out.size() - kHeaderSize;
+    std::memcpy(out.data(), kMagic, sizeof(kMagic));
+    store_u16(out.data() + 4, kVersion);
+    store_u16(out.data() + 6, 0);
+    store_u32(out.data() + 8, static_cast<uint32_t>(payload));
+    store_u32(out.data() + 12, fnv1a(out.data() + kHeaderSize, payload));
+    return out;
+}
+
+IncrementalIndicatorState decode_state(const void* data, size_t size) {
+    using namespace state_codec;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    if (size < kHeaderSize || std::memcmp(bytes, kMagic, sizeof(kMagic)) != 0) {
+        reject("missing header");
+    }
+    uint16_t version = load_u16(bytes + 4);
+    if (version != kVersion) {
+        reject("unsupported version " + std::to_string(version));
+    }
+    const size_t payload = load_u32(bytes + 8);
+    if (size - kHeaderSize != payload) {
+        reject("buffer size does not match the payload size");
+    }
+    if (fnv1a(bytes + kHeaderSize, payload) != load_u32(bytes + 12)) {
+        reject("payload hash does not match");
+    }
+    
+    Reader reader(bytes + kHeaderSize, payload);
+    IncrementalIndicatorState state = StateCodec::read(reader);
+    if (reader.remaining() != 0) {
+        reject("unexpected bytes after the payload");
+    }
+    return state;
+}
+
+} // namespace indicators
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "indicators.h"
+
+namespace indicators {
+
+// Binary snapshot of an IncrementalIndicatorState for warm restarts: a
+// worker restores its last snapshot and replays only the bars since,
+// instead of the full history. Restoring reproduces the state exactly, so
+// the indicators continue bit for bit as if the worker had never stopped.
+// Every integer and double is little-endian regardless of the host.
+//
+//   header (kHeaderSize bytes)
+//     0   char[4]     magic "EDIS"
+//     4   uint16      version
+//     6   uint16      reserved, 0
+//     8   uint32      payload size in bytes
+//     12  uint32      FNV-1a hash of the payload
+//   payload (version 1)
+//     int64[2]        VWAP session seconds and offset
+//     recursive       state as of the last closed bar, then as of the
+//                     forming bar: EMA 12, 26 and signal 9 as (uint32
+//                     period, double value, uint64 count), RSI 14 as
+//                     (uint32 period, double avg_gain, avg_loss, uint64
+//                     count), double macd_line, last_close, int64 obv,
+//                     session, double session price x volume, session
+//                     volume, last typical price, uint64 bar count
+//     window x3       closes 20, closes 50, true ranges 14: uint32 length,
+//                     double[length], uint64 head, count, updates since
+//                     the last re-anchor, moments count, double mean, m2
+//     uint32 length, double[length], uint64 pushed     money flows
+//     uint32 length, int64[length], uint64 pushed, int64 sum     volumes
+//     double[4], int64[2]     last bar open, high, low, close, volume,
+//                             timestamp
+//
+// A snapshot is only accepted by a reader of the same version; periods and
+// window lengths are checked against the state being restored.
+namespace state_codec {
+
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderSize = 16;
+
+} // namespace state_codec
+
+std::vector<unsigned char> encode_state(const IncrementalIndicatorState& state);
+// Throws std::invalid_argument on a missing header, another version, a
+// truncated or corrupted payload or a layout that does not match
+IncrementalIndicatorState decode_state(const void* data, size_t size);
+
+} // namespace indicators
@@ -0,0 +1,265 @@
+#include "state_registry.h"
+#include "state_codec.h"
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace indicators {
+
+namespace {
+
+size_t symbol_hash(const std::string& symbol) {
+    return std::hash<std::string>()(symbol);
+}
+
+// Reader slot a thread tries first, so a thread keeps reusing the same
+// cache line and up to kReaderSlots threads start on different ones.
+// Counted rather than hashed from the thread id, whose values are often
+// page-aligned addresses that would all map to one slot.
+size_t reader_hint() {
+    static std::atomic<size_t> next{0};
+    thread_local const size_t hint = next.fetch_add(1, std::memory_order_relaxed);
+    return hint;
+}
+
+// Table slots for capacity symbols at a load factor of at most one half,
+// so every probe sequence reaches an empty slot
+size_t table_size(size_t capacity) {
+    size_t size = 2;
+    while (size < 2 * capacity) {
+        size *= 2;
+    }
+    return size;
+}
+
+} // namespace
+
+struct StateRegistry::Entry {
+    Entry(std::string symbol, size_t hash, int64_t session_seconds, int64_t session_offset)
+        : symbol(std::move(symbol)), hash(hash), state(session_seconds, session_offset) {}
+    
+    ~Entry() {
+        delete published.load(std::memory_order_relaxed);
+        for (auto& retiree : retired) {
+            delete retiree.second;
+        }
+        for (PublishedState* node : spare) {
+            delete node;
+        }
+    }
+    
+    // Immutable once the entry is in the table
+    const std::string symbol;
+    const size_t hash;
+    
+    // The only field readers touch, apart from the key
+    alignas(64) std::atomic<PublishedState*> published{nullptr};
+    
+    // Writer side, guarded by writer
+    alignas(64) mutable std::mutex writer;
+    IncrementalIndicatorState state;
+    uint64_t version = 0;
+    std::vector<std::pair<uint64_t, PublishedState*>> retired;  // with their epoch, oldest first
+    std::vector<PublishedState*> spare;
+};
+
+StateRegistry::StateRegistry(size_t capacity, int64_t vwap_session_seconds,
+                             int64_t vwap_session_offset)
+    : mask_(table_size(capacity) - 1),
+      capacity_(capacity),
+      size_(0),
+      session_seconds_(vwap_session_seconds),
+      session_offset_(vwap_session_offset),
+      readers_(new ReaderSlot[kReaderSlots]),
+      epoch_(0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("State registry capacity must be positive");
+    }
+    if (vwap_session_seconds <= 0) {
+        throw std::invalid_argument("VWAP session length must be positive");
+    }
+    table_.reset(new std::atomic<Entry*>[mask_ + 1]);
+    for (size_t i = 0; i <= mask_; ++i) {
+        table_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+StateRegistry::~StateRegistry() {
+    for (size_t i = 0; i <= mask_; ++i) {
+        delete table_[i].load(std::memory_order_relaxed);
+    }
+}
+
+StateRegistry::Entry* StateRegistry::find(const std::string& symbol, size_t hash) const {
+    for (size_t i = hash & mask_;; i = (i + 1) & mask_) {
+        Entry* entry = table_[i].load(std::memory_order_acquire);
+        if (entry == nullptr) {
+            return nullptr;
+        }
+        if (entry->hash == hash && entry->symbol == symbol) {
+            return entry;
+        }
+    }
+}
+
+StateRegistry::Entry& StateRegistry::find_or_insert(const std::string& symbol) {
+    const size_t hash = symbol_hash(symbol);
+    if (Entry* entry = find(symbol, hash)) {
+        return *entry;
+    }
+    
+    if (size_.fetch_add(1, std::memory_order_acq_rel) >= capacity_) {
+        size_.fetch_sub(1, std::memory_order_acq_rel);
+        throw std::runtime_error("State registry is full");
+    }
+    // Published before it becomes reachable, so readers always find a state
+    std::unique_ptr<Entry> created(new Entry(symbol, hash, session_seconds_, session_offset_));
+    {
+        std::lock_guard<std::mutex> lock(created->writer);
+        publish(*created);
+    }
+    
+    for (size_t i = hash & mask_;; i = (i + 1) & mask_) {
+        Entry* entry = nullptr;
+        if (table_[i].compare_exchange_strong(entry, created.get(), std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+            return *created.release();
+        }
+        // Another writer took the slot first, possibly for this symbol
+        if (entry->hash == hash && entry->symbol == symbol) {
+            size_.fetch_sub(1, std::memory_order_acq_rel);
+            return *entry;
+        }
+    }
+}
+
+template <typename Update>
+void StateRegistry::update(const std::string& symbol, Update&& apply) {
+    Entry& entry = find_or_insert(symbol);
+    std::lock_guard<std::mutex> lock(entry.writer);
+    apply(entry.state);
+    publish(entry);
+}
+
+void StateRegistry::push_bar(const std::string& symbol, const OHLC& bar) {
+    update(symbol, [&](IncrementalIndicatorState& state) { state.push_bar(bar); });
+}
+
+void StateRegistry::update_last_bar(const std::string& symbol, const OHLC& bar) {
+    update(symbol, [&](IncrementalIndicatorState& state) { state.update_last_bar(bar); });
+}
+
+void StateRegistry::apply_tick(const std::string& symbol, double price, int64_t volume) {
+    update(symbol, [&](IncrementalIndicatorState& state) { state.apply_tick(price, volume); });
+}
+
+void StateRegistry::restore(const std::string& symbol, const IncrementalIndicatorState& state) {
+    update(symbol, [&](IncrementalIndicatorState& current) { current = state; });
+}
+
+std::vector<unsigned char> StateRegistry::snapshot(const std::string& symbol) const {
+    Entry* entry = find(symbol, symbol_hash(symbol));
+    if (entry == nullptr) {
+        throw std::out_of_range("No indicator state for symbol " + symbol);
+    }
+    std::lock_guard<std::mutex> lock(entry->writer);
+    return encode_state(entry->state);
+}
+
+void StateRegistry::publish(Entry& entry) {
+    PublishedState* node;
+    if (entry.spare.empty()) {
+        node = new PublishedState();
+    } else {
+        node = entry.spare.back();
+        entry.spare.pop_back();
+    }
+    
+    const IncrementalIndicatorState& state = entry.state;
+    node->version = entry.version++;
+    node->bar_count = state.bar_count();
+    node->ready = state.ready();
+    node->last_bar = state.bar_count() > 0 ? state.last_bar() : OHLC{};
+    if (node->ready) {
+        node->results = state.results();
+        node->volume = state.volume_indicators();
+    } else {
+        node->results = IndicatorResults{};
+        node->volume = VolumeIndicators{};
+    }
+    
+    // Tagged after the swap: a reader announced in an older epoch may still
+    // hold the replaced node, one announced later cannot reach it
+    PublishedState* replaced = entry.published.exchange(node, std::memory_order_seq_cst);
+    if (replaced != nullptr) {
+        entry.retired.emplace_back(epoch_.load(std::memory_order_seq_cst), replaced);
+        if (entry.retired.size() >= kRetireBatch) {
+            reclaim(entry);
+        }
+    }
+}
+
+void StateRegistry::reclaim(Entry& entry) {
+    try_advance_epoch();
+    const uint64_t epoch = epoch_.load(std::memory_order_acquire);
+    size_t reusable = 0;
+    while (reusable < entry.retired.size() && entry.retired[reusable].first + 2 <= epoch) {
+        entry.spare.push_back(entry.retired[reusable].second);
+        ++reusable;
+    }
+    entry.retired.erase(entry.retired.begin(), entry.retired.begin() + reusable);
+}
+
+void StateRegistry::try_advance_epoch() {
+    uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+    const uint64_t current = (epoch << 1) | 1;
+    for (size_t i = 0; i < kReaderSlots; ++i) {
+        uint64_t announced = readers_[i].announced.load(std::memory_order_seq_cst);
+        if (announced != 0 && announced != current) {
+            return;
+        }
+    }
+    // Fails harmlessly if another writer advanced it first
+    epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+}
+
+StateRegistry::ReaderSlot& StateRegistry::enter_read() const {
+    const uint64_t announced = (epoch_.load(std::memory_order_seq_cst) << 1) | 1;
+    for (size_t i = reader_hint();; ++i) {
+        ReaderSlot& slot = readers_[i % kReaderSlots];
+        uint64_t free = 0;
+        if (slot.announced.load(std::memory_order_relaxed) == 0 &&
+            slot.announced.compare_exchange_strong(free, announced, std::memory_order_seq_cst)) {
+            return slot;
+        }
+    }
+}
+
+bool StateRegistry::read(const std::string& symbol, PublishedState& out) const {
+    // Entries are never freed while the registry lives, only their states
+    Entry* entry = find(symbol, symbol_hash(symbol));
+    if (entry == nullptr) {
+        return false;
+    }
+    ReaderSlot& slot = enter_read();
+    out = *entry->published.load(std::memory_order_seq_cst);
+    slot.announced.store(0, std::memory_order_release);
+    return true;
+}
+
+bool StateRegistry::contains(const std::string& symbol) const {
+    return find(symbol, symbol_hash(symbol)) != nullptr;
+}
+
+std::vector<std::string> StateRegistry::symbols() const {
+    std::vector<std::string> symbols;
+    for (size_t i = 0; i <= mask_; ++i) {
+        if (const Entry* entry = table_[i].load(std::memory_order_acquire)) {
+            symbols.push_back(entry->symbol);
+        }
+    }
+    return symbols;
+}
+
+} // namespace indicators
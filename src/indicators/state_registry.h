@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "indicators.h"
+
+namespace indicators {
+
+// Indicator values of one symbol as its latest update left them. results
+// and volume are only filled in once ready.
+struct PublishedState {
+    uint64_t version = 0;  // updates of the symbol so far
+    size_t bar_count = 0;
+    bool ready = false;
+    OHLC last_bar{};
+    IndicatorResults results{};
+    VolumeIndicators volume{};
+};
+
+// Map from symbol to IncrementalIndicatorState shared by many feed threads
+// and readers.
+//
+// Writers of a symbol serialize on that symbol's own lock and touch no
+// other symbol's memory, so feeds of different symbols never contend once
+// their symbols are registered. After each update the writer publishes an
+// immutable PublishedState by swapping one pointer, and read() copies the
+// current one: readers take no lock and never retry, so a read is
+// wait-free as long as at most kReaderSlots reads are in flight at once.
+// Symbols live in a fixed open-addressing table and are never removed.
+//
+// Replaced PublishedStates are recycled with epoch-based reclamation. For
+// the length of its copy a reader announces the global epoch in a reader
+// slot; a state retired in epoch e is reused only once the epoch reached
+// e + 2, and the epoch only advances when every announced reader has seen
+// the current one. Writers advance it once per kRetireBatch updates of a
+// symbol, so the shared counter is rarely written; a reader stalled inside
+// read() delays reuse (and retired states pile up) until it returns.
+class StateRegistry {
+public:
+    static constexpr size_t kReaderSlots = 64;
+    static constexpr size_t kRetireBatch = 16;
+    
+    // Room for capacity symbols; new states use the given VWAP session
+    explicit StateRegistry(size_t capacity = 4096, int64_t vwap_session_seconds = 86400,
+                           int64_t vwap_session_offset = 0);
+    
+    StateRegistry(const StateRegistry&) = delete;
+    StateRegistry& operator=(const StateRegistry&) = delete;
+    // No reader or writer may still be running
+    ~StateRegistry();
+    
+    // Writer side. Each call creates the symbol's state on first use and
+    // throws std::runtime_error if capacity symbols are already registered.
+    void push_bar(const std::string& symbol, const OHLC& bar);
+    void update_last_bar(const std::string& symbol, const OHLC& bar);
+    void apply_tick(const std::string& symbol, double price, int64_t volume = 0);
+    // Replace the symbol's state, e.g. with decode_state() of a snapshot
+    void restore(const std::string& symbol, const IncrementalIndicatorState& state);
+    // encode_state() of the symbol's state, taken under its writer lock so
+    // it holds up that symbol's writers but no reader. Throws
+    // std::out_of_range for a symbol without state.
+    std::vector<unsigned char> snapshot(const std::string& symbol) const;
+    
+    // Reader side: copy the symbol's latest published state into out;
+    // false if the symbol has no state
+    bool read(const std::string& symbol, PublishedState& out) const;
+    bool contains(const std::string& symbol) const;
+    
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+    size_t capacity() const { return capacity_; }
+    std::vector<std::string> symbols() const;
+
+private:
+    struct Entry;
+    
+    // Own cache line per slot so readers on different slots do not
+    // false-share; 0 while free, else (epoch << 1) | 1
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> announced{0};
+    };
+    
+    Entry* find(const std::string& symbol, size_t hash) const;
+    Entry& find_or_insert(const std::string& symbol);
+    template <typename Update>
+    void update(const std::string& symbol, Update&& apply);
+    // Swap in the entry's current values; the entry's writer lock is held
+    void publish(Entry& entry);
+    void reclaim(Entry& entry);
+    void try_advance_epoch();
+    ReaderSlot& enter_read() const;
+    
+    std::unique_ptr<std::atomic<Entry*>[]> table_;
+    size_t mask_;
+    size_t capacity_;
+    std::atomic<size_t> size_;
+    int64_t session_seconds_;
+    int64_t session_offset_;
+    std::unique_ptr<ReaderSlot[]> readers_;
+    // Read on every update, written once per advance
+    alignas(64) std::atomic<uint64_t> epoch_;
+};
+
+} // namespace indicators
@@ -0,0 +1,204 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+namespace indicators {
+
+namespace {
+
+// Identifies the pool and queue owned by the current worker thread
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local size_t tls_index = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t num_threads)
+    : pending_(0), next_queue_(0), stop_(false) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    queues_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+    
+    threads_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::shared() {
+    static std::shared_ptr<ThreadPool> pool = std::make_shared<ThreadPool>();
+    return pool;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    size_t index = (tls_pool == this)
+        ? tls_index
+        : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    pending_.fetch_add(1, std::memory_order_release);
+    
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::try_pop(size_t index, std::function<void()>& task) {
+    WorkQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ThreadPool::try_steal(size_t thief, std::function<void()>& task) {
+    for (size_t offset = 1; offset <= queues_.size(); ++offset) {
+        WorkQueue& queue = *queues_[(thief + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// Run one queued task on the calling thread, if there is any
+bool ThreadPool::run_pending_task(size_t preferred) {
+    std::function<void()> task;
+    if (tls_pool == this && try_pop(tls_index, task)) {
+        task();
+        return true;
+    }
+    if (try_steal(preferred, task)) {
+        task();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    tls_pool = this;
+    tls_index = index;
+    
+    while (true) {
+        std::function<void()> task;
+        if (try_pop(index, task) || try_steal(index, task)) {
+            task();
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [this]() {
+            return stop_ || pending_.load(std::memory_order_acquire) > 0;
+        });
+        if (stop_ && pending_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallel_for(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1 || size() <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+    
+    // Helpers and the caller pull indices from a shared counter, so load
+    // balancing does not depend on how the tasks were distributed.
+    struct LoopState {
+        std::atomic<size_t> next{0};
+        size_t remaining = 0;
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<LoopState>();
+    const std::function<void(size_t)>* loop_body = &body;
+    
+    auto run_indices = [state, loop_body, count]() {
+        try {
+            for (size_t i = state->next.fetch_add(1); i < count; i = state->next.fetch_add(1)) {
+                (*loop_body)(i);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!state->error) {
+                state->error = std::current_exception();
+            }
+            // Skip the remaining indices
+            state->next.store(count);
+        }
+    };
+    
+    size_t helpers = std::min(count, size()) - 1;
+    state->remaining = helpers;
+    for (size_t i = 0; i < helpers; ++i) {
+        enqueue([state, run_indices]() {
+            run_indices();
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (--state->remaining == 0) {
+                state->done.notify_all();
+            }
+        });
+    }
+    
+    run_indices();
+    
+    // Keep executing queued work while the helpers finish; a helper may
+    // still be sitting in a queue behind the caller's own task.
+    size_t preferred = tls_pool == this ? tls_index : 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            if (state->remaining == 0) {
+                break;
+            }
+        }
+        if (run_pending_task(preferred)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done.wait_for(lock, std::chrono::milliseconds(1), [&state]() {
+            return state->remaining == 0;
+        });
+    }
+    
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace indicators
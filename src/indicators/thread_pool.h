@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace indicators {
+
+// Work-stealing thread pool. Each worker owns a deque: it pops its own
+// tasks from the front and steals from the back of the other workers'
+// deques when it runs dry. Tasks submitted from a worker thread go to that
+// worker's deque; external submissions are spread round-robin.
+class ThreadPool {
+public:
+    // num_threads == 0 uses std::thread::hardware_concurrency()
+    explicit ThreadPool(size_t num_threads = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    size_t size() const { return threads_.size(); }
+    
+    // Run a callable on the pool and return a future for its result
+    template <typename F>
+    auto submit(F&& fn) -> std::future<typename std::invoke_result<F>::type> {
+        using Result = typename std::invoke_result<F>::type;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+        std::future<Result> future = task->get_future();
+        enqueue([task]() { (*task)(); });
+        return future;
+    }
+    
+    // Call body(i) for every i in [0, count) and block until all are done.
+    // The calling thread helps execute tasks while it waits, so nested
+    // calls from inside a pool task do not deadlock.
+    void parallel_for(size_t count, const std::function<void(size_t)>& body);
+    
+    // Process-wide pool sized to the hardware
+    static std::shared_ptr<ThreadPool> shared();
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    
+    void enqueue(std::function<void()> task);
+    void worker_loop(size_t index);
+    bool try_pop(size_t index, std::function<void()>& task);
+    bool try_steal(size_t thief, std::function<void()>& task);
+    bool run_pending_task(size_t preferred);
+    
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> pending_;
+    std::atomic<size_t> next_queue_;
+    bool stop_;
+};
+
+} // namespace indicators
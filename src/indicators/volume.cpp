@@ -0,0 +1,317 @@
+#include "indicators.h"
+#include "profiling.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace indicators {
+
+namespace {
+
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+void check_period(int period) {
+    if (period <= 0) {
+        throw std::invalid_argument("Indicator period must be positive");
+    }
+}
+
+void check_volume(PriceView close, ArrayView<int64_t> volume) {
+    if (volume.size() != close.size()) {
+        throw std::invalid_argument("Price and volume lengths do not match");
+    }
+}
+
+void check_volume(PriceView high, PriceView low, PriceView close, ArrayView<int64_t> volume) {
+    if (high.size() != close.size() || low.size() != close.size()) {
+        throw std::invalid_argument("High, low and close lengths do not match");
+    }
+    check_volume(close, volume);
+}
+
+void check_session(ArrayView<int64_t> timestamp, size_t size, int64_t session_seconds) {
+    if (session_seconds <= 0) {
+        throw std::invalid_argument("VWAP session length must be positive");
+    }
+    if (timestamp.size() != 0 && timestamp.size() != size) {
+        throw std::invalid_argument("Timestamp length does not match input length");
+    }
+}
+
+// Validate an output buffer against the input length and clear it to NaN
+void prepare_output(SeriesBuffer out, size_t size) {
+    if (out.size() != size) {
+        throw std::invalid_argument("Output buffer length does not match input length");
+    }
+    std::fill(out.data(), out.data() + out.size(), kNaN);
+}
+
+double typical_price(PriceView high, PriceView low, PriceView close, size_t i) {
+    return (high[i] + low[i] + close[i]) / 3.0;
+}
+
+// Signed OBV contribution of bar i (i >= 1)
+int64_t obv_step(PriceView close, ArrayView<int64_t> volume, size_t i) {
+    if (close[i] > close[i - 1]) {
+        return volume[i];
+    }
+    return close[i] < close[i - 1] ? -volume[i] : 0;
+}
+
+// Money flow of bar i (i >= 1): typical price times volume, negative
+// when the typical price fell and zero when it did not move
+double money_flow(PriceView high, PriceView low, PriceView close, ArrayView<int64_t> volume,
+                  size_t i) {
+    double typical = typical_price(high, low, close, i);
+    double previous = typical_price(high, low, close, i - 1);
+    double flow = typical * static_cast<double>(volume[i]);
+    if (typical > previous) {
+        return flow;
+    }
+    return typical < previous ? -flow : 0.0;
+}
+
+// Running sum of one side's money flows over a sliding window. The sum
+// returns to exactly zero whenever the window holds no flows of that
+// side, so MFI reaches 100 just as the scalar kernel does.
+struct FlowSum {
+    double sum = 0.0;
+    size_t count = 0;
+    
+    void add(double flow) {
+        sum += flow;
+        ++count;
+    }
+    void remove(double flow) {
+        sum -= flow;
+        if (--count == 0) {
+            sum = 0.0;
+        }
+    }
+};
+
+double money_flow_index(double positive, double negative) {
+    if (negative <= 0.0) {
+        return 100.0;
+    }
+    return 100.0 - (100.0 / (1.0 + positive / negative));
+}
+
+// Session of bar i; without timestamps every bar is in session 0
+int64_t bar_session(ArrayView<int64_t> timestamp, size_t i, int64_t session_seconds,
+                    int64_t session_offset) {
+    if (timestamp.size() == 0) {
+        return 0;
+    }
+    return session_of(timestamp[i], session_seconds, session_offset);
+}
+
+} // namespace
+
+int64_t session_of(int64_t timestamp, int64_t session_seconds, int64_t session_offset) {
+    int64_t shifted = timestamp - session_offset;
+    int64_t session = shifted / session_seconds;
+    // Round toward negative infinity for timestamps before the offset
+    return (shifted % session_seconds < 0) ? session - 1 : session;
+}
+
+// On-Balance Volume: volume added on up closes, subtracted on down closes
+double TechnicalIndicatorEngine::compute_obv(PriceView close, ArrayView<int64_t> volume) {
+    INDICATORS_PROFILE(OBV, close.size());
+    check_volume(close, volume);
+    if (close.size() == 0) {
+        throw std::invalid_argument("Insufficient data for OBV calculation");
+    }
+    
+    int64_t obv = 0;
+    for (size_t i = 1; i < close.size(); ++i) {
+        obv += obv_step(close, volume, i);
+    }
+    return static_cast<double>(obv);
+}
+
+// Session-anchored VWAP over the bars of the last bar's session
+double TechnicalIndicatorEngine::compute_vwap(PriceView high, PriceView low, PriceView close,
+                                              ArrayView<int64_t> volume,
+                                              ArrayView<int64_t> timestamp,
+                                              int64_t session_seconds,
+                                              int64_t session_offset) {
+    INDICATORS_PROFILE(VWAP, close.size());
+    check_volume(high, low, close, volume);
+    check_session(timestamp, close.size(), session_seconds);
+    if (close.size() == 0) {
+        throw std::invalid_argument("Insufficient data for VWAP calculation");
+    }
+    
+    const size_t last = close.size() - 1;
+    const int64_t session = bar_session(timestamp, last, session_seconds, session_offset);
+    size_t first = last;
+    while (first > 0 &&
+           bar_session(timestamp, first - 1, session_seconds, session_offset) == session) {
+        --first;
+    }
+    
+    // Summed forward, as the series and streaming variants do
+    double price_volume = 0.0;
+    double total_volume = 0.0;
+    for (size_t i = first; i <= last; ++i) {
+        price_volume += typical_price(high, low, close, i) * static_cast<double>(volume[i]);
+        total_volume += static_cast<double>(volume[i]);
+    }
+    return total_volume > 0.0 ? price_volume / total_volume : kNaN;
+}
+
+// Money Flow Index over the last period bars
+double TechnicalIndicatorEngine::compute_mfi(PriceView high, PriceView low, PriceView close,
+                                             ArrayView<int64_t> volume, int period) {
+    INDICATORS_PROFILE(MFI, close.size());
+    check_period(period);
+    check_volume(high, low, close, volume);
+    if (close.size() < static_cast<size_t>(period + 1)) {
+        throw std::invalid_argument("Insufficient data for MFI calculation");
+    }
+    
+    double positive = 0.0;
+    double negative = 0.0;
+    for (size_t i = close.size() - period; i < close.size(); ++i) {
+        double flow = money_flow(high, low, close, volume, i);
+        if (flow > 0.0) {
+            positive += flow;
+        } else {
+            negative -= flow;
+        }
+    }
+    return money_flow_index(positive, negative);
+}
+
+// Simple moving average of volume, summed exactly in integers
+double TechnicalIndicatorEngine::compute_volume_sma(ArrayView<int64_t> volume, int period) {
+    INDICATORS_PROFILE(VOLUME_SMA, volume.size());
+    check_period(period);
+    if (volume.size() < static_cast<size_t>(period)) {
+        throw std::invalid_argument("Insufficient data for volume SMA calculation");
+    }
+    
+    int64_t sum = 0;
+    for (size_t i = volume.size() - period; i < volume.size(); ++i) {
+        sum += volume[i];
+    }
+    return static_cast<double>(sum) / period;
+}
+
+void TechnicalIndicatorEngine::compute_obv_series(PriceView close, ArrayView<int64_t> volume,
+                                                  SeriesBuffer out) {
+    INDICATORS_PROFILE(OBV_SERIES, close.size());
+    check_volume(close, volume);
+    prepare_output(out, close.size());
+    
+    int64_t obv = 0;
+    for (size_t i = 0; i < close.size(); ++i) {
+        if (i > 0) {
+            obv += obv_step(close, volume, i);
+        }
+        out[i] = static_cast<double>(obv);
+    }
+}
+
+// VWAP series, restarting the sums at each session boundary
+void TechnicalIndicatorEngine::compute_vwap_series(PriceView high,
+                                                   PriceView low,
+                                                   PriceView close,
+                                                   ArrayView<int64_t> volume,
+                                                   ArrayView<int64_t> timestamp,
+                                                   SeriesBuffer out,
+                                                   int64_t session_seconds,
+                                                   int64_t session_offset) {
+    INDICATORS_PROFILE(VWAP_SERIES, close.size());
+    check_volume(high, low, close, volume);
+    check_session(timestamp, close.size(), session_seconds);
+    prepare_output(out, close.size());
+    
+    double price_volume = 0.0;
+    double total_volume = 0.0;
+    int64_t session = 0;
+    for (size_t i = 0; i < close.size(); ++i) {
+        int64_t current = bar_session(timestamp, i, session_seconds, session_offset);
+        if (i == 0 || current != session) {
+            session = current;
+            price_volume = 0.0;
+            total_volume = 0.0;
+        }
+        price_volume += typical_price(high, low, close, i) * static_cast<double>(volume[i]);
+        total_volume += static_cast<double>(volume[i]);
+        if (total_volume > 0.0) {
+            out[i] = price_volume / total_volume;
+        }
+    }
+}
+
+// MFI series from sliding sums of positive and negative money flow,
+// re-anchored from the bars once per window so long runs do not accumulate
+// drift
+void TechnicalIndicatorEngine::compute_mfi_series(PriceView high,
+                                                  PriceView low,
+                                                  PriceView close,
+                                                  ArrayView<int64_t> volume,
+                                                  SeriesBuffer out,
+                                                  int period) {
+    INDICATORS_PROFILE(MFI_SERIES, close.size());
+    check_period(period);
+    check_volume(high, low, close, volume);
+    prepare_output(out, close.size());
+    
+    const size_t window = static_cast<size_t>(period);
+    FlowSum positive;
+    FlowSum negative;
+    auto slide = [&](size_t i, bool entering) {
+        double flow = money_flow(high, low, close, volume, i);
+        if (flow == 0.0) {
+            return;
+        }
+        FlowSum& side = flow > 0.0 ? positive : negative;
+        if (entering) {
+            side.add(std::abs(flow));
+        } else {
+            side.remove(std::abs(flow));
+        }
+    };
+    for (size_t i = 1; i < close.size(); ++i) {
+        if (i % window == 0) {
+            // Oldest flow first, as compute_mfi sums them
+            positive = FlowSum();
+            negative = FlowSum();
+            for (size_t k = i + 1 - window; k <= i; ++k) {
+                slide(k, true);
+            }
+        } else {
+            slide(i, true);
+            if (i > window) {
+                slide(i - window, false);
+            }
+        }
+        if (i >= window) {
+            out[i] = money_flow_index(positive.sum, negative.sum);
+        }
+    }
+}
+
+void TechnicalIndicatorEngine::compute_volume_sma_series(ArrayView<int64_t> volume,
+                                                         SeriesBuffer out, int period) {
+    INDICATORS_PROFILE(VOLUME_SMA_SERIES, volume.size());
+    check_period(period);
+    prepare_output(out, volume.size());
+    
+    const size_t window = static_cast<size_t>(period);
+    int64_t sum = 0;
+    for (size_t i = 0; i < volume.size(); ++i) {
+        sum += volume[i];
+        if (i >= window) {
+            sum -= volume[i - window];
+        }
+        if (i + 1 >= window) {
+            out[i] = static_cast<double>(sum) / period;
+        }
+    }
+}
+
+} // namespace indicators
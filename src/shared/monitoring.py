@@ -137,6 +137,17 @@ class SystemHealthMonitor:
         
         return alerts
     
+    def get_indicator_engine_metrics(self) -> Dict[str, Dict[str, float]]:
+        """
+        Get per-indicator latency and counters from the C++ engine.
+        
+        Returns:
+            Dict of probe name to counters; empty unless the engine was built
+            with profiling enabled
+        """
+        from src.indicators.engine import TechnicalIndicatorEngine
+        return TechnicalIndicatorEngine.profiling_snapshot()
+    
     def log_health_status(self):
         """Log current health status."""
         status = self.get_health_status()
@@ -5,7 +5,7 @@ from datetime import datetime, timedelta
 from unittest.mock import Mock, MagicMock, patch
 import numpy as np
 
-from src.backtest.engine import BacktestingModule
+from src.backtest.engine import BacktestingModule, CPP_BACKTEST_AVAILABLE
 from src.database.connection import DatabaseConnection
 from src.shared.models import (
     BacktestConfig, Trade, TradingSignalType, OHLC, Event, EventType
@@ -377,6 +377,117 @@ class TestBacktestingModule:
         assert result.metrics.total_return == 0.0
         assert len(result.equity_curve) == 1
         assert result.equity_curve[0][1] == sample_config.initial_capital
+    
+    @pytest.mark.skipif(not CPP_BACKTEST_AVAILABLE, reason="C++ module not built")
+    def test_native_sweep_matches_python_metrics(self, backtest_module, sample_config):
+        """Test that the C++ sweep reproduces the Python metric definitions."""
+        from indicators_engine import Backtester, StrategyParams
+        
+        rng = np.random.default_rng(7)
+        closes = 100.0 * np.cumprod(1.0 + 0.01 * rng.standard_normal(2000))
+        
+        grid = []
+        for rsi_period in (7, 14):
+            for overbought in (65.0, 70.0):
+                params = StrategyParams()
+                params.rsi_period = rsi_period
+                params.rsi_overbought = overbought
+                params.rsi_oversold = 100.0 - overbought
+                params.buy_threshold = 30.0
+                params.sell_threshold = -30.0
+                grid.append(params)
+        
+        backtester = Backtester(2)
+        results = backtester.sweep(closes, grid)
+        assert len(results) == len(grid)
+        
+        for params, result in zip(grid, results):
+            metrics, equity = backtester.run_with_equity_curve(closes, params)
+            assert len(equity) == len(closes) + 1
+            assert result.total_trades == metrics.total_trades
+            assert result.pnl == metrics.pnl
+            if metrics.total_trades == 0:
+                continue
+            
+            start = datetime(2024, 1, 1)
+            curve = [(start + timedelta(days=i), float(e)) for i, e in enumerate(equity)]
+            assert metrics.sharpe_ratio == pytest.approx(
+                backtest_module._compute_sharpe_ratio(curve, params.initial_capital), rel=1e-9, abs=1e-12)
+            assert metrics.max_drawdown == pytest.approx(
+                backtest_module._compute_max_drawdown(curve), rel=1e-12)
+            assert metrics.total_return == pytest.approx(
+                (equity[-1] - params.initial_capital) / params.initial_capital)
+        
+        with pytest.raises(ValueError):
+            bad = StrategyParams()
+            bad.rsi_period = 0
+            backtester.sweep(closes, [bad])
+    
+    @pytest.mark.skipif(not CPP_BACKTEST_AVAILABLE, reason="C++ module not built")
+    def test_run_parameter_sweep(self, backtest_module, sample_config):
+        """Test the sweep entry point over loaded historical data."""
+        closes = 100.0 * np.cumprod(1.0 + 0.02 * np.sin(np.arange(300) / 7.0))
+        columns = {'close': closes}
+        
+        grid = [{'rsi_period': 7}, {'rsi_period': 14, 'buy_threshold': 30.0}]
+        with patch.object(backtest_module, 'load_price_columns', return_value=columns):
+            results = backtest_module.run_parameter_sweep(sample_config, grid, num_threads=2)
+        
+        assert [r['params'] for r in results] == grid
+        for result in results:
+            assert result['total_trades'] >= 0
+            assert 0.0 <= result['max_drawdown'] <= 1.0
+        
+        with pytest.raises(ValueError):
+            with patch.object(backtest_module, 'load_price_columns', return_value=columns):
+                backtest_module.run_parameter_sweep(sample_config, [{'rsi_lookback': 7}])
+    
+    @pytest.mark.skipif(not CPP_BACKTEST_AVAILABLE, reason="C++ module not built")
+    def test_load_price_columns_uses_bar_cache(self, mock_db_connection, tmp_path):
+        """Test that a cached range is served from the mapped file."""
+        module = BacktestingModule(mock_db_connection, bar_cache_dir=str(tmp_path))
+        start = datetime(2024, 1, 1)
+        prices = [
+            Mock(open=100.0 + i, high=101.0 + i, low=99.0 + i, close=100.5 + i,
+                 volume=1000 + i, timestamp=start + timedelta(days=i))
+            for i in range(30)
+        ]
+        
+        with patch('src.backtest.engine.PriceRepository') as repo_class:
+            repo_class.return_value.get_by_symbol_and_timerange.return_value = prices
+            first = module.load_price_columns("AAPL", start, start + timedelta(days=29))
+            # A sub-range of the cached one does not query the database again
+            second = module.load_price_columns(
+                "AAPL", start + timedelta(days=10), start + timedelta(days=19)
+            )
+            assert repo_class.return_value.get_by_symbol_and_timerange.call_count == 1
+        
+        np.testing.assert_array_equal(second['close'], first['close'][10:20])
+        np.testing.assert_array_equal(second['volume'], first['volume'][10:20])
+        np.testing.assert_array_equal(second['timestamp'], first['timestamp'][10:20])
+        assert not second['close'].flags.writeable
+    
+    @pytest.mark.skipif(not CPP_BACKTEST_AVAILABLE, reason="C++ module not built")
+    def test_concurrent_bar_cache_writers(self, tmp_path):
+        """Test that writers of one symbol each rename a complete file into place."""
+        from concurrent.futures import ThreadPoolExecutor
+        from indicators_engine import BarCache
+        
+        path = str(tmp_path / "AAPL.bars")
+        timestamps = np.arange(1704067200, 1704067200 + 86400 * 2000, 86400, dtype=np.int64)
+        
+        def write(level):
+            close = np.full(len(timestamps), float(level))
+            BarCache.write(path, "AAPL", close + 1.0, close - 1.0, close, timestamps)
+        
+        with ThreadPoolExecutor(max_workers=4) as pool:
+            list(pool.map(write, range(1, 33)))
+        
+        cache = BarCache.open(path)
+        close = cache.columns()['close']
+        assert len(cache) == len(timestamps)
+        assert close[0] in range(1, 33) and np.all(close == close[0])
+        assert [entry.name for entry in tmp_path.iterdir()] == ["AAPL.bars"]
 
 
 if __name__ == "__main__":
@@ -1,9 +1,14 @@
 """Unit tests for Technical Indicator Engine."""
 
+import math
 import pytest
-from datetime import datetime, timedelta
-from src.shared.models import OHLC, PriceData, TechnicalSignalType
-from src.indicators import TechnicalIndicatorEngine
+from dataclasses import replace
+from datetime import datetime, timedelta, timezone
+from src.shared.models import OHLC, PriceData, TechnicalSignalType, MarketRegime, RegimeType
+from src.indicators import (
+    TechnicalIndicatorEngine, IncrementalIndicatorState, MultiTimeframeIndicatorState,
+    IndicatorSpec, CompositeScorer
+)
 
 
 @pytest.fixture
@@ -45,6 +50,44 @@ def engine():
     return TechnicalIndicatorEngine()
 
 
+@pytest.fixture
+def cpp_engine():
+    """Create a native C++ engine instance, skipping if the module is not built."""
+    from src.indicators import engine as engine_module
+    if not engine_module.CPP_AVAILABLE:
+        pytest.skip("C++ module not built, skipping test")
+    return engine_module.CppEngine()
+
+
+@pytest.fixture
+def cpp_module(cpp_engine):
+    """The compiled indicators_engine module."""
+    import indicators_engine
+    return indicators_engine
+
+
+@pytest.fixture
+def sample_closes(sample_price_data):
+    """Close prices of the sample price data."""
+    return [bar.close for bar in sample_price_data.bars]
+
+
+@pytest.fixture
+def symbol_closes():
+    """(symbols, bars) matrix of closes for 37 symbols, spanning full and partial SIMD lanes."""
+    np = pytest.importorskip("numpy")
+    rows = []
+    for s in range(37):
+        price = 100.0 + s
+        row = []
+        for i in range(80):
+            # Every fourth symbol only rises, so its RSI average loss is zero
+            price += 0.5 if s % 4 == 0 else ((i * 7 + s * 3) % 11 - 5) * 0.25
+            row.append(price)
+        rows.append(row)
+    return np.asfortranarray(rows)
+
+
 class TestTechnicalIndicatorEngine:
     """Test suite for Technical Indicator Engine."""
     
@@ -276,5 +319,1337 @@ class TestIndicatorBounds:
             pytest.skip("C++ module not built, skipping test")
 
 
+class TestCppEngine:
+    """Tests for the native engine APIs not covered by the Python wrapper."""
+    
+    def test_macd_series_matches_last_value(self, cpp_engine, sample_closes):
+        """Test that the last MACD series entry equals compute_macd."""
+        macd = cpp_engine.compute_macd(sample_closes)
+        series = cpp_engine.compute_macd_series(sample_closes)
+        
+        assert len(series.macd_line) == len(sample_closes)
+        assert series.macd_line[-1] == pytest.approx(macd.macd_line)
+        assert series.signal_line[-1] == pytest.approx(macd.signal_line)
+        assert series.histogram[-1] == pytest.approx(macd.histogram)
+    
+    def test_macd_series_warmup_is_nan(self, cpp_engine, sample_closes):
+        """Test that MACD series entries before warm-up are NaN."""
+        series = cpp_engine.compute_macd_series(sample_closes, 12, 26, 9)
+        
+        assert all(math.isnan(v) for v in series.macd_line[:26])
+        assert not math.isnan(series.macd_line[26])
+        assert all(math.isnan(v) for v in series.signal_line[:34])
+        assert not math.isnan(series.signal_line[34])
+    
+    def test_binary_results_round_trip(self, cpp_module, cpp_engine, sample_price_data, sample_closes):
+        """Test that encoded results decode to the same values, also as a NumPy view."""
+        import struct
+        
+        columns = TechnicalIndicatorEngine()._convert_price_data_to_columns(sample_price_data)
+        results = cpp_engine.compute_indicators(**columns)
+        signals = cpp_engine.generate_signals(results, sample_closes[-1])
+        records = [
+            cpp_module.ResultRecord("AAPL", 1700000000, results, signals),
+            cpp_module.ResultRecord("MSFT", 1700000060, results),
+        ]
+        encoded = cpp_module.encode_results(records)
+        
+        assert encoded[:4] == b"EDIR"
+        assert struct.unpack_from("<HHI", encoded, 4) == (1, 128, 2)
+        assert len(encoded) == 16 + 2 * 128
+        
+        batch = cpp_module.ResultBatch(encoded)
+        assert len(batch) == 2
+        assert batch[0].symbol == "AAPL" and batch[0].has_signals
+        assert batch[0].indicators.macd.histogram == results.macd.histogram
+        assert batch[0].signals.bb_signal == signals.bb_signal
+        assert batch[1].timestamp == 1700000060 and not batch[1].has_signals
+        
+        array = batch.as_array()
+        assert list(array['symbol']) == [b"AAPL", b"MSFT"]
+        assert array['atr'][1] == results.atr
+        assert not array.flags.writeable
+        
+        with pytest.raises(ValueError):
+            cpp_module.ResultBatch(encoded[:-1])
+    
+    def test_binary_results_newer_version(self, cpp_module, cpp_engine, sample_price_data):
+        """Test that a version 2 batch with larger records decodes its version 1 prefix."""
+        import struct
+        
+        columns = TechnicalIndicatorEngine()._convert_price_data_to_columns(sample_price_data)
+        results = cpp_engine.compute_indicators(**columns)
+        records = [
+            cpp_module.ResultRecord("AAPL", 1700000000, results),
+            cpp_module.ResultRecord("MSFT", 1700000060, results),
+        ]
+        encoded = cpp_module.encode_results(records)
+        
+        # Same records with 32 bytes of unknown trailing fields each
+        extra = b"\xab" * 32
+        newer = struct.pack("<4sHHII", b"EDIR", 2, 128 + 32, 2, 0)
+        newer += encoded[16:144] + extra + encoded[144:272] + extra
+        batch = cpp_module.ResultBatch(newer)
+        
+        assert len(batch) == 2
+        assert batch[1].symbol == "MSFT" and batch[1].timestamp == 1700000060
+        assert batch[1].indicators.atr == results.atr
+        array = batch.as_array()
+        assert list(array['symbol']) == [b"AAPL", b"MSFT"]
+        assert array['rsi'][1] == results.rsi
+        
+        older = bytearray(encoded)
+        older[4:6] = struct.pack("<H", 0)
+        with pytest.raises(ValueError, match="unsupported version"):
+            cpp_module.ResultBatch(bytes(older))
+    
+    def test_bollinger_series_stable_for_long_windows(self, cpp_engine):
+        """Test rolling band width against a two-pass std dev at a high price level."""
+        import statistics
+        # Tick-sized moves on a large price, where a running sum of squares
+        # loses every significant digit of the variance
+        prices = [1e6 + 1e-3 * ((i * 7919) % 101 - 50) for i in range(6000)]
+        period = 2000
+        upper, middle, lower = cpp_engine.compute_bollinger_series(prices, period, 2.0)
+        
+        for i in (period - 1, 3333, len(prices) - 1):
+            window = prices[i + 1 - period:i + 1]
+            assert middle[i] == pytest.approx(statistics.fmean(window))
+            assert (upper[i] - middle[i]) / 2.0 == pytest.approx(statistics.pstdev(window), rel=1e-6)
+    
+    def test_running_series_do_not_drift(self, cpp_engine):
+        """Test SMA and ATR series against the scalar kernels deep into a long series."""
+        close = [1e6 + 1e-3 * ((i * 7919) % 101 - 50) for i in range(100000)]
+        high = [c + 1e-3 * (i % 7) for i, c in enumerate(close)]
+        low = [c - 1e-3 * (i % 5) for i, c in enumerate(close)]
+        period = 14
+        sma = cpp_engine.compute_sma_series(close, period)
+        atr = cpp_engine.compute_atr_series(high, low, close, period)
+        
+        # Re-anchored from the window every period bars, exact there and
+        # within a few slides' rounding in between
+        for i in (period, 4 * period - 1, 70013, 99750, len(close) - 1):
+            n = i + 1
+            expected_sma = cpp_engine.compute_sma(close[:n], period)
+            expected_atr = cpp_engine.compute_atr(high[:n], low[:n], close[:n], period)
+            if n % period == 0:
+                assert sma[i] == expected_sma
+            if i % period == 0:
+                assert atr[i] == expected_atr
+            assert sma[i] == pytest.approx(expected_sma, rel=1e-13)
+            assert atr[i] == pytest.approx(expected_atr, rel=1e-12)
+    
+    def test_mfi_series_does_not_drift(self, cpp_engine):
+        """Test the MFI series against compute_mfi deep into a long series."""
+        close = [1e6 + 1e-3 * ((i * 7919) % 101 - 50) for i in range(100000)]
+        high = [c + 1e-3 * (i % 7) for i, c in enumerate(close)]
+        low = [c - 1e-3 * (i % 5) for i, c in enumerate(close)]
+        volume = [1000 + (i * 104729) % 997 for i in range(len(close))]
+        period = 14
+        mfi = cpp_engine.compute_mfi_series(high, low, close, volume, period)
+        
+        for i in (period, 4 * period - 1, 70013, 99750, len(close) - 1):
+            n = i + 1
+            expected = cpp_engine.compute_mfi(high[:n], low[:n], close[:n], volume[:n], period)
+            if i % period == 0:
+                assert mfi[i] == expected
+            assert mfi[i] == pytest.approx(expected, rel=1e-12)
+    
+    def test_profiling_snapshot(self, cpp_module, cpp_engine, sample_price_data):
+        """Test the per-indicator counters, or that they are empty when compiled out."""
+        from src.indicators.engine import TechnicalIndicatorEngine
+        
+        TechnicalIndicatorEngine.reset_profiling()
+        TechnicalIndicatorEngine().compute_indicators(sample_price_data)
+        snapshot = TechnicalIndicatorEngine.profiling_snapshot()
+        
+        if not cpp_module.profiling_enabled():
+            assert cpp_module.profiling_snapshot() == []
+            assert snapshot == {}
+            return
+        
+        bars = len(sample_price_data.bars)
+        for name in ('compute_indicators', 'close_pass', 'bollinger', 'atr'):
+            assert snapshot[name]['calls'] == 1
+            assert snapshot[name]['bars'] == bars
+            assert 0 < snapshot[name]['p50_ns'] <= snapshot[name]['p99_ns'] <= snapshot[name]['max_ns']
+        # The wrapper passes NumPy columns, so no bars are gathered
+        assert 'gather_columns' not in snapshot
+        
+        TechnicalIndicatorEngine.reset_profiling()
+        assert TechnicalIndicatorEngine.profiling_snapshot() == {}
+
+
+class TestColumnInputs:
+    """Test suite for column (array) inputs."""
+    
+    def test_arrays_match_price_data(self, engine, sample_price_data):
+        """Test that column inputs give the same results as PriceData."""
+        bars = sample_price_data.bars
+        from_arrays = engine.compute_indicators_from_arrays(
+            open=[bar.open for bar in bars],
+            high=[bar.high for bar in bars],
+            low=[bar.low for bar in bars],
+            close=[bar.close for bar in bars],
+            volume=[bar.volume for bar in bars],
+            timestamp=[int(bar.timestamp.timestamp()) for bar in bars],
+        )
+        expected = engine.compute_indicators(sample_price_data)
+        
+        assert from_arrays.rsi == pytest.approx(expected.rsi)
+        assert from_arrays.macd.histogram == pytest.approx(expected.macd.histogram)
+        assert from_arrays.bollinger.upper == pytest.approx(expected.bollinger.upper)
+        assert from_arrays.atr == pytest.approx(expected.atr)
+    
+    def test_numpy_columns(self, cpp_engine, sample_price_data, sample_closes):
+        """Test that the native engine accepts NumPy arrays."""
+        np = pytest.importorskip("numpy")
+        bars = sample_price_data.bars
+        closes = np.array(sample_closes, dtype=np.float64)
+        
+        assert cpp_engine.compute_rsi(closes) == pytest.approx(cpp_engine.compute_rsi(sample_closes))
+        assert cpp_engine.compute_ema(closes, 12) == pytest.approx(cpp_engine.compute_ema(sample_closes, 12))
+        
+        results = cpp_engine.compute_indicators(
+            open=np.array([bar.open for bar in bars]),
+            high=np.array([bar.high for bar in bars]),
+            low=np.array([bar.low for bar in bars]),
+            close=closes,
+            volume=np.array([bar.volume for bar in bars], dtype=np.int64),
+            timestamp=np.array([int(bar.timestamp.timestamp()) for bar in bars], dtype=np.int64),
+        )
+        assert 0 <= results.rsi <= 100
+        assert results.atr > 0
+    
+    def test_mismatched_columns_error(self, cpp_engine, sample_closes):
+        """Test that columns of different lengths are rejected."""
+        with pytest.raises(ValueError, match="lengths do not match"):
+            cpp_engine.compute_atr(sample_closes, sample_closes[:-1], sample_closes)
+
+
+class TestTryComputeIndicators:
+    """Test suite for the non-raising computation path."""
+    
+    def test_full_history_is_ok(self, engine, sample_price_data):
+        """Test that enough bars give status ok and the usual results."""
+        computed = engine.try_compute_indicators(sample_price_data)
+        expected = engine.compute_indicators(sample_price_data)
+        
+        assert computed.ok
+        assert all(computed.valid.values())
+        assert computed.results.rsi == pytest.approx(expected.rsi)
+        assert computed.results.macd.signal_line == pytest.approx(expected.macd.signal_line)
+        assert computed.results.atr == pytest.approx(expected.atr)
+    
+    def test_short_history_is_partial(self, sample_price_data, sample_closes):
+        """Test that indicators with enough bars survive a short history."""
+        from src.indicators.python_indicators import compute_rsi, compute_sma
+        short = PriceData(symbol="NEW", bars=sample_price_data.bars[:30], timestamp=datetime.now())
+        computed = TechnicalIndicatorEngine().try_compute_indicators(short)
+        
+        assert computed.status == 'partial'
+        assert computed.valid == {
+            'rsi': True, 'macd': False, 'bollinger': True, 'sma_20': True,
+            'sma_50': False, 'ema_12': True, 'ema_26': True, 'atr': True,
+        }
+        assert computed.results.rsi == pytest.approx(compute_rsi(sample_closes[:30]))
+        assert computed.results.sma_20 == pytest.approx(compute_sma(sample_closes[:30], 20))
+        assert math.isnan(computed.results.macd.macd_line)
+        assert math.isnan(computed.results.sma_50)
+    
+    def test_tiny_history_is_insufficient(self, engine, sample_price_data):
+        """Test that too few bars for any indicator report insufficient data."""
+        for count in (0, 5):
+            tiny = PriceData(symbol="NEW", bars=sample_price_data.bars[:count], timestamp=datetime.now())
+            computed = engine.try_compute_indicators(tiny)
+            
+            assert computed.status == 'insufficient_data'
+            assert not any(computed.valid.values())
+            assert math.isnan(computed.results.rsi)
+    
+    def test_batch_mixes_outcomes(self, engine, sample_price_data):
+        """Test that one short symbol does not fail the batch."""
+        bars = sample_price_data.bars
+        batch = [
+            sample_price_data,
+            PriceData(symbol="NEW", bars=bars[:20], timestamp=datetime.now()),
+        ]
+        statuses = [computed.status for computed in engine.try_compute_indicators_batch(batch)]
+        assert statuses == ['ok', 'partial']
+    
+    def test_native_invalid_input(self, cpp_engine, cpp_module, sample_closes):
+        """Test that mismatched columns report invalid input instead of raising."""
+        computed = cpp_engine.try_compute_indicators(
+            open=[], high=sample_closes, low=sample_closes[:-1], close=sample_closes,
+            volume=[], timestamp=[],
+        )
+        assert computed.status == cpp_module.ComputeStatus.INVALID_INPUT
+        assert not computed.valid.rsi
+
+
+class TestIndicatorSeries:
+    """Test suite for full-series indicator computation."""
+    
+    def test_series_last_values_match(self, engine, sample_price_data):
+        """Test that the last entry of each series equals compute_indicators."""
+        try:
+            series = engine.compute_indicator_series(sample_price_data)
+            indicators = engine.compute_indicators(sample_price_data)
+            
+            assert len(series['rsi']) == len(sample_price_data.bars)
+            assert series['rsi'][-1] == pytest.approx(indicators.rsi)
+            assert series['signal_line'][-1] == pytest.approx(indicators.macd.signal_line)
+            assert series['bb_upper'][-1] == pytest.approx(indicators.bollinger.upper)
+            assert series['sma_50'][-1] == pytest.approx(indicators.sma_50)
+            assert series['ema_26'][-1] == pytest.approx(indicators.ema_26)
+            assert series['atr'][-1] == pytest.approx(indicators.atr)
+        except NotImplementedError:
+            pytest.skip("C++ module not built, skipping test")
+    
+    def test_series_prefix_matches(self, engine, sample_price_data):
+        """Test that series entries equal the value for the bar prefix."""
+        try:
+            series = engine.compute_indicator_series(sample_price_data)
+            prefix = PriceData(
+                symbol="TEST",
+                bars=sample_price_data.bars[:60],
+                timestamp=datetime.now()
+            )
+            indicators = engine.compute_indicators(prefix)
+            
+            assert series['rsi'][59] == pytest.approx(indicators.rsi)
+            assert series['histogram'][59] == pytest.approx(indicators.macd.histogram)
+            assert series['atr'][59] == pytest.approx(indicators.atr)
+        except NotImplementedError:
+            pytest.skip("C++ module not built, skipping test")
+    
+    def test_series_warmup_is_nan(self, engine, sample_price_data):
+        """Test that entries before the warm-up period are NaN."""
+        try:
+            series = engine.compute_indicator_series(sample_price_data)
+            
+            assert all(math.isnan(v) for v in series['rsi'][:14])
+            assert not math.isnan(series['rsi'][14])
+            assert all(math.isnan(v) for v in series['sma_50'][:49])
+            assert not math.isnan(series['sma_50'][49])
+        except NotImplementedError:
+            pytest.skip("C++ module not built, skipping test")
+
+
+class TestAsyncComputation:
+    """Test suite for awaitable computation off the event loop."""
+    
+    @pytest.mark.asyncio
+    async def test_matches_sync(self, engine, sample_price_data):
+        """Test that awaited results equal the blocking call."""
+        expected = engine.compute_indicators(sample_price_data)
+        results = await engine.compute_indicators_async(sample_price_data)
+        
+        assert results.rsi == pytest.approx(expected.rsi)
+        assert results.macd.histogram == pytest.approx(expected.macd.histogram)
+        assert results.atr == pytest.approx(expected.atr)
+    
+    @pytest.mark.asyncio
+    async def test_concurrent_submissions(self, engine, sample_price_data):
+        """Test that several awaits in flight resolve to their own inputs."""
+        import asyncio
+        prefixes = [
+            PriceData(symbol=f"S{n}", bars=sample_price_data.bars[:n], timestamp=datetime.now())
+            for n in (50, 60, 70, 80, 90, 100)
+        ]
+        results = await asyncio.gather(*(engine.compute_indicators_async(p) for p in prefixes))
+        batch = await engine.compute_indicators_batch_async(prefixes)
+        
+        for price_data, single, batched in zip(prefixes, results, batch):
+            expected = engine.compute_indicators(price_data)
+            assert single.sma_50 == pytest.approx(expected.sma_50)
+            assert batched.sma_50 == pytest.approx(expected.sma_50)
+    
+    @pytest.mark.asyncio
+    async def test_errors_raise_value_error(self, engine, sample_price_data):
+        """Test that a failed computation raises from the await."""
+        short = PriceData(symbol="TEST", bars=sample_price_data.bars[:10], timestamp=datetime.now())
+        with pytest.raises(ValueError):
+            await engine.compute_indicators_async(short)
+        with pytest.raises(ValueError):
+            await engine.compute_indicators_batch_async([sample_price_data, short])
+    
+    @pytest.mark.asyncio
+    async def test_analyze_uses_cache(self, engine, sample_price_data):
+        """Test that analyze_async shares the analyze() result cache."""
+        indicators, signals = await engine.analyze_async(sample_price_data)
+        cached, cached_signals = engine.analyze(sample_price_data)
+        
+        assert cached.rsi == pytest.approx(indicators.rsi)
+        assert cached_signals.bb_signal == signals.bb_signal
+        assert engine.result_cache_stats()['hits'] == 1
+    
+    def test_native_callback(self, cpp_engine, sample_price_data):
+        """Test that the native completion callback gets the result or the error."""
+        import threading
+        prices = TechnicalIndicatorEngine()._convert_price_data_to_cpp(sample_price_data)
+        finished = threading.Event()
+        outcome = {}
+        
+        def done(results, error):
+            outcome['results'], outcome['error'] = results, error
+            finished.set()
+        
+        cpp_engine.submit_indicators(prices, done)
+        assert finished.wait(10)
+        assert outcome['error'] is None
+        assert outcome['results'].rsi == cpp_engine.compute_indicators(prices).rsi
+        
+        finished.clear()
+        prices.bars = prices.bars[:10]
+        cpp_engine.submit_indicators(prices, done)
+        assert finished.wait(10)
+        assert outcome['results'] is None and "Insufficient data" in outcome['error']
+    
+    def test_dropped_engine_with_pending_submit(self, cpp_module, sample_price_data):
+        """Test dropping a dedicated-pool engine while its submit is still running."""
+        import gc
+        import threading
+        import time
+        prices = TechnicalIndicatorEngine()._convert_price_data_to_cpp(sample_price_data)
+        finished = threading.Event()
+        outcome = {}
+        
+        def done(results, error):
+            outcome['results'], outcome['error'] = results, error
+            finished.set()
+        
+        native = cpp_module.TechnicalIndicatorEngine(2)
+        native.submit_indicators_batch([prices] * 2000, done)
+        del native
+        gc.collect()
+        assert finished.wait(30)
+        
+        # The last reference is released on this thread, which joins the pool
+        time.sleep(0.2)
+        gc.collect()
+        assert outcome['error'] is None and len(outcome['results']) == 2000
+        assert cpp_module.TechnicalIndicatorEngine(2).compute_indicators(prices).rsi == outcome['results'][0].rsi
+
+
+class TestCrossSection:
+    """Test suite for indicators over a symbols x bars matrix of closes."""
+    
+    def test_rows_match_per_symbol(self, cpp_engine, symbol_closes):
+        """Test that each symbol's value equals the single-series kernel exactly."""
+        ema = cpp_engine.compute_ema_cross_section(symbol_closes, 12)
+        rsi = cpp_engine.compute_rsi_cross_section(symbol_closes, 14)
+        
+        assert ema.shape == (symbol_closes.shape[0],)
+        for s, row in enumerate(symbol_closes.tolist()):
+            assert ema[s] == cpp_engine.compute_ema(row, 12)
+            assert rsi[s] == cpp_engine.compute_rsi(row, 14)
+        assert rsi[0] == 100.0
+    
+    def test_full_series_matches(self, cpp_engine, symbol_closes):
+        """Test that full_series rows equal the per-symbol series kernels."""
+        import numpy as np
+        ema = cpp_engine.compute_ema_cross_section(symbol_closes, 26, full_series=True)
+        rsi = cpp_engine.compute_rsi_cross_section(symbol_closes, 14, full_series=True)
+        
+        assert ema.shape == symbol_closes.shape
+        for s, row in enumerate(symbol_closes.tolist()):
+            np.testing.assert_array_equal(ema[s], cpp_engine.compute_ema_series(row, 26))
+            np.testing.assert_array_equal(rsi[s], cpp_engine.compute_rsi_series(row, 14))
+        assert np.isnan(ema[:, :25]).all() and not np.isnan(ema[:, 25]).any()
+    
+    def test_layouts_and_instruction_sets_agree(self, cpp_module, cpp_engine, symbol_closes):
+        """Test that C-order input and every instruction set give identical results."""
+        import numpy as np
+        default = cpp_module.active_instruction_set()
+        expected = cpp_engine.compute_rsi_cross_section(symbol_closes)
+        
+        np.testing.assert_array_equal(
+            cpp_engine.compute_rsi_cross_section(np.ascontiguousarray(symbol_closes)), expected)
+        try:
+            for isa in cpp_module.InstructionSet.__members__.values():
+                if cpp_module.is_instruction_set_supported(isa):
+                    cpp_module.set_instruction_set(isa)
+                    np.testing.assert_array_equal(cpp_engine.compute_rsi_cross_section(symbol_closes), expected)
+        finally:
+            cpp_module.set_instruction_set(default)
+    
+    def test_float32_within_bound(self, cpp_engine, symbol_closes):
+        """Test that float32 closes stay in float32 and near the float64 result."""
+        import numpy as np
+        closes = np.asfortranarray(symbol_closes, dtype=np.float32)
+        ema = cpp_engine.compute_ema_cross_section(closes, 12, full_series=True)
+        rsi = cpp_engine.compute_rsi_cross_section(closes, 14)
+        
+        assert ema.dtype == np.float32 and rsi.dtype == np.float32
+        reference = cpp_engine.compute_ema_cross_section(closes.astype(np.float64), 12, full_series=True)
+        bound = 1.5 * 13 * 2.0 ** -24 * np.abs(closes).max()
+        np.testing.assert_allclose(ema[:, 11:], reference[:, 11:], rtol=0, atol=bound)
+        np.testing.assert_allclose(rsi, cpp_engine.compute_rsi_cross_section(closes.astype(np.float64)),
+                                   rtol=0, atol=1e-2)
+        np.testing.assert_array_equal(cpp_engine.compute_ema_cross_section(closes, 12), ema[:, -1])
+    
+    def test_invalid_input_raises(self, cpp_engine, symbol_closes):
+        """Test that short or non-matrix input is rejected."""
+        with pytest.raises(ValueError):
+            cpp_engine.compute_rsi_cross_section(symbol_closes[:, :14], 14)
+        with pytest.raises(ValueError):
+            cpp_engine.compute_ema_cross_section(symbol_closes[0], 12)
+    
+    def test_wrapper(self, engine, symbol_closes):
+        """Test the Python wrapper over the native kernels."""
+        try:
+            values = engine.compute_ema_cross_section(symbol_closes, 12)
+            assert len(values) == symbol_closes.shape[0]
+            with pytest.raises(ValueError):
+                engine.compute_rsi_cross_section(symbol_closes[:, :5])
+        except NotImplementedError:
+            pytest.skip("C++ module not built, skipping test")
+
+
+class TestBarSeries:
+    """Test suite for native columnar bar storage."""
+    
+    def _to_cpp_bars(self, cpp_module, bars):
+        cpp_bars = []
+        for bar in bars:
+            cpp_bar = cpp_module.OHLC()
+            cpp_bar.open = bar.open
+            cpp_bar.high = bar.high
+            cpp_bar.low = bar.low
+            cpp_bar.close = bar.close
+            cpp_bar.volume = bar.volume
+            cpp_bar.timestamp = int(bar.timestamp.timestamp())
+            cpp_bars.append(cpp_bar)
+        return cpp_bars
+    
+    def test_series_matches_price_data(self, cpp_module, cpp_engine, engine, sample_price_data):
+        """Test that BarSeries input gives the same results as PriceData."""
+        series = cpp_module.BarSeries.from_bars(self._to_cpp_bars(cpp_module, sample_price_data.bars))
+        results = cpp_engine.compute_indicators(series)
+        expected = engine.compute_indicators(sample_price_data)
+        
+        assert len(series) == len(sample_price_data.bars)
+        assert results.rsi == pytest.approx(expected.rsi)
+        assert results.macd.signal_line == pytest.approx(expected.macd.signal_line)
+        assert results.atr == pytest.approx(expected.atr)
+    
+    def test_ring_capacity_keeps_recent_bars(self, cpp_module, sample_price_data):
+        """Test that a bounded series keeps only the most recent bars."""
+        cpp_bars = self._to_cpp_bars(cpp_module, sample_price_data.bars)
+        series = cpp_module.BarSeries(60)
+        for bar in cpp_bars:
+            series.append(bar)
+        
+        assert len(series) == 60
+        assert series.capacity == 60
+        assert series.bar(0).timestamp == cpp_bars[-60].timestamp
+        assert list(series.close) == [bar.close for bar in cpp_bars[-60:]]
+    
+    def test_update_last(self, cpp_module, sample_price_data):
+        """Test that update_last replaces the most recent bar."""
+        cpp_bars = self._to_cpp_bars(cpp_module, sample_price_data.bars[:2])
+        series = cpp_module.BarSeries()
+        series.append(cpp_bars[0])
+        series.update_last(cpp_bars[1])
+        
+        assert len(series) == 1
+        assert series.bar(0).close == cpp_bars[1].close
+    
+    def test_compact_series_within_bound(self, cpp_module, cpp_engine, sample_price_data):
+        """Test that float32 storage halves memory and keeps results near double."""
+        cpp_bars = self._to_cpp_bars(cpp_module, sample_price_data.bars)
+        compact = cpp_module.CompactBarSeries.from_bars(cpp_bars)
+        series = cpp_module.BarSeries.from_bars(cpp_bars)
+        results = cpp_engine.compute_indicators(compact)
+        expected = cpp_engine.compute_indicators(series)
+        
+        assert len(compact) == len(cpp_bars)
+        assert compact.memory_bytes == 24 * len(cpp_bars)
+        assert list(compact.timestamp) == [bar.timestamp for bar in cpp_bars]
+        assert compact.bar(5).volume == cpp_bars[5].volume
+        scale = 2.0 ** -24 * max(bar.high for bar in cpp_bars)
+        assert abs(results.sma_20 - expected.sma_20) <= scale
+        assert abs(results.ema_26 - expected.ema_26) <= scale
+        assert abs(results.bollinger.upper - expected.bollinger.upper) <= 3 * scale
+        assert abs(results.atr - expected.atr) <= 2 * scale
+        assert abs(results.macd.macd_line - expected.macd.macd_line) <= 2 * scale
+        assert abs(results.macd.signal_line - expected.macd.signal_line) <= 2 * scale
+        assert abs(results.macd.histogram - expected.macd.histogram) <= 4 * scale
+        assert results.rsi == pytest.approx(expected.rsi, abs=1e-3)
+    
+    def test_compact_series_rejects_unencodable_bars(self, cpp_module, sample_price_data):
+        """Test that volumes and timestamps outside the compact ranges are refused."""
+        cpp_bars = self._to_cpp_bars(cpp_module, sample_price_data.bars[:2])
+        compact = cpp_module.CompactBarSeries()
+        compact.append(cpp_bars[0])
+        
+        with pytest.raises(IndexError):
+            compact.append(1.0, 1.0, 1.0, 1.0, 2 ** 32, cpp_bars[1].timestamp)
+        with pytest.raises(IndexError):
+            compact.append(1.0, 1.0, 1.0, 1.0, 0, cpp_bars[0].timestamp + 2 ** 31)
+        assert len(compact) == 1
+    
+    def test_shared_ring_round_trip(self, cpp_module, cpp_engine, sample_price_data):
+        """Test that a consumer mapping of a SharedBarRing sees the producer's bars."""
+        import os
+        import tempfile
+        
+        cpp_bars = self._to_cpp_bars(cpp_module, sample_price_data.bars)
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "TEST.ring")
+            producer = cpp_module.SharedBarRing.create(path, "TEST", 64)
+            consumer = cpp_module.SharedBarRing.open(path)
+            for bar in cpp_bars:
+                producer.push(bar)
+            producer.update_last(cpp_bars[0])
+            
+            assert consumer.symbol == "TEST" and not consumer.writable
+            assert consumer.write_count == len(cpp_bars)
+            assert consumer.read(len(cpp_bars) - 1).close == cpp_bars[0].close
+            with pytest.raises(IndexError):
+                consumer.read(0)
+            with pytest.raises(IndexError):
+                consumer.read(len(cpp_bars))
+            
+            recent = consumer.read_recent(60)
+            expected = cpp_module.BarSeries.from_bars(cpp_bars[-60:-1] + [cpp_bars[0]])
+            assert len(recent) == 60
+            assert cpp_engine.compute_indicators(recent).rsi == cpp_engine.compute_indicators(expected).rsi
+            del producer, consumer
+
+    def test_shared_ring_stalled_producer(self, cpp_module, sample_price_data):
+        """Test that a slot left mid-write by a dead producer fails the read instead of hanging."""
+        import os
+        import struct
+        import tempfile
+        
+        cpp_bars = self._to_cpp_bars(cpp_module, sample_price_data.bars[:3])
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "TEST.ring")
+            producer = cpp_module.SharedBarRing.create(path, "TEST", 8)
+            for bar in cpp_bars:
+                producer.push(bar)
+            consumer = cpp_module.SharedBarRing.open(path)
+            
+            # Slot sequences follow the 128-byte header, one 64-byte slot per bar;
+            # an odd sequence is what a producer killed inside push() leaves behind
+            with open(path, "r+b") as ring_file:
+                ring_file.seek(128 + 64)
+                sequence, = struct.unpack("<Q", ring_file.read(8))
+                ring_file.seek(128 + 64)
+                ring_file.write(struct.pack("<Q", sequence + 1))
+            
+            assert consumer.read(0).close == cpp_bars[0].close
+            with pytest.raises(RuntimeError, match="still being written"):
+                consumer.read(1)
+            with pytest.raises(RuntimeError, match="blocked by the producer"):
+                consumer.read_recent(3)
+            assert len(consumer.read_recent(1)) == 1
+            del producer, consumer
+
+
+class TestSimdKernels:
+    """Test suite for runtime-dispatched SIMD kernels."""
+    
+    def test_instruction_sets_match_scalar(self, cpp_module, cpp_engine, sample_price_data, sample_closes):
+        """Test that every supported instruction set matches the scalar kernels."""
+        highs = [bar.high for bar in sample_price_data.bars]
+        lows = [bar.low for bar in sample_price_data.bars]
+        default = cpp_module.active_instruction_set()
+        
+        def compute():
+            bands = cpp_engine.compute_bollinger_bands(sample_closes)
+            return (cpp_engine.compute_sma(sample_closes, 50), bands.upper,
+                    cpp_engine.compute_atr(highs, lows, sample_closes))
+        
+        try:
+            cpp_module.set_instruction_set(cpp_module.InstructionSet.SCALAR)
+            expected = compute()
+            for isa in cpp_module.InstructionSet.__members__.values():
+                if not cpp_module.is_instruction_set_supported(isa):
+                    with pytest.raises(ValueError):
+                        cpp_module.set_instruction_set(isa)
+                    continue
+                cpp_module.set_instruction_set(isa)
+                assert compute() == pytest.approx(expected, rel=1e-12)
+        finally:
+            cpp_module.set_instruction_set(default)
+
+
+class TestSelectedIndicators:
+    """Test suite for computing a configurable indicator set."""
+    
+    def test_default_spec_matches_compute_indicators(self, engine, sample_price_data):
+        """Test that the default spec reproduces compute_indicators."""
+        selected = engine.compute_selected_indicators(sample_price_data, IndicatorSpec())
+        expected = engine.compute_indicators(sample_price_data)
+        
+        assert selected['rsi'] == pytest.approx(expected.rsi)
+        assert selected['histogram'] == pytest.approx(expected.macd.histogram)
+        assert selected['bb_upper'] == pytest.approx(expected.bollinger.upper)
+        assert selected['sma_50'] == pytest.approx(expected.sma_50)
+        assert selected['ema_26'] == pytest.approx(expected.ema_26)
+        assert selected['atr'] == pytest.approx(expected.atr)
+    
+    def test_only_enabled_indicators_are_returned(self, engine, sample_price_data):
+        """Test that a spec computes exactly the requested indicators and periods."""
+        from src.indicators.python_indicators import compute_ema
+        
+        spec = IndicatorSpec(macd=False, bollinger=False, sma_periods=(), ema_periods=(20, 50))
+        selected = engine.compute_selected_indicators(sample_price_data, spec)
+        closes = [bar.close for bar in sample_price_data.bars]
+        
+        assert set(selected) == {'rsi', 'atr', 'ema_20', 'ema_50'}
+        assert selected['ema_20'] == pytest.approx(compute_ema(closes, 20))
+        assert selected['ema_50'] == pytest.approx(compute_ema(closes, 50))
+    
+    def test_spec_lowers_minimum_bars(self, engine, sample_price_data):
+        """Test that a spec needing fewer bars accepts shorter input."""
+        sample_price_data.bars = sample_price_data.bars[:20]
+        spec = IndicatorSpec(macd=False, bollinger=False, sma_periods=(), ema_periods=())
+        selected = engine.compute_selected_indicators(sample_price_data, spec)
+        
+        assert set(selected) == {'rsi', 'atr'}
+        with pytest.raises(ValueError):
+            engine.compute_indicators(sample_price_data)
+
+
+VOLUME_SPEC = IndicatorSpec(
+    rsi=False, macd=False, bollinger=False, atr=False, sma_periods=(), ema_periods=(),
+    obv=True, vwap=True, mfi=True, volume_sma=True
+)
+
+
+class TestVolumeIndicators:
+    """Test suite for OBV, VWAP, MFI and volume SMA."""
+    
+    def test_selected_match_python_reference(self, engine, sample_price_data):
+        """Test that the volume indicators equal the pure Python implementations."""
+        from src.indicators.python_indicators import (
+            compute_obv, compute_vwap, compute_mfi, compute_volume_sma
+        )
+        
+        bars = sample_price_data.bars
+        selected = engine.compute_selected_indicators(sample_price_data, VOLUME_SPEC)
+        
+        assert set(selected) == {'obv', 'vwap', 'mfi', 'volume_sma'}
+        assert selected['obv'] == compute_obv(bars)
+        assert selected['vwap'] == pytest.approx(compute_vwap(bars))
+        assert selected['mfi'] == pytest.approx(compute_mfi(bars, 14))
+        assert selected['volume_sma'] == compute_volume_sma(bars, 20)
+    
+    def test_vwap_restarts_each_session(self, engine):
+        """Test that VWAP only weights the bars of the last bar's session."""
+        start = datetime(2024, 1, 2, 9, 0, tzinfo=timezone.utc)
+        bars = [
+            OHLC(open=p, high=p + 1.0, low=p - 1.0, close=p, volume=100 * (i + 1),
+                 timestamp=start + timedelta(minutes=20 * i))
+            for i, p in enumerate([100.0, 102.0, 101.0, 105.0, 107.0])
+        ]
+        price_data = PriceData(symbol="TEST", bars=bars, timestamp=start)
+        spec = replace(VOLUME_SPEC, obv=False, mfi=False, volume_sma=False,
+                       vwap_session_seconds=3600)
+        
+        # Bars 3 and 4 open the second hour
+        session = bars[3:]
+        expected = sum(b.close * b.volume for b in session) / sum(b.volume for b in session)
+        assert engine.compute_selected_indicators(price_data, spec)['vwap'] == pytest.approx(expected)
+    
+    def test_series_last_values_match(self, engine, sample_price_data):
+        """Test that the last entry of each volume series equals the selected value."""
+        try:
+            series = engine.compute_indicator_series(sample_price_data)
+        except NotImplementedError:
+            pytest.skip("C++ module not built, skipping test")
+        selected = engine.compute_selected_indicators(sample_price_data, VOLUME_SPEC)
+        
+        for name in ('obv', 'vwap', 'mfi', 'volume_sma'):
+            assert series[name][-1] == pytest.approx(selected[name])
+        assert all(math.isnan(v) for v in series['mfi'][:14])
+        assert all(math.isnan(v) for v in series['volume_sma'][:19])
+    
+    def test_streaming_matches_batch(self, engine, sample_price_data):
+        """Test that streamed volume indicators equal a full recomputation."""
+        bars = sample_price_data.bars
+        state = IncrementalIndicatorState("TEST")
+        for bar in bars:
+            state.push_bar(bar)
+        state.apply_tick(bars[-1].close + 0.5, 250)
+        
+        revised = replace(sample_price_data, bars=bars[:-1] + [state.last_bar])
+        expected = engine.compute_selected_indicators(revised, VOLUME_SPEC)
+        streamed = state.volume_indicators()
+        for name in ('obv', 'vwap', 'mfi', 'volume_sma'):
+            assert streamed[name] == pytest.approx(expected[name])
+    
+    def test_native_requires_volume_column(self, cpp_engine, cpp_module, sample_closes):
+        """Test that a volume indicator without a volume column raises ValueError."""
+        spec = cpp_module.IndicatorSpec()
+        spec.obv = True
+        with pytest.raises(ValueError):
+            cpp_engine.compute_indicators(
+                open=[], high=sample_closes, low=sample_closes, close=sample_closes,
+                volume=[], timestamp=[], spec=spec
+            )
+
+
+def make_regime(regime_type, confidence):
+    """Market regime with only the fields used by CMS scoring set meaningfully."""
+    return MarketRegime(
+        regime_type=regime_type,
+        confidence=confidence,
+        volatility=0.1,
+        trend_strength=0.5,
+        timestamp=datetime.now()
+    )
+
+
+class TestCompositeScorer:
+    """Test suite for composite market scoring from price data."""
+    
+    def test_score_matches_signal_aggregator(self, engine, sample_price_data):
+        """Test that scores equal SignalAggregator.compute_cms on the same signals."""
+        pytest.importorskip("src.signal.aggregator")
+        from src.shared.models import AggregatedData
+        from src.signal.aggregator import SignalAggregator
+        
+        aggregator = SignalAggregator(None, weight_sentiment=0.3, weight_technical=0.5, weight_regime=0.2)
+        scorer = CompositeScorer(0.3, 0.5, 0.2)
+        for sentiment, regime in [(0.4, make_regime(RegimeType.TRENDING_UP, 0.8)),
+                                  (-0.7, make_regime(RegimeType.VOLATILE, 0.6))]:
+            signals, cms = scorer.score(sample_price_data, sentiment, regime)
+            expected = aggregator.compute_cms(AggregatedData(
+                sentiment_score=sentiment,
+                technical_signals=signals,
+                regime=regime,
+                events=[],
+                timestamp=datetime.now()
+            ))
+            
+            assert cms.score == pytest.approx(expected.score)
+            assert cms.technical_component == pytest.approx(expected.technical_component)
+            assert cms.regime_component == pytest.approx(expected.regime_component)
+            assert cms.weights == pytest.approx(expected.weights)
+    
+    def test_batch_matches_single(self, engine, sample_price_data):
+        """Test that batch scoring equals scoring each symbol and uses engine signals."""
+        scorer = CompositeScorer(1.0, 1.0, 2.0)
+        prefix = PriceData(symbol="PREFIX", bars=sample_price_data.bars[:60], timestamp=datetime.now())
+        regimes = [make_regime(RegimeType.CALM, 0.9), make_regime(RegimeType.TRENDING_DOWN, 0.5)]
+        
+        batch = scorer.score_batch([sample_price_data, prefix], [0.1, -0.2], regimes)
+        single = scorer.score(prefix, -0.2, regimes[1])
+        indicators = engine.compute_indicators(prefix)
+        
+        assert scorer.weights['regime'] == pytest.approx(0.5)
+        assert batch[1][0] == single[0] == engine.generate_signals(indicators, prefix.bars[-1].close)
+        assert batch[1][1].score == pytest.approx(single[1].score)
+        assert -100.0 <= batch[0][1].score <= 100.0
+    
+    def test_mismatched_batch_error(self, sample_price_data):
+        """Test that batch inputs of different lengths are rejected."""
+        scorer = CompositeScorer(0.3, 0.5, 0.2)
+        with pytest.raises(ValueError):
+            scorer.score_batch([sample_price_data], [0.1, 0.2], [make_regime(RegimeType.RANGING, 1.0)])
+
+
+class TestBatchComputation:
+    """Test suite for multi-symbol batch computation."""
+    
+    def test_batch_matches_single(self, engine, sample_price_data):
+        """Test that batch results match per-symbol computation."""
+        batch = [sample_price_data, sample_price_data]
+        results = engine.compute_indicators_batch(batch)
+        single = engine.compute_indicators(sample_price_data)
+        
+        assert len(results) == 2
+        for result in results:
+            assert result.rsi == pytest.approx(single.rsi)
+            assert result.macd.signal_line == pytest.approx(single.macd.signal_line)
+            assert result.atr == pytest.approx(single.atr)
+    
+    def test_batch_empty(self, engine):
+        """Test that an empty batch returns no results."""
+        assert engine.compute_indicators_batch([]) == []
+    
+    def test_batch_insufficient_data_error(self, engine, sample_price_data):
+        """Test that a short symbol in the batch raises an error."""
+        short = PriceData(
+            symbol="SHORT",
+            bars=sample_price_data.bars[:10],
+            timestamp=datetime.now()
+        )
+        
+        with pytest.raises(ValueError, match="Insufficient data"):
+            engine.compute_indicators_batch([sample_price_data, short])
+
+
+class TestIncrementalIndicatorState:
+    """Test suite for streaming indicator state."""
+    
+    def test_not_ready_before_min_bars(self, sample_price_data):
+        """Test that results are unavailable during warm-up."""
+        state = IncrementalIndicatorState("TEST")
+        for bar in sample_price_data.bars[:49]:
+            state.push_bar(bar)
+        
+        assert not state.ready
+        with pytest.raises(ValueError, match="Insufficient data"):
+            state.results()
+    
+    def test_matches_batch_computation(self, engine, sample_price_data):
+        """Test that streaming results match compute_indicators."""
+        state = IncrementalIndicatorState("TEST")
+        for bar in sample_price_data.bars:
+            state.push_bar(bar)
+        
+        streamed = state.results()
+        batch = engine.compute_indicators(sample_price_data)
+        
+        assert streamed.rsi == pytest.approx(batch.rsi)
+        assert streamed.macd.macd_line == pytest.approx(batch.macd.macd_line)
+        assert streamed.macd.signal_line == pytest.approx(batch.macd.signal_line)
+        assert streamed.bollinger.upper == pytest.approx(batch.bollinger.upper)
+        assert streamed.bollinger.lower == pytest.approx(batch.bollinger.lower)
+        assert streamed.sma_20 == pytest.approx(batch.sma_20)
+        assert streamed.sma_50 == pytest.approx(batch.sma_50)
+        assert streamed.ema_12 == pytest.approx(batch.ema_12)
+        assert streamed.ema_26 == pytest.approx(batch.ema_26)
+        assert streamed.atr == pytest.approx(batch.atr)
+    
+    def test_update_last_bar(self, engine, sample_price_data):
+        """Test that revising the last bar equals pushing the final bar."""
+        bars = sample_price_data.bars
+        state = IncrementalIndicatorState("TEST")
+        for bar in bars[:-1]:
+            state.push_bar(bar)
+        
+        last = bars[-1]
+        state.push_bar(OHLC(
+            open=last.open,
+            high=last.high + 5.0,
+            low=last.low - 5.0,
+            close=last.close + 3.0,
+            volume=last.volume,
+            timestamp=last.timestamp
+        ))
+        state.update_last_bar(last)
+        
+        batch = engine.compute_indicators(sample_price_data)
+        assert state.bar_count == len(bars)
+        assert state.results().rsi == pytest.approx(batch.rsi)
+        assert state.results().atr == pytest.approx(batch.atr)
+    
+    def test_apply_tick_matches_batch(self, engine, sample_price_data):
+        """Test that ticks folded into the forming bar equal a full recomputation."""
+        bars = sample_price_data.bars
+        state = IncrementalIndicatorState("TEST")
+        for bar in bars[:-1]:
+            state.push_bar(bar)
+        
+        last = bars[-1]
+        state.push_bar(OHLC(
+            open=last.open, high=last.open, low=last.open, close=last.open,
+            volume=0, timestamp=last.timestamp
+        ))
+        ticks = [(last.high, 10), (last.low, 20), (last.close, 30), (last.close, 40)]
+        for price, volume in ticks:
+            state.apply_tick(price, volume)
+        
+        expected = OHLC(
+            open=last.open, high=max(last.open, last.high), low=min(last.open, last.low),
+            close=last.close, volume=100, timestamp=last.timestamp
+        )
+        assert state.last_bar == expected
+        batch = engine.compute_indicators(replace(sample_price_data, bars=bars[:-1] + [expected]))
+        streamed = state.results()
+        assert state.bar_count == len(bars)
+        assert streamed.rsi == pytest.approx(batch.rsi)
+        assert streamed.macd.histogram == pytest.approx(batch.macd.histogram)
+        assert streamed.bollinger.upper == pytest.approx(batch.bollinger.upper)
+        assert streamed.atr == pytest.approx(batch.atr)
+    
+    def test_snapshot_restore_continues_exactly(self, cpp_engine, sample_price_data):
+        """Test that a restored snapshot continues exactly like the original state."""
+        bars = sample_price_data.bars
+        state = IncrementalIndicatorState("TEST")
+        for bar in bars[:60]:
+            state.push_bar(bar)
+        state.apply_tick(bars[59].close + 0.25, 10)
+        
+        restored = IncrementalIndicatorState.restore("TEST", state.snapshot())
+        assert restored.bar_count == 60
+        assert restored.last_bar.close == state.last_bar.close
+        for bar in bars[60:]:
+            state.push_bar(bar)
+            restored.push_bar(bar)
+        
+        assert restored.results() == state.results()
+        assert restored.volume_indicators() == state.volume_indicators()
+        assert restored.snapshot() == state.snapshot()
+    
+    def test_restore_rejects_bad_snapshots(self, cpp_engine, sample_price_data):
+        """Test that corrupted, truncated or foreign snapshots raise ValueError."""
+        state = IncrementalIndicatorState("TEST")
+        for bar in sample_price_data.bars[:10]:
+            state.push_bar(bar)
+        data = bytearray(state.snapshot())
+        
+        corrupted = bytearray(data)
+        corrupted[-1] ^= 1
+        newer = bytearray(data)
+        newer[4] += 1
+        for bad in (bytes(corrupted), bytes(newer), bytes(data[:-8]), b"not a snapshot"):
+            with pytest.raises(ValueError):
+                IncrementalIndicatorState.restore("TEST", bad)
+    
+    def test_apply_tick_without_bars_raises(self):
+        """Test that a tick before any bar raises an error."""
+        state = IncrementalIndicatorState("TEST")
+        with pytest.raises(ValueError, match="No bar to update"):
+            state.apply_tick(100.0, 10)
+    
+    def test_update_without_bars_raises(self):
+        """Test that updating an empty state raises an error."""
+        state = IncrementalIndicatorState("TEST")
+        with pytest.raises(ValueError, match="No bar to update"):
+            state.update_last_bar(OHLC(
+                open=100.0, high=101.0, low=99.0, close=100.5,
+                volume=1000, timestamp=datetime.now()
+            ))
+
+
+def minute_bars(count):
+    """One-minute bars starting on an hour boundary."""
+    start = datetime.fromtimestamp(1704103200)
+    bars = []
+    price = 100.0
+    for i in range(count):
+        close = price + math.sin(i / 7.0) + (i % 4) * 0.1 - 0.15
+        bars.append(OHLC(
+            open=price,
+            high=max(price, close) + 0.5 + (i % 3) * 0.1,
+            low=min(price, close) - 0.5,
+            close=close,
+            volume=1000 + (i % 11) * 10,
+            timestamp=start + timedelta(minutes=i)
+        ))
+        price = close
+    return bars
+
+
+def aggregate(bars, seconds):
+    """Reference aggregation of base bars into buckets of the given length."""
+    buckets = []
+    for bar in bars:
+        start = int(bar.timestamp.timestamp()) // seconds * seconds
+        if buckets and buckets[-1][0] == start:
+            merged = buckets[-1][1]
+            merged.high = max(merged.high, bar.high)
+            merged.low = min(merged.low, bar.low)
+            merged.close = bar.close
+            merged.volume += bar.volume
+        else:
+            buckets.append((start, OHLC(
+                open=bar.open, high=bar.high, low=bar.low, close=bar.close,
+                volume=bar.volume, timestamp=datetime.fromtimestamp(start)
+            )))
+    return [bar for _, bar in buckets]
+
+
+class TestMultiTimeframeIndicatorState:
+    """Test suite for multi-timeframe bar aggregation."""
+    
+    def test_matches_pre_aggregated_bars(self, engine):
+        """Test that each timeframe matches compute_indicators on aggregated bars."""
+        bars = minute_bars(300)
+        state = MultiTimeframeIndicatorState("TEST", [60, timedelta(minutes=5)])
+        for bar in bars:
+            state.push_bar(bar)
+        
+        for seconds in (60, 300):
+            expected_bars = aggregate(bars, seconds)
+            expected = engine.compute_indicators(PriceData(
+                symbol="TEST", bars=expected_bars, timestamp=expected_bars[-1].timestamp
+            ))
+            streamed = state.results(seconds)
+            
+            assert state.bar_count(seconds) == len(expected_bars)
+            assert state.current_bar(seconds) == expected_bars[-1]
+            assert streamed.rsi == pytest.approx(expected.rsi)
+            assert streamed.macd.signal_line == pytest.approx(expected.macd.signal_line)
+            assert streamed.bollinger.upper == pytest.approx(expected.bollinger.upper)
+            assert streamed.ema_26 == pytest.approx(expected.ema_26)
+            assert streamed.atr == pytest.approx(expected.atr)
+    
+    def test_reports_closed_timeframes(self):
+        """Test that a push into a new bucket closes the previous bar."""
+        bars = minute_bars(301)
+        state = MultiTimeframeIndicatorState("TEST", [300, 3600])
+        for bar in bars[:-1]:
+            state.push_bar(bar)
+        before_close = state.results(300)
+        
+        assert state.push_bar(bars[-1]) == [300, 3600]
+        assert state.last_closed_bar(300) == aggregate(bars[:-1], 300)[-1]
+        assert state.closed_results(300).rsi == pytest.approx(before_close.rsi)
+        assert state.bar_count(3600) == 6
+        with pytest.raises(ValueError, match="Insufficient data"):
+            state.closed_results(3600)
+    
+    def test_update_last_bar_revises_every_timeframe(self):
+        """Test that revising the base bar revises each forming bar."""
+        bars = minute_bars(3)
+        state = MultiTimeframeIndicatorState("TEST", [60, 300])
+        for bar in bars:
+            state.push_bar(bar)
+        
+        revised = OHLC(
+            open=bars[-1].open, high=bars[-1].high + 10.0, low=bars[-1].low,
+            close=bars[-1].close + 1.0, volume=bars[-1].volume, timestamp=bars[-1].timestamp
+        )
+        state.update_last_bar(revised)
+        
+        assert state.current_bar(60) == revised
+        assert state.current_bar(300) == aggregate(bars[:-1] + [revised], 300)[-1]
+    
+    def test_ticks_and_ordering(self):
+        """Test tick aggregation and the timestamp order check."""
+        start = datetime.fromtimestamp(1704103200)
+        state = MultiTimeframeIndicatorState("TEST", [60])
+        state.push_tick(start, 100.0, 10)
+        state.push_tick(start + timedelta(seconds=20), 101.5, 5)
+        state.push_tick(start + timedelta(seconds=40), 99.0, 7)
+        
+        bar = state.current_bar(60)
+        assert (bar.open, bar.high, bar.low, bar.close, bar.volume) == (100.0, 101.5, 99.0, 99.0, 22)
+        assert state.push_tick(start + timedelta(seconds=60), 99.5, 1) == [60]
+        with pytest.raises(ValueError, match="timestamp order"):
+            state.push_tick(start, 100.0, 1)
+        with pytest.raises(KeyError):
+            state.bar_count(300)
+
+
+class TestResultCache:
+    """Test suite for cached per-symbol analysis."""
+    
+    def test_analyze_matches_uncached(self, engine, sample_price_data):
+        """Test that analyze returns compute_indicators and generate_signals."""
+        indicators, signals = engine.analyze(sample_price_data)
+        expected = engine.compute_indicators(sample_price_data)
+        
+        assert indicators.rsi == pytest.approx(expected.rsi)
+        assert indicators.atr == pytest.approx(expected.atr)
+        assert signals == engine.generate_signals(expected, sample_price_data.bars[-1].close)
+    
+    def test_unchanged_bars_hit(self, engine, sample_price_data):
+        """Test that repeated requests for the same bars are served from the cache."""
+        first, _ = engine.analyze(sample_price_data)
+        second, _ = engine.analyze(sample_price_data)
+        
+        assert second.rsi == first.rsi
+        assert engine.result_cache_stats() == {'entries': 1, 'hits': 1, 'misses': 1}
+    
+    def test_new_or_revised_bar_misses(self, engine, sample_price_data):
+        """Test that a pushed or revised last bar recomputes the analysis."""
+        bars = sample_price_data.bars
+        shorter = PriceData(symbol="TEST", bars=bars[:-1], timestamp=bars[-2].timestamp)
+        engine.analyze(shorter)
+        engine.analyze(sample_price_data)
+        
+        last = bars[-1]
+        revised_bars = bars[:-1] + [OHLC(
+            open=last.open, high=last.high, low=last.low, close=last.close + 4.0,
+            volume=last.volume, timestamp=last.timestamp
+        )]
+        revised = PriceData(symbol="TEST", bars=revised_bars, timestamp=last.timestamp)
+        indicators, _ = engine.analyze(revised)
+        
+        assert indicators.rsi == pytest.approx(engine.compute_indicators(revised).rsi)
+        stats = engine.result_cache_stats()
+        assert stats['misses'] == 3
+        assert stats['hits'] == 0
+        assert stats['entries'] == 1
+    
+    def test_invalidate(self, engine, sample_price_data):
+        """Test that invalidating a symbol drops its entry."""
+        engine.analyze(sample_price_data)
+        engine.invalidate_cached_results("TEST")
+        engine.analyze(sample_price_data)
+        
+        assert engine.result_cache_stats()['misses'] == 2
+        engine.invalidate_cached_results()
+        assert engine.result_cache_stats()['entries'] == 0
+    
+    def test_concurrent_readers(self, engine, sample_price_data):
+        """Test analyze from several threads over several symbols."""
+        from concurrent.futures import ThreadPoolExecutor
+        
+        batch = [
+            PriceData(symbol=f"SYM{i}", bars=sample_price_data.bars, timestamp=sample_price_data.timestamp)
+            for i in range(4)
+        ]
+        expected = engine.compute_indicators(sample_price_data).rsi
+        with ThreadPoolExecutor(max_workers=4) as pool:
+            results = list(pool.map(engine.analyze, batch * 10))
+        
+        assert all(indicators.rsi == pytest.approx(expected) for indicators, _ in results)
+        stats = engine.result_cache_stats()
+        assert stats['entries'] == 4
+        assert stats['hits'] + stats['misses'] == 40
+
+
+class TestStateRegistry:
+    """Test suite for the native concurrent per-symbol state registry."""
+    
+    def _to_cpp_bars(self, cpp_module, bars):
+        return TestBarSeries()._to_cpp_bars(cpp_module, bars)
+    
+    def test_read_matches_private_state(self, cpp_module, sample_price_data):
+        """Test that published values equal a state fed the same bars."""
+        bars = self._to_cpp_bars(cpp_module, sample_price_data.bars)
+        registry = cpp_module.StateRegistry(capacity=8)
+        state = cpp_module.IncrementalIndicatorState()
+        for bar in bars:
+            registry.push_bar("AAPL", bar)
+            state.push_bar(bar)
+        registry.apply_tick("AAPL", bars[-1].close + 0.5, 10)
+        state.apply_tick(bars[-1].close + 0.5, 10)
+        
+        published = registry.read("AAPL")
+        assert published.version == len(bars) + 1
+        assert published.bar_count == state.bar_count()
+        assert published.ready
+        assert published.last_bar.close == state.last_bar().close
+        assert published.results.rsi == state.results().rsi
+        assert published.results.macd.histogram == state.results().macd.histogram
+        assert published.volume.vwap == state.volume_indicators().vwap
+        assert registry.snapshot("AAPL") == state.snapshot()
+    
+    def test_unknown_and_unready_symbols(self, cpp_module, sample_price_data):
+        """Test reads of a missing symbol and of one with too few bars."""
+        bars = self._to_cpp_bars(cpp_module, sample_price_data.bars[:3])
+        registry = cpp_module.StateRegistry()
+        for bar in bars:
+            registry.push_bar("MSFT", bar)
+        
+        assert registry.read("AAPL") is None
+        assert "AAPL" not in registry
+        with pytest.raises(IndexError):
+            registry.snapshot("AAPL")
+        published = registry.read("MSFT")
+        assert "MSFT" in registry and len(registry) == 1
+        assert published.bar_count == 3 and not published.ready
+    
+    def test_restore_from_snapshot(self, cpp_module, sample_price_data):
+        """Test that a restored symbol continues like the original."""
+        bars = self._to_cpp_bars(cpp_module, sample_price_data.bars)
+        source = cpp_module.StateRegistry()
+        for bar in bars[:60]:
+            source.push_bar("AAPL", bar)
+        
+        target = cpp_module.StateRegistry()
+        target.restore("AAPL", source.snapshot("AAPL"))
+        for bar in bars[60:]:
+            source.push_bar("AAPL", bar)
+            target.push_bar("AAPL", bar)
+        
+        restored, original = target.read("AAPL"), source.read("AAPL")
+        assert restored.results.rsi == original.results.rsi
+        assert restored.volume.mfi == original.volume.mfi
+        assert target.snapshot("AAPL") == source.snapshot("AAPL")
+        with pytest.raises(ValueError):
+            target.restore("AAPL", b"not a snapshot")
+    
+    def test_capacity(self, cpp_module, sample_price_data):
+        """Test that registering more symbols than the capacity raises."""
+        bar = self._to_cpp_bars(cpp_module, sample_price_data.bars[:1])[0]
+        registry = cpp_module.StateRegistry(capacity=2)
+        registry.push_bar("A", bar)
+        registry.push_bar("B", bar)
+        registry.push_bar("A", bar)
+        
+        with pytest.raises(RuntimeError, match="full"):
+            registry.push_bar("C", bar)
+        assert sorted(registry.symbols()) == ["A", "B"]
+        assert registry.capacity == 2
+        with pytest.raises(ValueError):
+            cpp_module.StateRegistry(capacity=0)
+    
+    def test_concurrent_writers_and_readers(self, cpp_module, sample_price_data):
+        """Test one writer per symbol against readers of every symbol."""
+        import threading
+        bars = self._to_cpp_bars(cpp_module, sample_price_data.bars)
+        symbols = [f"SYM{i}" for i in range(4)]
+        registry = cpp_module.StateRegistry()
+        done = threading.Event()
+        regressions = []
+        
+        def write(symbol):
+            for bar in bars:
+                registry.push_bar(symbol, bar)
+        
+        def read():
+            seen = {}
+            while not done.is_set():
+                for symbol in symbols:
+                    published = registry.read(symbol)
+                    if published is not None:
+                        if published.version < seen.get(symbol, 0):
+                            regressions.append(symbol)
+                        seen[symbol] = published.version
+        
+        readers = [threading.Thread(target=read) for _ in range(2)]
+        writers = [threading.Thread(target=write, args=(symbol,)) for symbol in symbols]
+        for thread in readers + writers:
+            thread.start()
+        for thread in writers:
+            thread.join()
+        done.set()
+        for thread in readers:
+            thread.join()
+        
+        state = cpp_module.IncrementalIndicatorState()
+        for bar in bars:
+            state.push_bar(bar)
+        assert regressions == []
+        for symbol in symbols:
+            assert registry.read(symbol).version == len(bars)
+            assert registry.snapshot(symbol) == state.snapshot()
+
+
+class TestDifferential:
+    """Test suite for the differential harness against python_indicators.py."""
+    
+    def test_generated_cases_are_valid_and_reproducible(self):
+        """Test that cases are well-formed bars and depend only on the seed."""
+        from src.indicators import differential
+        cases = differential.generate_cases(seed=3, cases=2, bars=80)
+        
+        assert [case.name for case in cases][:2] == ["random_walk_0", "random_walk_1"]
+        assert cases == differential.generate_cases(seed=3, cases=2, bars=80)
+        for case in cases:
+            for bar in case.bars:
+                assert bar.low <= min(bar.open, bar.close) <= max(bar.open, bar.close) <= bar.high
+                assert bar.volume >= 0
+    
+    def test_reference_macd_history_matches_native(self, cpp_engine, sample_closes):
+        """Test that the reference MACD signal equals the native one on a short series."""
+        from src.indicators.python_indicators import PythonIndicatorEngine
+        closes = sample_closes[:40]
+        expected = PythonIndicatorEngine.compute_macd(closes)
+        
+        assert cpp_engine.compute_macd(closes).signal_line == pytest.approx(expected.signal_line, rel=1e-12)
+    
+    def test_native_variants_match_reference(self, cpp_engine):
+        """Test that every native variant agrees with the reference on every case."""
+        from src.indicators import differential
+        report = differential.run(seed=3, cases=4, bars=120)
+        
+        assert report.checks['kernel[scalar]'] > 0 and report.checks['streaming'] > 0
+        assert report.ok, report.mismatches[:5]
+
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v"])